@@ -3,7 +3,16 @@
 //  DavidRichardson02
 
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // Declares 'strptime' on glibc, which otherwise defaults to an 'int' return and truncates its pointer.
+#endif
 #include "AuxiliaryUtilities.h"
+#include <unistd.h>
+#include <errno.h>
+#include <sys/uio.h>
+#ifdef UTILITIES_INSTRUMENTATION
+#include <stdatomic.h>
+#endif
 
 
 
@@ -67,12 +76,452 @@ const char *commonDateTimeFormats[12] =
 
 
 
+/// The allocator all of the library's allocations go through, all NULL for the C library's 'malloc', 'realloc' and 'free'.
+static UtilitiesAllocator activeAllocator = { NULL, NULL, NULL, NULL };
+
+
+/**
+ * utilities_set_allocator
+ *
+ * Routes every allocation made by the library(and through 'utilities_malloc' and its siblings) to another allocator, e.g., the one
+ * returned by 'utilities_pooled_allocator'. The allocator must be selected before the library allocates anything, as memory has
+ * to be released by the allocator that provided it: everything the library returns is then freed with 'utilities_free' or with
+ * the library's own deallocation functions, and buffers handed to the library for growth must come from 'utilities_malloc'.
+ * An allocator must provide all three functions, one missing any of them is rejected and the current allocator kept.
+ *
+ * @param allocator The allocator to use, NULL restores the C library's.
+ */
+void utilities_set_allocator(const UtilitiesAllocator *allocator)
+{
+	if (allocator == NULL)
+	{
+		UtilitiesAllocator standard = { NULL, NULL, NULL, NULL };
+		activeAllocator = standard;
+		return;
+	}
+	
+	// A missing callback would fall back to the C library for blocks the hook owns, so such an allocator is refused.
+	if (allocator->allocate == NULL || allocator->reallocate == NULL || allocator->deallocate == NULL)
+	{
+		perror("\n\nError: allocator is missing its allocate, reallocate or deallocate function in 'utilities_set_allocator', keeping the current allocator.\n");
+		return;
+	}
+	activeAllocator = *allocator;
+}
+
+
+/**
+ * utilities_malloc
+ *
+ * Allocates 'size' bytes through the selected allocator, 'malloc' when none is selected.
+ *
+ * @param size The number of bytes.
+ * @return The block, or NULL on failure.
+ */
+void *utilities_malloc(size_t size)
+{
+	INSTRUMENT_ALLOCATION(size);
+	return (activeAllocator.allocate != NULL) ? activeAllocator.allocate(size, activeAllocator.context) : malloc(size);
+}
+
+
+/**
+ * utilities_calloc
+ *
+ * Allocates 'count' zeroed elements of 'size' bytes through the selected allocator.
+ *
+ * @param count The number of elements.
+ * @param size The size of each element.
+ * @return The block, or NULL on failure or overflow.
+ */
+void *utilities_calloc(size_t count, size_t size)
+{
+	size_t total;
+	if (__builtin_mul_overflow(count, size, &total))
+	{
+		return NULL;
+	}
+	INSTRUMENT_ALLOCATION(total);
+	if (activeAllocator.allocate == NULL)
+	{
+		return calloc(count, size);
+	}
+	
+	void *block = activeAllocator.allocate(total, activeAllocator.context);
+	if (block != NULL)
+	{
+		set_memory_block(block, 0, total);
+	}
+	return block;
+}
+
+
+/**
+ * utilities_realloc
+ *
+ * Resizes a block obtained from the selected allocator, keeping its contents up to the smaller size.
+ *
+ * @param block The block, or NULL to allocate a new one.
+ * @param size The new size in bytes.
+ * @return The resized block, or NULL on failure, leaving 'block' intact.
+ */
+void *utilities_realloc(void *block, size_t size)
+{
+	INSTRUMENT_ALLOCATION(size);
+	return (activeAllocator.reallocate != NULL) ? activeAllocator.reallocate(block, size, activeAllocator.context) : realloc(block, size);
+}
+
+
+/**
+ * utilities_free
+ *
+ * Frees a block obtained from the selected allocator.
+ *
+ * @param block The block, may be NULL.
+ */
+void utilities_free(void *block)
+{
+	if (activeAllocator.deallocate != NULL)
+	{
+		activeAllocator.deallocate(block, activeAllocator.context);
+	}
+	else
+	{
+		free(block);
+	}
+}
+
+
+
+
+/**
+ * Pooled allocator
+ *
+ * Blocks of up to 'POOL_MAX_BLOCK_SIZE' bytes are rounded up to a size class and served from per-thread free lists, without locking.
+ * A thread's list that grows beyond 'POOL_THREAD_CACHE_LIMIT' blocks returns a batch of 'POOL_BATCH_SIZE' of them to a global,
+ * mutex-protected pool, from which threads that run out take whole batches, so blocks freed by one thread are reused by others and
+ * the lock is taken once per batch rather than once per allocation. New blocks are carved from slabs of 'POOL_SLAB_SIZE' bytes, which
+ * are kept for reuse for the life of the process. Larger blocks go to 'malloc'.
+ *
+ * Every block is preceded by a 16-byte header holding its size class(or, for a large block, its size), which keeps blocks 16-byte aligned.
+ */
+#define POOL_CLASS_COUNT 8
+#define POOL_MAX_BLOCK_SIZE 256
+#define POOL_HEADER_SIZE 16
+#define POOL_LARGE_CLASS ((size_t)-1)
+
+static const size_t poolClassSizes[POOL_CLASS_COUNT] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+
+typedef struct PoolHeader
+{
+	size_t sizeClass; // Index into 'poolClassSizes', or POOL_LARGE_CLASS.
+	size_t size; // The usable size of the block.
+} PoolHeader;
+
+typedef struct PoolBlock
+{
+	struct PoolBlock *next; // The next block of a free list or batch.
+	struct PoolBlock *nextBatch; // In the first block of a batch in the global pool, the next batch.
+} PoolBlock;
+
+typedef struct PoolThreadCache
+{
+	PoolBlock *freeLists[POOL_CLASS_COUNT];
+	size_t freeCounts[POOL_CLASS_COUNT];
+} PoolThreadCache;
+
+typedef struct PoolSlab
+{
+	struct PoolSlab *next;
+} PoolSlab;
+
+static pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;
+static PoolBlock *poolGlobalBatches[POOL_CLASS_COUNT]; // Each a list of batches of POOL_BATCH_SIZE blocks, guarded by 'poolMutex'.
+static PoolSlab *poolSlabs; // Every slab carved so far, guarded by 'poolMutex'.
+static pthread_key_t poolThreadKey;
+static pthread_once_t poolThreadKeyOnce = PTHREAD_ONCE_INIT;
+static _Thread_local PoolThreadCache *poolThreadCache;
+
+
+/**
+ * pool_class_for_size
+ *
+ * Returns the smallest size class holding 'size' bytes, or POOL_LARGE_CLASS.
+ */
+static inline size_t pool_class_for_size(size_t size)
+{
+	if (size > POOL_MAX_BLOCK_SIZE)
+	{
+		return POOL_LARGE_CLASS;
+	}
+	size_t sizeClass = 0;
+	while (poolClassSizes[sizeClass] < size)
+	{
+		sizeClass++;
+	}
+	return sizeClass;
+}
+
+
+/**
+ * pool_return_batch
+ *
+ * Moves 'count' blocks from the head of a thread's free list to the global pool as one batch.
+ */
+static void pool_return_batch(PoolThreadCache *cache, size_t sizeClass, size_t count)
+{
+	PoolBlock *first = cache->freeLists[sizeClass];
+	PoolBlock *last = first;
+	for (size_t i = 1; i < count; i++)
+	{
+		last = last->next;
+	}
+	cache->freeLists[sizeClass] = last->next;
+	cache->freeCounts[sizeClass] -= count;
+	last->next = NULL;
+	
+	pthread_mutex_lock(&poolMutex);
+	first->nextBatch = poolGlobalBatches[sizeClass];
+	poolGlobalBatches[sizeClass] = first;
+	pthread_mutex_unlock(&poolMutex);
+}
+
+
+/**
+ * pool_thread_exit
+ *
+ * Thread-exit destructor, hands a finishing thread's cached blocks to the global pool.
+ */
+static void pool_thread_exit(void *argument)
+{
+	PoolThreadCache *cache = (PoolThreadCache *)argument;
+	for (size_t sizeClass = 0; sizeClass < POOL_CLASS_COUNT; sizeClass++)
+	{
+		while (cache->freeCounts[sizeClass] > 0)
+		{
+			size_t count = (cache->freeCounts[sizeClass] < POOL_BATCH_SIZE) ? cache->freeCounts[sizeClass] : POOL_BATCH_SIZE;
+			pool_return_batch(cache, sizeClass, count);
+		}
+	}
+	free(cache);
+	poolThreadCache = NULL; // A later destructor that allocates gets a fresh cache, freed again by the next destructor round.
+}
+
+
+static void pool_create_thread_key(void)
+{
+	pthread_key_create(&poolThreadKey, pool_thread_exit);
+}
+
+
+/**
+ * pool_refill
+ *
+ * Gives a thread's empty free list a batch from the global pool, or else a slab's worth of new blocks.
+ */
+static void pool_refill(PoolThreadCache *cache, size_t sizeClass)
+{
+	pthread_mutex_lock(&poolMutex);
+	PoolBlock *batch = poolGlobalBatches[sizeClass];
+	if (batch != NULL)
+	{
+		poolGlobalBatches[sizeClass] = batch->nextBatch;
+		pthread_mutex_unlock(&poolMutex);
+		
+		size_t count = 0;
+		for (PoolBlock *block = batch; block != NULL; block = block->next)
+		{
+			count++;
+		}
+		cache->freeLists[sizeClass] = batch;
+		cache->freeCounts[sizeClass] = count;
+		return;
+	}
+	
+	PoolSlab *slab = (PoolSlab *)malloc(POOL_SLAB_SIZE);
+	if (slab == NULL)
+	{
+		pthread_mutex_unlock(&poolMutex);
+		return;
+	}
+	slab->next = poolSlabs;
+	poolSlabs = slab;
+	pthread_mutex_unlock(&poolMutex);
+	
+	
+	/// Carve the slab, after its own 16-byte link, into blocks with their headers.
+	size_t stride = POOL_HEADER_SIZE + poolClassSizes[sizeClass];
+	size_t count = (POOL_SLAB_SIZE - POOL_HEADER_SIZE) / stride;
+	char *base = (char *)slab + POOL_HEADER_SIZE;
+	PoolBlock *list = NULL;
+	for (size_t i = count; i-- > 0;)
+	{
+		PoolHeader *header = (PoolHeader *)(base + i * stride);
+		header->sizeClass = sizeClass;
+		header->size = poolClassSizes[sizeClass];
+		PoolBlock *block = (PoolBlock *)((char *)header + POOL_HEADER_SIZE);
+		block->next = list;
+		list = block;
+	}
+	cache->freeLists[sizeClass] = list;
+	cache->freeCounts[sizeClass] = count;
+}
+
+
+/**
+ * pool_get_thread_cache
+ *
+ * Returns the calling thread's cache, creating it and registering its exit destructor on first use.
+ */
+static PoolThreadCache *pool_get_thread_cache(void)
+{
+	if (poolThreadCache == NULL)
+	{
+		pthread_once(&poolThreadKeyOnce, pool_create_thread_key);
+		poolThreadCache = (PoolThreadCache *)calloc(1, sizeof(PoolThreadCache));
+		if (poolThreadCache == NULL)
+		{
+			return NULL;
+		}
+		pthread_setspecific(poolThreadKey, poolThreadCache);
+	}
+	return poolThreadCache;
+}
+
+
+/**
+ * pool_allocate
+ *
+ * Takes a block from the calling thread's free list for its size class, refilling the list when empty.
+ */
+static void *pool_allocate(size_t size, void *context)
+{
+	(void)context;
+	size_t sizeClass = pool_class_for_size(size);
+	PoolThreadCache *cache = (sizeClass != POOL_LARGE_CLASS) ? pool_get_thread_cache() : NULL;
+	if (cache == NULL)
+	{
+		PoolHeader *header = (PoolHeader *)malloc(POOL_HEADER_SIZE + size);
+		if (header == NULL)
+		{
+			return NULL;
+		}
+		header->sizeClass = POOL_LARGE_CLASS;
+		header->size = size;
+		return (char *)header + POOL_HEADER_SIZE;
+	}
+	
+	if (cache->freeLists[sizeClass] == NULL)
+	{
+		pool_refill(cache, sizeClass);
+		if (cache->freeLists[sizeClass] == NULL)
+		{
+			return NULL;
+		}
+	}
+	PoolBlock *block = cache->freeLists[sizeClass];
+	cache->freeLists[sizeClass] = block->next;
+	cache->freeCounts[sizeClass]--;
+	return block;
+}
+
+
+/**
+ * pool_deallocate
+ *
+ * Pushes a block onto the calling thread's free list, returning a batch to the global pool once the list is over its limit.
+ */
+static void pool_deallocate(void *pointer, void *context)
+{
+	(void)context;
+	if (pointer == NULL)
+	{
+		return;
+	}
+	
+	PoolHeader *header = (PoolHeader *)((char *)pointer - POOL_HEADER_SIZE);
+	size_t sizeClass = header->sizeClass;
+	PoolThreadCache *cache = (sizeClass != POOL_LARGE_CLASS) ? pool_get_thread_cache() : NULL;
+	if (cache == NULL)
+	{
+		if (sizeClass == POOL_LARGE_CLASS)
+		{
+			free(header);
+		}
+		return; // A small block is only lost if a thread cache cannot be created, the slab is still released at exit.
+	}
+	
+	PoolBlock *block = (PoolBlock *)pointer;
+	block->next = cache->freeLists[sizeClass];
+	cache->freeLists[sizeClass] = block;
+	if (++cache->freeCounts[sizeClass] > POOL_THREAD_CACHE_LIMIT)
+	{
+		pool_return_batch(cache, sizeClass, POOL_BATCH_SIZE);
+	}
+}
+
+
+/**
+ * pool_reallocate
+ *
+ * Keeps a block that still fits its size class, otherwise moves it to a block of the new size.
+ */
+static void *pool_reallocate(void *pointer, size_t size, void *context)
+{
+	if (pointer == NULL)
+	{
+		return pool_allocate(size, context);
+	}
+	
+	PoolHeader *header = (PoolHeader *)((char *)pointer - POOL_HEADER_SIZE);
+	if (header->sizeClass != POOL_LARGE_CLASS && size <= header->size)
+	{
+		return pointer; // Still fits its size class.
+	}
+	if (header->sizeClass == POOL_LARGE_CLASS && size > POOL_MAX_BLOCK_SIZE)
+	{
+		PoolHeader *grown = (PoolHeader *)realloc(header, POOL_HEADER_SIZE + size);
+		if (grown == NULL)
+		{
+			return NULL;
+		}
+		grown->size = size;
+		return (char *)grown + POOL_HEADER_SIZE;
+	}
+	
+	void *moved = pool_allocate(size, context);
+	if (moved != NULL)
+	{
+		copy_memory_block(moved, pointer, (header->size < size) ? header->size : size);
+		pool_deallocate(pointer, context);
+	}
+	return moved;
+}
+
+
+/**
+ * utilities_pooled_allocator
+ *
+ * Returns the pooled allocator, for 'utilities_set_allocator': size classes of 16 to 256 bytes served from per-thread free lists,
+ * which trade batches of blocks with a global pool, for workloads that allocate many small strings from many threads.
+ *
+ * @return The pooled allocator.
+ */
+const UtilitiesAllocator *utilities_pooled_allocator(void)
+{
+	static const UtilitiesAllocator pooledAllocator = { pool_allocate, pool_reallocate, pool_deallocate, NULL };
+	return &pooledAllocator;
+}
+
+
+
+
 
 
 
 int *allocate_memory_int_ptr(size_t sizeI)
 {
-	int *intPtr = (int*)malloc(sizeI * sizeof(int));
+	int *intPtr = (int*)utilities_malloc(sizeI * sizeof(int));
 	if (intPtr == NULL)
 	{
 		perror("\n\nError: Unable to allocate memory in 'allocate_memory_int_ptr'.\n");
@@ -85,7 +534,7 @@ int *allocate_memory_int_ptr(size_t sizeI)
 
 float *allocate_memory_float_ptr(size_t sizeF)
 {
-	float *floatPtr = (float*)malloc(sizeF * sizeof(float));
+	float *floatPtr = (float*)utilities_malloc(sizeF * sizeof(float));
 	if (floatPtr == NULL)
 	{
 		perror("\n\nError: Unable to allocate memory in 'allocate_memory_float_ptr'.\n");
@@ -98,7 +547,7 @@ float *allocate_memory_float_ptr(size_t sizeF)
 
 double *allocate_memory_double_ptr(size_t sizeD)
 {
-	double *doublePtr = (double*)malloc(sizeD * sizeof(double));
+	double *doublePtr = (double*)utilities_malloc(sizeD * sizeof(double));
 	if (doublePtr == NULL)
 	{
 		perror("\n\nError: Unable to allocate memory in 'allocate_memory_double_ptr'.\n");
@@ -111,7 +560,7 @@ double *allocate_memory_double_ptr(size_t sizeD)
 
 char *allocate_memory_char_ptr(size_t sizeC)
 {
-	char *charPtr = (char*)malloc(sizeC * sizeof(char));
+	char *charPtr = (char*)utilities_malloc(sizeC * sizeof(char));
 	if (charPtr == NULL)
 	{
 		perror("\n\nError: Unable to allocate memory in 'allocate_memory_char_ptr'.\n");
@@ -126,7 +575,7 @@ char *allocate_memory_char_ptr(size_t sizeC)
 
 int **allocate_memory_int_ptr_ptr(size_t sizeI)
 {
-	int **intPtrPtr = (int**)malloc(sizeI * sizeof(int*));
+	int **intPtrPtr = (int**)utilities_malloc(sizeI * sizeof(int*));
 	if (intPtrPtr == NULL)
 	{
 		perror("\n\nError: Unable to allocate memory in 'allocate_memory_int_ptr_ptr'.\n");
@@ -146,7 +595,7 @@ int **allocate_memory_int_ptr_ptr(size_t sizeI)
 
 float **allocate_memory_float_ptr_ptr(size_t sizeF)
 {
-	float **floatPtrPtr = (float**)malloc(sizeF * sizeof(float*));
+	float **floatPtrPtr = (float**)utilities_malloc(sizeF * sizeof(float*));
 	if (floatPtrPtr == NULL)
 	{
 		perror("\n\nError: Unable to allocate memory in 'allocate_memory_float_ptr_ptr'.\n");
@@ -166,7 +615,7 @@ float **allocate_memory_float_ptr_ptr(size_t sizeF)
 
 double **allocate_memory_double_ptr_ptr(size_t sizeD)
 {
-	double **doublePtrPtr = (double**)malloc(sizeD * sizeof(double*));
+	double **doublePtrPtr = (double**)utilities_malloc(sizeD * sizeof(double*));
 	if (doublePtrPtr == NULL)
 	{
 		perror("\n\nError: Unable to allocate memory in 'allocate_memory_double_ptr_ptr'.\n");
@@ -186,7 +635,7 @@ double **allocate_memory_double_ptr_ptr(size_t sizeD)
 
 char **allocate_memory_char_ptr_ptr(size_t strSize, size_t numStrings) // Allocate memory for the array of char* pointers
 {
-	char **charPtrPtr = (char**)malloc(numStrings * sizeof(char*));
+	char **charPtrPtr = (char**)utilities_malloc(numStrings * sizeof(char*));
 	if (charPtrPtr == NULL)
 	{
 		perror("\n\nError: Unable to allocate memory in 'allocate_memory_char_ptr_ptr'.\n");
@@ -213,10 +662,10 @@ void deallocate_memory_int_ptr_ptr(int **intPtrPtr, size_t numInts)
 		// First, free each element
 		for (size_t i = 0; i < numInts; i++)
 		{
-			free(intPtrPtr[i]);
+			utilities_free(intPtrPtr[i]);
 		}
 		// Then, free the array of pointers
-		free(intPtrPtr);
+		utilities_free(intPtrPtr);
 	}
 }
 
@@ -228,10 +677,10 @@ void deallocate_memory_float_ptr_ptr(float **floatPtrPtr, size_t numFloats)
 		// First, free each element
 		for (size_t i = 0; i < numFloats; i++)
 		{
-			free(floatPtrPtr[i]);
+			utilities_free(floatPtrPtr[i]);
 		}
 		// Then, free the array of pointers
-		free(floatPtrPtr);
+		utilities_free(floatPtrPtr);
 	}
 }
 
@@ -243,10 +692,10 @@ void deallocate_memory_double_ptr_ptr(double **doublePtrPtr, size_t numDoubles)
 		// First, free each element
 		for (size_t i = 0; i < numDoubles; i++)
 		{
-			free(doublePtrPtr[i]);
+			utilities_free(doublePtrPtr[i]);
 		}
 		// Then, free the array of pointers
-		free(doublePtrPtr);
+		utilities_free(doublePtrPtr);
 	}
 }
 
@@ -258,527 +707,3978 @@ void deallocate_memory_char_ptr_ptr(char **charPtrPtr, size_t numStrings)
 		// First, free each string
 		for (size_t i = 0; i < numStrings; i++)
 		{
-			free(charPtrPtr[i]);
+			utilities_free(charPtrPtr[i]);
 		}
 		// Then, free the array of pointers
-		free(charPtrPtr);
+		utilities_free(charPtrPtr);
 	}
 }
 
 
 
 
+/**
+ * allocate_matrix
+ *
+ * Allocates a 'rows' x 'columns' matrix of 'elementSize'-byte elements in a single block: the index of row pointers followed, at the
+ * next 'MATRIX_ALIGNMENT' boundary, by the elements in row-major order with no gaps between rows. Row-major traversal is therefore
+ * sequential through memory, 'matrix[0]' addresses every element as a flat array, and the whole matrix is released by one call
+ * to 'deallocate_matrix'.
+ *
+ * @param rows The number of rows.
+ * @param columns The number of elements in each row.
+ * @param elementSize The size of an element in bytes.
+ * @return The array of row pointers, or NULL if the size of the matrix overflows 'size_t'.
+ */
+void **allocate_matrix(size_t rows, size_t columns, size_t elementSize)
+{
+	size_t indexSize, elementCount, dataSize, totalSize;
+	if (__builtin_mul_overflow(rows, sizeof(void *), &indexSize) || __builtin_mul_overflow(rows, columns, &elementCount) ||
+		__builtin_mul_overflow(elementCount, elementSize, &dataSize) || __builtin_add_overflow(indexSize, (size_t)MATRIX_ALIGNMENT - 1, &indexSize))
+	{
+		perror("\n\nError: Matrix size overflows in 'allocate_matrix'.\n");
+		return NULL;
+	}
+	indexSize &= ~((size_t)MATRIX_ALIGNMENT - 1);
+	if (__builtin_add_overflow(indexSize, dataSize, &totalSize))
+	{
+		perror("\n\nError: Matrix size overflows in 'allocate_matrix'.\n");
+		return NULL;
+	}
+	
+	
+	// Over-allocate through the allocator hook to align the index by hand, keeping the start of the block just before it for 'deallocate_matrix'.
+	size_t paddedSize;
+	if (__builtin_add_overflow(totalSize, sizeof(void *) + MATRIX_ALIGNMENT - 1, &paddedSize))
+	{
+		perror("\n\nError: Matrix size overflows in 'allocate_matrix'.\n");
+		return NULL;
+	}
+	char *block = (char *)utilities_malloc(paddedSize);
+	if (block == NULL){ perror("\n\nError: Unable to allocate memory in 'allocate_matrix'.\n");      exit(1); }
+	
+	uintptr_t aligned = ((uintptr_t)block + sizeof(void *) + MATRIX_ALIGNMENT - 1) & ~((uintptr_t)MATRIX_ALIGNMENT - 1);
+	void **rowPointers = (void **)aligned;
+	rowPointers[-1] = block;
+	char *data = (char *)rowPointers + indexSize;
+	size_t rowSize = columns * elementSize;
+	for (size_t i = 0; i < rows; i++)
+	{
+		rowPointers[i] = data + i * rowSize;
+	}
+	
+	return rowPointers;
+}
 
 
 /**
- * min
- * Calculates the minimum of two double values.
+ * allocate_matrix_int
  *
- * @param a The first value.
- * @param b The second value.
- * @return The minimum value.
+ * Allocates a 'rows' x 'columns' matrix of ints with 'allocate_matrix'.
+ *
+ * @param rows The number of rows.
+ * @param columns The number of elements in each row.
+ * @return The array of row pointers, freed by 'deallocate_matrix', or NULL if the size of the matrix overflows 'size_t'.
  */
-double min(double a, double b)
+int **allocate_matrix_int(size_t rows, size_t columns)
 {
-	return a < b ? a : b;  // If a is less than b, return a, otherwise return b.
+	return (int **)allocate_matrix(rows, columns, sizeof(int));
 }
 
 
 /**
- * max
- * Calculates the maximum of two double values.
+ * allocate_matrix_float
  *
- * @param a The first value.
- * @param b The second value.
- * @return The maximum value.
+ * Allocates a 'rows' x 'columns' matrix of floats with 'allocate_matrix'.
+ *
+ * @param rows The number of rows.
+ * @param columns The number of elements in each row.
+ * @return The array of row pointers, freed by 'deallocate_matrix', or NULL if the size of the matrix overflows 'size_t'.
  */
-double max(double a, double b)
+float **allocate_matrix_float(size_t rows, size_t columns)
 {
-	return a > b ? a : b; //  (1.) if a is greater than b, return a.  (2.) If a is NOT greater than b, then either b is greater than a or they are equal, in either case, return b
+	return (float **)allocate_matrix(rows, columns, sizeof(float));
 }
 
 
 /**
- * min_element
+ * allocate_matrix_double
  *
- * Finds the minimum element in an array of doubles.
- * Skips NaN values to find the minimum numerical value.
+ * Allocates a 'rows' x 'columns' matrix of doubles with 'allocate_matrix'.
  *
- * @param data The array of doubles.
- * @param n The number of elements in the array.
- * @return The minimum element, or NaN if the array is NULL or only contains NaNs.
+ * @param rows The number of rows.
+ * @param columns The number of elements in each row.
+ * @return The array of row pointers, freed by 'deallocate_matrix', or NULL if the size of the matrix overflows 'size_t'.
  */
-double min_element(double *data, int n)
+double **allocate_matrix_double(size_t rows, size_t columns)
 {
-	if(data == NULL)
-	{
-		perror("\n\nError: Data to find min element from was NULL in 'min_element'.\n");
+	return (double **)allocate_matrix(rows, columns, sizeof(double));
+}
+
+
+/**
+ * allocate_matrix_char
+ *
+ * Allocates a 'rows' x 'columns' matrix of chars with 'allocate_matrix', e.g., an array of fixed-size string buffers.
+ *
+ * @param rows The number of rows.
+ * @param columns The number of elements in each row.
+ * @return The array of row pointers, freed by 'deallocate_matrix', or NULL if the size of the matrix overflows 'size_t'.
+ */
+char **allocate_matrix_char(size_t rows, size_t columns)
+{
+	return (char **)allocate_matrix(rows, columns, sizeof(char));
+}
+
+
+/**
+ * deallocate_matrix
+ *
+ * Frees a matrix allocated by 'allocate_matrix' or one of its typed variants, index and elements together.
+ *
+ * @param matrix The array of row pointers returned by the allocator, may be NULL.
+ */
+void deallocate_matrix(void *matrix)
+{
+	if (matrix != NULL)
+	{
+		utilities_free(((void **)matrix)[-1]);
+	}
+}
+
+
+
+
+
+
+/**
+ * ArenaBlock / Arena
+ *
+ * An arena is a chain of large blocks carved up by bumping an offset. Blocks are kept across 'arena_reset' and reused in order,
+ * so a batch-oriented caller reaches a steady state in which resetting and refilling the arena performs no allocation at all.
+ */
+typedef struct ArenaBlock
+{
+	struct ArenaBlock *next;
+	size_t capacity;
+	size_t used;
+	unsigned char data[];
+} ArenaBlock;
+
+struct Arena
+{
+	ArenaBlock *first;
+	ArenaBlock *current;
+	size_t blockSize;
+};
+
+
+/**
+ * arena_create
+ *
+ * Creates an empty arena, its first block is allocated by the first call to 'arena_alloc'.
+ *
+ * @param blockSize The size of the blocks the arena grows by, 0 selects 'ARENA_DEFAULT_BLOCK_SIZE'.
+ * @return The new arena, to be released with 'arena_destroy'.
+ */
+Arena *arena_create(size_t blockSize)
+{
+	Arena *arena = (Arena *)utilities_malloc(sizeof(Arena));
+	if (arena == NULL)
+	{
+		perror("\n\nError: Unable to allocate memory in 'arena_create'.\n");
 		exit(1);
 	}
 	
+	arena->first = NULL;
+	arena->current = NULL;
+	arena->blockSize = blockSize > 0 ? blockSize : ARENA_DEFAULT_BLOCK_SIZE;
+	return arena;
+}
+
+
+/**
+ * arena_alloc
+ *
+ * Allocates 'size' bytes from an arena, aligned to 'ARENA_ALIGNMENT'. The memory is released only by 'arena_reset' or 'arena_destroy',
+ * never individually. Requests larger than the arena's block size get a block of their own.
+ *
+ * @param arena The arena to allocate from, arenas are not thread-safe and each thread should use its own.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, the program exits if memory cannot be allocated.
+ */
+void *arena_alloc(Arena *arena, size_t size)
+{
+	// Check for NULL input and handle error.
+	if (arena == NULL){ perror("\n\nError: arena was NULL in 'arena_alloc'.\n");      exit(1); }
+	
 	
-	double min_elem = NAN; // Initialize to NaN
-	for (int i = 0; i < n; i++) // Check from the start
+	/// Bump within the current block, moving on to blocks retained by 'arena_reset' before allocating a new one.
+	ArenaBlock *block = arena->current;
+	while (block != NULL)
 	{
-		if (!isnan(data[i]))
+		uintptr_t base = (uintptr_t)block->data;
+		uintptr_t aligned = (base + block->used + (ARENA_ALIGNMENT - 1)) & ~(uintptr_t)(ARENA_ALIGNMENT - 1);
+		if (aligned - base <= block->capacity && size <= block->capacity - (aligned - base))
+		{
+			block->used = (aligned - base) + size;
+			return (void *)aligned;
+		}
+		if (block->next == NULL)
 		{
-			min_elem = data[i]; // Found the first non-NaN element.
 			break;
 		}
+		block = block->next;
+		block->used = 0;
+		arena->current = block;
 	}
 	
 	
-	for(int i = 1; i<n;i++) // Start from 1 since 0 is already in min_elem
+	/// Append a new block, sized for the request if it exceeds the block size.
+	size_t capacity = (size + ARENA_ALIGNMENT > arena->blockSize) ? size + ARENA_ALIGNMENT : arena->blockSize;
+	ArenaBlock *newBlock = (ArenaBlock *)utilities_malloc(sizeof(ArenaBlock) + capacity);
+	if (newBlock == NULL)
 	{
-		if (!isnan(data[i])) // Check if the value is not NaN
-		{
-			min_elem = min(min_elem, data[i]);
-		}
+		perror("\n\nError: Unable to allocate memory in 'arena_alloc'.\n");
+		exit(1);
+	}
+	newBlock->next = NULL;
+	newBlock->capacity = capacity;
+	newBlock->used = 0;
+	if (block != NULL)
+	{
+		block->next = newBlock;
 	}
+	else
+	{
+		arena->first = newBlock;
+	}
+	arena->current = newBlock;
 	
-	return min_elem;
+	return arena_alloc(arena, size);
 }
 
 
 /**
- * max_element
+ * arena_reset
  *
- * Finds the maximum element in an array of doubles.
- * Skips NaN values to find the maximum numerical value.
+ * Releases every allocation made from an arena in a single step, keeping its blocks for reuse.
  *
- * @param data The array of doubles.
- * @param n The number of elements in the array.
- * @return The maximum element, or NaN if the array is NULL or only contains NaNs.
+ * @param arena The arena to reset.
  */
-double max_element(double *data, int n)
+void arena_reset(Arena *arena)
 {
-	if(data == NULL)
+	if (arena == NULL)
 	{
-		perror("\n\nError: Data to find max element from was NULL in 'max_element'.\n");
-		exit(1);
+		return;
+	}
+	
+	arena->current = arena->first;
+	if (arena->first != NULL)
+	{
+		arena->first->used = 0;
+	}
+}
+
+
+/**
+ * arena_destroy
+ *
+ * Frees an arena together with every allocation made from it.
+ *
+ * @param arena The arena to destroy, may be NULL.
+ */
+void arena_destroy(Arena *arena)
+{
+	if (arena == NULL)
+	{
+		return;
+	}
+	
+	ArenaBlock *block = arena->first;
+	while (block != NULL)
+	{
+		ArenaBlock *next = block->next;
+		utilities_free(block);
+		block = next;
+	}
+	utilities_free(arena);
+}
+
+
+
+
+/// Digit pairs "00" to "99", so integers are formatted two digits per division.
+static const char digitPairs[201] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+
+/**
+ * format_uint64
+ *
+ * Formats an unsigned 64-bit integer in decimal, two digits at a time from a table of digit pairs rather than one per division.
+ *
+ * @param value The value to format.
+ * @param buffer The caller's buffer, at least 'NUMBER_FORMAT_BUFFER_SIZE' bytes, receives the NULL-terminated digits.
+ * @return The number of characters written, excluding the terminator.
+ */
+size_t format_uint64(uint64_t value, char *buffer)
+{
+	char digits[20];
+	int position = 20;
+	while (value >= 100)
+	{
+		unsigned pair = (unsigned)(value % 100) * 2;
+		value /= 100;
+		digits[--position] = digitPairs[pair + 1];
+		digits[--position] = digitPairs[pair];
+	}
+	if (value >= 10)
+	{
+		digits[--position] = digitPairs[value * 2 + 1];
+		digits[--position] = digitPairs[value * 2];
+	}
+	else
+	{
+		digits[--position] = (char)('0' + value);
+	}
+	
+	size_t length = (size_t)(20 - position);
+	copy_memory_block(buffer, digits + position, length);
+	buffer[length] = '\0';
+	return length;
+}
+
+
+/**
+ * format_int64
+ *
+ * Formats a signed 64-bit integer in decimal with 'format_uint64', the replacement for 'snprintf' with "%lld".
+ *
+ * @param value The value to format.
+ * @param buffer The caller's buffer, at least 'NUMBER_FORMAT_BUFFER_SIZE' bytes, receives the NULL-terminated number.
+ * @return The number of characters written, excluding the terminator.
+ */
+size_t format_int64(int64_t value, char *buffer)
+{
+	if (value < 0)
+	{
+		buffer[0] = '-';
+		return 1 + format_uint64(0 - (uint64_t)value, buffer + 1); // Negated as unsigned, which is also correct for INT64_MIN.
+	}
+	return format_uint64((uint64_t)value, buffer);
+}
+
+
+/**
+ * DiyFp
+ *
+ * A floating-point number with a 64-bit significand and no implicit bit, 'f' * 2^'e', the working type of the Grisu algorithm.
+ */
+typedef struct DiyFp
+{
+	uint64_t f;
+	int e;
+} DiyFp;
+
+
+/// Normalized significands and binary exponents of the powers of ten 10^-348, 10^-340, ..., 10^340, rounded to nearest.
+static const uint64_t cachedPowerSignificands[87] =
+{
+	0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+	0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+	0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+	0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+	0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+	0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+	0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+	0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+	0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+	0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+	0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+	0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+	0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+	0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+	0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+	0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+	0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+	0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+	0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+	0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+	0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+	0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+static const int16_t cachedPowerBinaryExponents[87] =
+{
+	-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927, -901, -874, -847, -821,
+	-794, -768, -741, -715, -688, -661, -635, -608, -582, -555, -529, -502, -475, -449, -422, -396,
+	-369, -343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+	56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348, 375, 402, 428, 455,
+	481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+	907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static const uint64_t powersOfTen[20] =
+{
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+	10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+	10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+
+/**
+ * diy_fp_multiply
+ *
+ * Multiplies two DiyFp numbers, keeping the rounded upper 64 bits of the 128-bit product of the significands.
+ */
+static DiyFp diy_fp_multiply(DiyFp x, DiyFp y)
+{
+	DiyFp product;
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 full = (unsigned __int128)x.f * y.f;
+	product.f = (uint64_t)(full >> 64) + (((uint64_t)full >> 63) & 1); // Round to nearest.
+#else
+	const uint64_t mask32 = 0xFFFFFFFFULL;
+	uint64_t a = x.f >> 32, b = x.f & mask32, c = y.f >> 32, d = y.f & mask32;
+	uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+	uint64_t middle = (bd >> 32) + (ad & mask32) + (bc & mask32) + (1ULL << 31); // Round to nearest.
+	product.f = ac + (ad >> 32) + (bc >> 32) + (middle >> 32);
+#endif
+	product.e = x.e + y.e + 64;
+	return product;
+}
+
+
+/**
+ * diy_fp_normalize
+ *
+ * Shifts a non-zero DiyFp so that the top bit of its significand is set.
+ */
+static DiyFp diy_fp_normalize(DiyFp x)
+{
+	int shift = __builtin_clzll(x.f);
+	x.f <<= shift;
+	x.e -= shift;
+	return x;
+}
+
+
+/**
+ * grisu_round
+ *
+ * Moves the last generated digit towards the exact value while the shorter result is still inside the rounding interval.
+ */
+static void grisu_round(char *digits, int length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance)
+{
+	while (rest < distance && delta - rest >= tenKappa && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance))
+	{
+		digits[length - 1]--;
+		rest += tenKappa;
+	}
+}
+
+
+/**
+ * grisu2
+ *
+ * Grisu2(Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers", 2010): generates the shortest digits, in all
+ * but rare cases, that read back as a positive finite 'value', using only 64-bit integer arithmetic and a cached power of ten.
+ *
+ * @return The number of digits written to 'digits', the value being 'digits' * 10^'*decimalExponent'.
+ */
+static int grisu2(double value, char *digits, int *decimalExponent)
+{
+	uint64_t bits;
+	copy_memory_block(&bits, &value, sizeof(bits));
+	const uint64_t hiddenBit = 1ULL << 52;
+	int biasedExponent = (int)((bits >> 52) & 0x7FF);
+	DiyFp v = { bits & (hiddenBit - 1), -1074 };
+	if (biasedExponent != 0)
+	{
+		v.f |= hiddenBit;
+		v.e = biasedExponent - 1075;
+	}
+	
+	
+	/// The boundaries of the rounding interval, halfway to the neighbouring doubles(the lower one is closer at a power of two), with the upper one normalized.
+	DiyFp upper = { (v.f << 1) + 1, v.e - 1 };
+	upper = diy_fp_normalize(upper);
+	DiyFp lower = (v.f == hiddenBit) ? (DiyFp){ (v.f << 2) - 1, v.e - 2 } : (DiyFp){ (v.f << 1) - 1, v.e - 1 };
+	lower.f <<= lower.e - upper.e;
+	lower.e = upper.e;
+	
+	
+	/// Scale by the cached power of ten that brings the exponent into [-60, -32].
+	double estimate = (-61 - upper.e) * 0.30102999566398114 + 347;
+	int k = (int)estimate;
+	if (estimate - k > 0.0)
+	{
+		k++;
+	}
+	int index = (k >> 3) + 1;
+	DiyFp cachedPower = { cachedPowerSignificands[index], cachedPowerBinaryExponents[index] };
+	*decimalExponent = -(-348 + index * 8);
+	
+	DiyFp w = diy_fp_multiply(diy_fp_normalize(v), cachedPower);
+	DiyFp wPlus = diy_fp_multiply(upper, cachedPower);
+	DiyFp wMinus = diy_fp_multiply(lower, cachedPower);
+	wMinus.f++;
+	wPlus.f--;
+	
+	
+	/// Generate digits of the upper boundary until they are within the interval, the integral part first.
+	uint64_t delta = wPlus.f - wMinus.f;
+	uint64_t distance = wPlus.f - w.f;
+	int shift = -wPlus.e;
+	uint64_t oneMask = (1ULL << shift) - 1;
+	uint32_t integral = (uint32_t)(wPlus.f >> shift);
+	uint64_t fractional = wPlus.f & oneMask;
+	int kappa = 1;
+	while (kappa < 10 && integral >= powersOfTen[kappa])
+	{
+		kappa++;
 	}
 	
-	double max_elem = NAN; // Initialize to NaN
-	for (int i = 0; i < n; i++) // Check from the start
+	int length = 0;
+	while (kappa > 0)
 	{
-		if (!isnan(data[i]))
+		uint32_t digit = integral / (uint32_t)powersOfTen[kappa - 1];
+		integral %= (uint32_t)powersOfTen[kappa - 1];
+		if (digit != 0 || length != 0)
 		{
-			max_elem = data[i]; // Found the first non-NaN element.
-			break;
+			digits[length++] = (char)('0' + digit);
 		}
+		kappa--;
+		uint64_t rest = ((uint64_t)integral << shift) + fractional;
+		if (rest <= delta)
+		{
+			*decimalExponent += kappa;
+			grisu_round(digits, length, delta, rest, powersOfTen[kappa] << shift, distance);
+			return length;
+		}
+	}
+	
+	for (;;)
+	{
+		fractional *= 10;
+		delta *= 10;
+		uint32_t digit = (uint32_t)(fractional >> shift);
+		if (digit != 0 || length != 0)
+		{
+			digits[length++] = (char)('0' + digit);
+		}
+		fractional &= oneMask;
+		kappa--;
+		if (fractional < delta)
+		{
+			*decimalExponent += kappa;
+			grisu_round(digits, length, delta, fractional, 1ULL << shift, distance * powersOfTen[-kappa]);
+			return length;
+		}
+	}
+}
+
+
+/**
+ * format_double_shortest
+ *
+ * Formats a double with the fewest significant digits that read back('strtod') as the same value, without going through 'printf'.
+ * In rare cases where the shortest digits lie at the edge of the rounding interval, up to 17 digits are used instead. The layout is
+ * that of "%g": fixed notation for decimal exponents from -4 to 16 and otherwise scientific notation with a signed exponent of at
+ * least two digits, e.g., "0.1", "123.5", "1e+20", "2.5e-07".
+ * Zeros are "0" and "-0", and the non-finite values are "nan", "inf" and "-inf".
+ *
+ * @param value The value to format.
+ * @param buffer The caller's buffer, at least 'NUMBER_FORMAT_BUFFER_SIZE' bytes, receives the NULL-terminated number.
+ * @return The number of characters written, excluding the terminator.
+ */
+size_t format_double_shortest(double value, char *buffer)
+{
+	char *out = buffer;
+	if (isnan(value))
+	{
+		copy_memory_block(buffer, "nan", 4);
+		return 3;
+	}
+	if (signbit(value))
+	{
+		*out++ = '-';
+		value = -value;
+	}
+	if (isinf(value))
+	{
+		copy_memory_block(out, "inf", 4);
+		return (size_t)(out - buffer) + 3;
+	}
+	if (value == 0.0)
+	{
+		*out++ = '0';
+		*out = '\0';
+		return (size_t)(out - buffer);
 	}
 	
 	
-	for(int i = 1; i < n; i++) // Continue from where we left off
+	char digits[20];
+	int decimalExponent;
+	int length = grisu2(value, digits, &decimalExponent);
+	int pointPosition = length + decimalExponent; // The decimal point follows the first 'pointPosition' digits.
+	
+	if (pointPosition - 1 < -4 || pointPosition - 1 >= 17)
+	{
+		/// Scientific notation: d[.ddd]e±XX
+		*out++ = digits[0];
+		if (length > 1)
+		{
+			*out++ = '.';
+			copy_memory_block(out, digits + 1, (size_t)(length - 1));
+			out += length - 1;
+		}
+		int exponent = pointPosition - 1;
+		*out++ = 'e';
+		*out++ = (exponent < 0) ? '-' : '+';
+		exponent = (exponent < 0) ? -exponent : exponent;
+		if (exponent >= 100)
+		{
+			*out++ = (char)('0' + exponent / 100);
+			exponent %= 100;
+		}
+		*out++ = digitPairs[exponent * 2];
+		*out++ = digitPairs[exponent * 2 + 1];
+	}
+	else if (pointPosition >= length)
 	{
-		if (!isnan(data[i])) // Check if the value is not NaN
+		/// An integer: the digits followed by zeros.
+		copy_memory_block(out, digits, (size_t)length);
+		out += length;
+		for (int i = length; i < pointPosition; i++)
 		{
-			max_elem = max(max_elem, data[i]);
+			*out++ = '0';
 		}
 	}
+	else if (pointPosition > 0)
+	{
+		/// The decimal point falls among the digits.
+		copy_memory_block(out, digits, (size_t)pointPosition);
+		out += pointPosition;
+		*out++ = '.';
+		copy_memory_block(out, digits + pointPosition, (size_t)(length - pointPosition));
+		out += length - pointPosition;
+	}
+	else
+	{
+		/// Less than one: "0." and zeros before the digits.
+		*out++ = '0';
+		*out++ = '.';
+		for (int i = pointPosition; i < 0; i++)
+		{
+			*out++ = '0';
+		}
+		copy_memory_block(out, digits, (size_t)length);
+		out += length;
+	}
 	
-	return max_elem;
+	*out = '\0';
+	return (size_t)(out - buffer);
 }
 
 
 
 
+/**
+ * BufferedWriter
+ *
+ * Output accumulated in a user-space buffer and handed to the target in large writes. The target is a file descriptor, written
+ * with 'write'/'writev', or a 'FILE*', which is flushed first so earlier stdio output keeps its place and then written through its
+ * descriptor(or with 'fwrite' when it has none, as with memory streams).
+ */
+struct BufferedWriter
+{
+	int fd; // The descriptor written to, or -1 for a 'FILE*' without one.
+	FILE *file; // The stream, or NULL for a descriptor target.
+	char *buffer;
+	size_t capacity;
+	size_t used;
+	bool failed; // Set by the first failed write, every later write is then refused.
+};
 
 
+/**
+ * create_writer
+ *
+ * Allocates a writer for a target with a buffer of 'bufferSize' bytes(0 for the default). The buffer is never smaller than
+ * 'NUMBER_FORMAT_BUFFER_SIZE', as the number writers format directly into it.
+ */
+static BufferedWriter *create_writer(int fd, FILE *file, size_t bufferSize)
+{
+	BufferedWriter *writer = (BufferedWriter *)utilities_malloc(sizeof(BufferedWriter));
+	if (bufferSize == 0)
+	{
+		bufferSize = WRITER_DEFAULT_BUFFER_SIZE;
+	}
+	else if (bufferSize < NUMBER_FORMAT_BUFFER_SIZE)
+	{
+		bufferSize = NUMBER_FORMAT_BUFFER_SIZE;
+	}
+	char *buffer = (char *)utilities_malloc(bufferSize);
+	if (writer == NULL || buffer == NULL)
+	{
+		perror("\n\nError: Unable to allocate memory in 'create_writer'.\n");
+		exit(1);
+	}
+	
+	writer->fd = fd;
+	writer->file = file;
+	writer->buffer = buffer;
+	writer->capacity = bufferSize;
+	writer->used = 0;
+	writer->failed = false;
+	return writer;
+}
 
 
-
+/**
+ * writer_create_fd
+ *
+ * Creates a writer that writes to a file descriptor with 'write' and 'writev'. The descriptor is not closed by 'writer_destroy'.
+ *
+ * @param fd The file descriptor to write to.
+ * @param bufferSize The size of the writer's buffer in bytes(at least 'NUMBER_FORMAT_BUFFER_SIZE'), 0 selects 'WRITER_DEFAULT_BUFFER_SIZE'.
+ * @return The writer, to be released with 'writer_destroy', or NULL if the descriptor is negative.
+ */
+BufferedWriter *writer_create_fd(int fd, size_t bufferSize)
+{
+	// Check for invalid input and handle error.
+	if (fd < 0){ perror("\n\nError: fd was negative in 'writer_create_fd'.\n");      return NULL; }
+	
+	
+	return create_writer(fd, NULL, bufferSize);
+}
 
 
 /**
- * convert_to_unix_time
+ * writer_create_file
  *
- * Converts a date/time string into Unix time(the number of seconds since the Unix Epoch, January 1, 1970).
- * It attempts to parse the string using various common date/time formats and returns the Unix time if successful.
- * The purpose of this function is to help in standardizing data set file contents.
+ * Creates a writer that writes to a stream. The stream is flushed before each of the writer's writes, so output already given to it
+ * through stdio is never reordered, and is not closed by 'writer_destroy'.
  *
- * @param dateTimeString A pointer to the string containing date/time information.
- * @return Unix time as time_t. Returns -1 if conversion fails.
+ * @param file The stream to write to.
+ * @param bufferSize The size of the writer's buffer in bytes(at least 'NUMBER_FORMAT_BUFFER_SIZE'), 0 selects 'WRITER_DEFAULT_BUFFER_SIZE'.
+ * @return The writer, to be released with 'writer_destroy', or NULL if the stream is NULL.
  */
-time_t convert_to_unix_time(const char *dateTimeString)
+BufferedWriter *writer_create_file(FILE *file, size_t bufferSize)
 {
-	struct tm tm; // Structure to hold the broken-down time.
-	char *parsed;  // A pointer to track where the parsing of the date/time string ended.
-	time_t unixTime = -1;
+	// Check for NULL input and handle error.
+	if (file == NULL){ perror("\n\nError: file was NULL in 'writer_create_file'.\n");      return NULL; }
 	
 	
-	// Iterate through each date/time format specified in commonDateTimeFormats.
-	for (int i = 0; i < 12; ++i)
-	{
-		set_memory_block(&tm, 0, sizeof(struct tm)); // Reset the tm structure for each iteration.
-		
+	int fd = fileno(file);
+	return create_writer(fd >= 0 ? fd : -1, file, bufferSize);
+}
+
+
+/**
+ * write_vectors
+ *
+ * Writes two byte ranges to a writer's target in order, with a single 'writev' where possible and resuming after partial writes.
+ *
+ * @return false if writing failed.
+ */
+static bool write_vectors(BufferedWriter *writer, const char *first, size_t firstLength, const char *second, size_t secondLength)
+{
+	if (writer->file != NULL && fflush(writer->file) != 0)
+	{
+		return false;
+	}
+	
+	if (writer->fd < 0)
+	{
+		return fwrite(first, 1, firstLength, writer->file) == firstLength && (secondLength == 0 || fwrite(second, 1, secondLength, writer->file) == secondLength) && fflush(writer->file) == 0;
+	}
+	
+	struct iovec vectors[2] = { { (void *)first, firstLength }, { (void *)second, secondLength } };
+	int vectorIndex = (firstLength == 0) ? 1 : 0;
+	while (vectorIndex < 2)
+	{
+		ssize_t written = writev(writer->fd, vectors + vectorIndex, 2 - vectorIndex);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return false;
+		}
+		
+		/// Skip the fully written vectors and advance into a partially written one.
+		size_t remaining = (size_t)written;
+		while (vectorIndex < 2 && remaining >= vectors[vectorIndex].iov_len)
+		{
+			remaining -= vectors[vectorIndex].iov_len;
+			vectorIndex++;
+		}
+		if (vectorIndex < 2)
+		{
+			vectors[vectorIndex].iov_base = (char *)vectors[vectorIndex].iov_base + remaining;
+			vectors[vectorIndex].iov_len -= remaining;
+		}
+	}
+	return true;
+}
+
+
+/**
+ * writer_flush
+ *
+ * Writes the buffered bytes of a writer to its target.
+ *
+ * @param writer The writer to flush.
+ * @return false if this or an earlier write of the writer failed.
+ */
+bool writer_flush(BufferedWriter *writer)
+{
+	// Check for NULL input and handle error.
+	if (writer == NULL){ perror("\n\nError: writer was NULL in 'writer_flush'.\n");      return false; }
+	
+	
+	if (!writer->failed && writer->used > 0)
+	{
+		writer->failed = !write_vectors(writer, writer->buffer, writer->used, NULL, 0);
+	}
+	else if (!writer->failed && writer->file != NULL)
+	{
+		writer->failed = (fflush(writer->file) != 0);
+	}
+	writer->used = 0;
+	return !writer->failed;
+}
+
+
+/**
+ * writer_write
+ *
+ * Appends bytes to a writer. Bytes that fit are copied into the buffer, and a run at least as large as the buffer is written directly,
+ * after the buffered bytes, with a single 'writev'.
+ *
+ * @param writer The writer to write to.
+ * @param bytes The bytes to write.
+ * @param length The number of bytes.
+ * @return false if this or an earlier write of the writer failed.
+ */
+bool writer_write(BufferedWriter *writer, const char *bytes, size_t length)
+{
+	// Check for NULL input and handle error.
+	if (writer == NULL || (bytes == NULL && length > 0)){ perror("\n\nError: writer and/or bytes was NULL in 'writer_write'.\n");      return false; }
+	
+	
+	if (length <= writer->capacity - writer->used)
+	{
+		copy_memory_block(writer->buffer + writer->used, bytes, length);
+		writer->used += length;
+		return !writer->failed;
+	}
+	if (length < writer->capacity)
+	{
+		return writer_flush(writer) && writer_write(writer, bytes, length);
+	}
+	
+	if (!writer->failed)
+	{
+		writer->failed = !write_vectors(writer, writer->buffer, writer->used, bytes, length);
+	}
+	writer->used = 0;
+	return !writer->failed;
+}
+
+
+/**
+ * writer_write_string
+ *
+ * Appends a NULL-terminated string to a writer.
+ *
+ * @return false if this or an earlier write of the writer failed.
+ */
+bool writer_write_string(BufferedWriter *writer, const char *characterString)
+{
+	size_t length = 0;
+	while (characterString != NULL && characterString[length] != '\0')
+	{
+		length++;
+	}
+	return writer_write(writer, characterString, length);
+}
+
+
+/**
+ * writer_reserve
+ *
+ * Makes room for at least 'length' bytes at the end of a writer's buffer, flushing it if necessary, for values formatted in place.
+ *
+ * @return A pointer to the free space, or NULL if flushing failed.
+ */
+static char *writer_reserve(BufferedWriter *writer, size_t length)
+{
+	if (writer->capacity - writer->used < length && !writer_flush(writer))
+	{
+		return NULL;
+	}
+	return writer->buffer + writer->used;
+}
+
+
+/**
+ * writer_write_double
+ *
+ * Appends a double to a writer, formatted directly into the writer's buffer: with the shortest digits that read back as the same
+ * value('format_double_shortest'), or like "%.*g" with a given number of significant digits.
+ *
+ * @param writer The writer to write to.
+ * @param value The value to write.
+ * @param precision The number of significant digits(at most 17), a value < 0 writes the shortest round-trip digits.
+ * @return false if this or an earlier write of the writer failed.
+ */
+bool writer_write_double(BufferedWriter *writer, double value, int precision)
+{
+	// Check for NULL input and handle error.
+	if (writer == NULL){ perror("\n\nError: writer was NULL in 'writer_write_double'.\n");      return false; }
+	
+	
+	char *destination = writer_reserve(writer, NUMBER_FORMAT_BUFFER_SIZE);
+	if (destination == NULL)
+	{
+		return false;
+	}
+	if (precision < 0)
+	{
+		writer->used += format_double_shortest(value, destination);
+	}
+	else
+	{
+		writer->used += (size_t)snprintf(destination, NUMBER_FORMAT_BUFFER_SIZE, "%.*g", precision > 17 ? 17 : precision, value);
+	}
+	return !writer->failed;
+}
+
+
+/**
+ * writer_write_int64
+ *
+ * Appends a signed 64-bit integer to a writer in decimal, formatted directly into the writer's buffer.
+ *
+ * @param writer The writer to write to.
+ * @param value The value to write.
+ * @return false if this or an earlier write of the writer failed.
+ */
+bool writer_write_int64(BufferedWriter *writer, int64_t value)
+{
+	// Check for NULL input and handle error.
+	if (writer == NULL){ perror("\n\nError: writer was NULL in 'writer_write_int64'.\n");      return false; }
+	
+	
+	char *destination = writer_reserve(writer, NUMBER_FORMAT_BUFFER_SIZE);
+	if (destination == NULL)
+	{
+		return false;
+	}
+	writer->used += format_int64(value, destination);
+	return !writer->failed;
+}
+
+
+/**
+ * writer_destroy
+ *
+ * Flushes a writer and frees it, leaving its target open.
+ *
+ * @param writer The writer to destroy, may be NULL.
+ * @return false if the final flush or an earlier write of the writer failed.
+ */
+bool writer_destroy(BufferedWriter *writer)
+{
+	if (writer == NULL)
+	{
+		return true;
+	}
+	
+	bool succeeded = writer_flush(writer);
+	utilities_free(writer->buffer);
+	utilities_free(writer);
+	return succeeded;
+}
+
+
+
+
+
+
+#ifdef UTILITIES_INSTRUMENTATION
+
+const char *instrumentedFunctionNames[INSTRUMENTED_FUNCTION_COUNT] =
+{
+	"preprocess_string_array",
+	"preprocess_string_array_parallel",
+	"convert_to_unix_time",
+	"parse_date_time_field",
+	"split_tokenized_string",
+	"identify_delimiter",
+	"merge_sort",
+	"merge_sort_parallel",
+	"radix_sort_doubles",
+	"radix_sort_doubles_11bit",
+	"radix_sort_doubles_parallel",
+	"radix_sort_key_value",
+	"argsort",
+	"radix_sort_strings",
+	"radix_sort_strings_stable",
+	"radix_sort_strings_parallel",
+	"multikey_quicksort_strings"
+};
+
+
+/**
+ * Every thread counts into its own 'InstrumentationCounters', linked into a global list while the thread runs, so counting never
+ * takes a lock or shares a cache line. Only the owning thread writes its counters(relaxed atomic load and store, not a locked add),
+ * and readers merge them under 'instrumentationMutex'; a finishing thread folds its counters into 'retiredCounters'.
+ */
+typedef struct InstrumentationCounters
+{
+	_Atomic uint64_t calls[INSTRUMENTED_FUNCTION_COUNT];
+	_Atomic uint64_t nanoseconds[INSTRUMENTED_FUNCTION_COUNT];
+	_Atomic uint64_t allocations;
+	_Atomic uint64_t bytesAllocated;
+	struct InstrumentationCounters *next;
+} InstrumentationCounters;
+
+static pthread_mutex_t instrumentationMutex = PTHREAD_MUTEX_INITIALIZER;
+static InstrumentationCounters *liveCounters; // Guarded by 'instrumentationMutex'.
+static InstrumentationSnapshot retiredCounters; // Guarded by 'instrumentationMutex'.
+static pthread_key_t instrumentationThreadKey;
+static pthread_once_t instrumentationThreadKeyOnce = PTHREAD_ONCE_INIT;
+static _Thread_local InstrumentationCounters *threadCounters;
+
+
+static inline void instrumentation_add(_Atomic uint64_t *counter, uint64_t value)
+{
+	atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+
+/**
+ * instrumentation_add_counters
+ *
+ * Adds a thread's counters to a snapshot.
+ */
+static void instrumentation_add_counters(InstrumentationSnapshot *snapshot, InstrumentationCounters *counters)
+{
+	for (int i = 0; i < INSTRUMENTED_FUNCTION_COUNT; i++)
+	{
+		snapshot->calls[i] += atomic_load_explicit(&counters->calls[i], memory_order_relaxed);
+		snapshot->nanoseconds[i] += atomic_load_explicit(&counters->nanoseconds[i], memory_order_relaxed);
+	}
+	snapshot->allocations += atomic_load_explicit(&counters->allocations, memory_order_relaxed);
+	snapshot->bytesAllocated += atomic_load_explicit(&counters->bytesAllocated, memory_order_relaxed);
+}
+
+
+/**
+ * instrumentation_thread_exit
+ *
+ * Thread-exit destructor, folds a finishing thread's counters into the retired totals.
+ */
+static void instrumentation_thread_exit(void *argument)
+{
+	InstrumentationCounters *counters = (InstrumentationCounters *)argument;
+	
+	pthread_mutex_lock(&instrumentationMutex);
+	instrumentation_add_counters(&retiredCounters, counters);
+	for (InstrumentationCounters **link = &liveCounters; *link != NULL; link = &(*link)->next)
+	{
+		if (*link == counters)
+		{
+			*link = counters->next;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&instrumentationMutex);
+	free(counters);
+	threadCounters = NULL; // An instrumented call from a later destructor registers fresh counters.
+}
+
+
+static void instrumentation_create_thread_key(void)
+{
+	pthread_key_create(&instrumentationThreadKey, instrumentation_thread_exit);
+}
+
+
+/**
+ * instrumentation_get_thread_counters
+ *
+ * Returns the calling thread's counters, registering them on first use, or NULL if they cannot be allocated.
+ */
+static InstrumentationCounters *instrumentation_get_thread_counters(void)
+{
+	if (threadCounters == NULL)
+	{
+		pthread_once(&instrumentationThreadKeyOnce, instrumentation_create_thread_key);
+		InstrumentationCounters *counters = (InstrumentationCounters *)calloc(1, sizeof(InstrumentationCounters));
+		if (counters == NULL)
+		{
+			return NULL;
+		}
+		pthread_mutex_lock(&instrumentationMutex);
+		counters->next = liveCounters;
+		liveCounters = counters;
+		pthread_mutex_unlock(&instrumentationMutex);
+		pthread_setspecific(instrumentationThreadKey, counters);
+		threadCounters = counters;
+	}
+	return threadCounters;
+}
+
+
+static inline uint64_t instrumentation_now(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+
+/**
+ * instrumentation_scope_begin
+ *
+ * Starts timing a call of an instrumented function, see 'INSTRUMENT_FUNCTION'.
+ *
+ * @param function The function being called.
+ * @return The scope, to be ended by 'instrumentation_scope_end'.
+ */
+InstrumentationScope instrumentation_scope_begin(InstrumentedFunction function)
+{
+	InstrumentationScope scope = { function, instrumentation_now() };
+	return scope;
+}
+
+
+/**
+ * instrumentation_scope_end
+ *
+ * Counts a call of an instrumented function and the time since its scope began.
+ *
+ * @param scope The scope started by 'instrumentation_scope_begin'.
+ */
+void instrumentation_scope_end(InstrumentationScope *scope)
+{
+	uint64_t elapsed = instrumentation_now() - scope->start;
+	InstrumentationCounters *counters = instrumentation_get_thread_counters();
+	if (counters != NULL)
+	{
+		instrumentation_add(&counters->calls[scope->function], 1);
+		instrumentation_add(&counters->nanoseconds[scope->function], elapsed);
+	}
+}
+
+
+/**
+ * instrumentation_count_allocation
+ *
+ * Counts an allocation made through the library's allocator hook.
+ *
+ * @param size The number of bytes requested.
+ */
+void instrumentation_count_allocation(size_t size)
+{
+	InstrumentationCounters *counters = instrumentation_get_thread_counters();
+	if (counters != NULL)
+	{
+		instrumentation_add(&counters->allocations, 1);
+		instrumentation_add(&counters->bytesAllocated, size);
+	}
+}
+
+
+/**
+ * instrumentation_snapshot
+ *
+ * Merges the counters of the running threads with those of the threads that have finished. Counts a running thread makes while
+ * the snapshot is taken may or may not be included.
+ *
+ * @param snapshot The snapshot to fill.
+ */
+void instrumentation_snapshot(InstrumentationSnapshot *snapshot)
+{
+	if (snapshot == NULL){ perror("\n\nError: NULL snapshot in 'instrumentation_snapshot'.\n");      return; }
+	
+	pthread_mutex_lock(&instrumentationMutex);
+	*snapshot = retiredCounters;
+	for (InstrumentationCounters *counters = liveCounters; counters != NULL; counters = counters->next)
+	{
+		instrumentation_add_counters(snapshot, counters);
+	}
+	pthread_mutex_unlock(&instrumentationMutex);
+}
+
+
+/**
+ * instrumentation_reset
+ *
+ * Zeroes every counter. Best called while no other thread is in the library, as a count in flight on another thread can survive the reset.
+ */
+void instrumentation_reset(void)
+{
+	pthread_mutex_lock(&instrumentationMutex);
+	InstrumentationSnapshot zero = { { 0 }, { 0 }, 0, 0 };
+	retiredCounters = zero;
+	for (InstrumentationCounters *counters = liveCounters; counters != NULL; counters = counters->next)
+	{
+		for (int i = 0; i < INSTRUMENTED_FUNCTION_COUNT; i++)
+		{
+			atomic_store_explicit(&counters->calls[i], 0, memory_order_relaxed);
+			atomic_store_explicit(&counters->nanoseconds[i], 0, memory_order_relaxed);
+		}
+		atomic_store_explicit(&counters->allocations, 0, memory_order_relaxed);
+		atomic_store_explicit(&counters->bytesAllocated, 0, memory_order_relaxed);
+	}
+	pthread_mutex_unlock(&instrumentationMutex);
+}
+
+
+static bool instrumentation_write_uint64(BufferedWriter *writer, uint64_t value)
+{
+	char digits[NUMBER_FORMAT_BUFFER_SIZE];
+	return writer_write(writer, digits, format_uint64(value, digits));
+}
+
+
+/**
+ * instrumentation_write_text
+ *
+ * Writes a snapshot as a table of the called functions, with their call counts, total and mean times, followed by the allocation totals.
+ *
+ * @param snapshot The snapshot to write.
+ * @param writer The writer to write it to.
+ * @return false if writing failed.
+ */
+bool instrumentation_write_text(const InstrumentationSnapshot *snapshot, BufferedWriter *writer)
+{
+	if (snapshot == NULL || writer == NULL){ perror("\n\nError: NULL snapshot or writer in 'instrumentation_write_text'.\n");      return false; }
+	
+	char line[160];
+	int length = snprintf(line, sizeof(line), "%-34s %12s %14s %12s\n", "function", "calls", "total ms", "mean ns");
+	bool succeeded = writer_write(writer, line, (size_t)length);
+	for (int i = 0; i < INSTRUMENTED_FUNCTION_COUNT; i++)
+	{
+		if (snapshot->calls[i] == 0)
+		{
+			continue;
+		}
+		length = snprintf(line, sizeof(line), "%-34s %12llu %14.3f %12llu\n", instrumentedFunctionNames[i], (unsigned long long)snapshot->calls[i],
+						  (double)snapshot->nanoseconds[i] * 1e-6, (unsigned long long)(snapshot->nanoseconds[i] / snapshot->calls[i]));
+		succeeded = writer_write(writer, line, (size_t)length) && succeeded;
+	}
+	length = snprintf(line, sizeof(line), "allocations: %llu, bytes allocated: %llu\n", (unsigned long long)snapshot->allocations,
+					  (unsigned long long)snapshot->bytesAllocated);
+	return writer_write(writer, line, (size_t)length) && succeeded;
+}
+
+
+/**
+ * instrumentation_write_json
+ *
+ * Writes a snapshot as a JSON object: {"functions": {"<name>": {"calls": n, "nanoseconds": n}, ...}, "allocations": n, "bytes_allocated": n},
+ * listing every instrumented function.
+ *
+ * @param snapshot The snapshot to write.
+ * @param writer The writer to write it to.
+ * @return false if writing failed.
+ */
+bool instrumentation_write_json(const InstrumentationSnapshot *snapshot, BufferedWriter *writer)
+{
+	if (snapshot == NULL || writer == NULL){ perror("\n\nError: NULL snapshot or writer in 'instrumentation_write_json'.\n");      return false; }
+	
+	bool succeeded = writer_write_string(writer, "{\"functions\": {");
+	for (int i = 0; i < INSTRUMENTED_FUNCTION_COUNT; i++)
+	{
+		succeeded = writer_write_string(writer, (i == 0) ? "\"" : ", \"") && succeeded;
+		succeeded = writer_write_string(writer, instrumentedFunctionNames[i]) && succeeded;
+		succeeded = writer_write_string(writer, "\": {\"calls\": ") && succeeded;
+		succeeded = instrumentation_write_uint64(writer, snapshot->calls[i]) && succeeded;
+		succeeded = writer_write_string(writer, ", \"nanoseconds\": ") && succeeded;
+		succeeded = instrumentation_write_uint64(writer, snapshot->nanoseconds[i]) && succeeded;
+		succeeded = writer_write_string(writer, "}") && succeeded;
+	}
+	succeeded = writer_write_string(writer, "}, \"allocations\": ") && succeeded;
+	succeeded = instrumentation_write_uint64(writer, snapshot->allocations) && succeeded;
+	succeeded = writer_write_string(writer, ", \"bytes_allocated\": ") && succeeded;
+	succeeded = instrumentation_write_uint64(writer, snapshot->bytesAllocated) && succeeded;
+	return writer_write_string(writer, "}\n") && succeeded;
+}
+
+#endif
+
+
+
+
+
+
+/**
+ * min
+ * Calculates the minimum of two double values.
+ *
+ * @param a The first value.
+ * @param b The second value.
+ * @return The minimum value.
+ */
+double min(double a, double b)
+{
+	return a < b ? a : b;  // If a is less than b, return a, otherwise return b.
+}
+
+
+/**
+ * max
+ * Calculates the maximum of two double values.
+ *
+ * @param a The first value.
+ * @param b The second value.
+ * @return The maximum value.
+ */
+double max(double a, double b)
+{
+	return a > b ? a : b; //  (1.) if a is greater than b, return a.  (2.) If a is NOT greater than b, then either b is greater than a or they are equal, in either case, return b
+}
+
+
+/**
+ * min_element
+ *
+ * Finds the minimum element in an array of doubles.
+ * Skips NaN values to find the minimum numerical value.
+ *
+ * @param data The array of doubles.
+ * @param n The number of elements in the array.
+ * @return The minimum element, or NaN if the array is NULL or only contains NaNs.
+ */
+double min_element(double *data, int n)
+{
+	if(data == NULL)
+	{
+		perror("\n\nError: Data to find min element from was NULL in 'min_element'.\n");
+		exit(1);
+	}
+	
+	double minElement, maxElement;
+	minmax_element(data, (n > 0) ? (size_t)n : 0, &minElement, &maxElement);
+	return minElement;
+}
+
+
+/**
+ * max_element
+ *
+ * Finds the maximum element in an array of doubles.
+ * Skips NaN values to find the maximum numerical value.
+ *
+ * @param data The array of doubles.
+ * @param n The number of elements in the array.
+ * @return The maximum element, or NaN if the array is NULL or only contains NaNs.
+ */
+double max_element(double *data, int n)
+{
+	if(data == NULL)
+	{
+		perror("\n\nError: Data to find max element from was NULL in 'max_element'.\n");
+		exit(1);
+	}
+	
+	double minElement, maxElement;
+	minmax_element(data, (n > 0) ? (size_t)n : 0, &minElement, &maxElement);
+	return maxElement;
+}
+
+
+/**
+ * minmax_element
+ *
+ * Finds the minimum and maximum of an array of doubles in a single pass, skipping NaN values. The comparisons are written so that
+ * a NaN never replaces the running minimum or maximum('x < minimum' is false for a NaN), which keeps the loop free of a NaN branch
+ * and lets it run four lanes at a time with AVX2('_mm256_min_pd' returns its second operand when either is NaN).
+ *
+ * @param data The array of doubles.
+ * @param n The number of elements in the array.
+ * @param minimum Set to the minimum element, or NaN if the array only contains NaNs.
+ * @param maximum Set to the maximum element, or NaN if the array only contains NaNs.
+ */
+void minmax_element(const double *data, size_t n, double *minimum, double *maximum)
+{
+	if (data == NULL || minimum == NULL || maximum == NULL){ perror("\n\nError: NULL data, minimum or maximum in 'minmax_element'.\n");      return; }
+	
+	double lowest = INFINITY;
+	double highest = -INFINITY;
+	size_t i = 0;
+	
+#if defined(SIMD_AVX2_AVAILABLE)
+	__m256d lowestLanes = _mm256_set1_pd(INFINITY);
+	__m256d highestLanes = _mm256_set1_pd(-INFINITY);
+	for (; i + 4 <= n; i += 4)
+	{
+		__m256d values = _mm256_loadu_pd(data + i);
+		lowestLanes = _mm256_min_pd(values, lowestLanes);
+		highestLanes = _mm256_max_pd(values, highestLanes);
+	}
+	double lanes[4];
+	_mm256_storeu_pd(lanes, lowestLanes);
+	for (int lane = 0; lane < 4; lane++)
+	{
+		lowest = (lanes[lane] < lowest) ? lanes[lane] : lowest;
+	}
+	_mm256_storeu_pd(lanes, highestLanes);
+	for (int lane = 0; lane < 4; lane++)
+	{
+		highest = (lanes[lane] > highest) ? lanes[lane] : highest;
+	}
+#endif
+	
+	for (; i < n; i++)
+	{
+		lowest = (data[i] < lowest) ? data[i] : lowest;
+		highest = (data[i] > highest) ? data[i] : highest;
+	}
+	
+	
+	/// Only an array without a single non-NaN value leaves the minimum above the maximum.
+	if (lowest > highest)
+	{
+		lowest = highest = NAN;
+	}
+	*minimum = lowest;
+	*maximum = highest;
+}
+
+
+
+
+
+
+/**
+ * Descriptive statistics
+ *
+ * 'describe' keeps four independent lanes of running statistics, element 'i' going to lane 'i % 4', so that the AVX2 kernel and
+ * the scalar fallback perform the same operations in the same order. Each lane holds a Kahan-compensated sum,
+ * Welford's running mean and sum of squared deviations('m2'), and its minimum and maximum; a NaN is counted and masked out of the
+ * lane. Infinities carry through the sum, the minimum and the maximum, and the mean is then taken from the sum. The lanes, and in 'describe_parallel' the threads' partial results, are then combined with Chan's pairwise update.
+ */
+#define DESCRIBE_LANES 4
+
+typedef struct DescribeLanes
+{
+	double count[DESCRIBE_LANES];
+	double sum[DESCRIBE_LANES];
+	double compensation[DESCRIBE_LANES];
+	double mean[DESCRIBE_LANES];
+	double m2[DESCRIBE_LANES];
+	double minimum[DESCRIBE_LANES];
+	double maximum[DESCRIBE_LANES];
+	size_t nanCount;
+} DescribeLanes;
+
+typedef struct DescribePartial
+{
+	double count;
+	double sum;
+	double compensation;
+	double mean;
+	double m2;
+	double minimum;
+	double maximum;
+	size_t nanCount;
+} DescribePartial;
+
+
+/**
+ * describe_lane_update
+ *
+ * Adds one value to a lane, the scalar form of the AVX2 kernel's update.
+ */
+static inline void describe_lane_update(DescribeLanes *lanes, int lane, double value)
+{
+	if (isnan(value))
+	{
+		lanes->nanCount++;
+		return;
+	}
+	
+	double adjusted = value - lanes->compensation[lane];
+	double total = lanes->sum[lane] + adjusted;
+	lanes->compensation[lane] = isfinite(total) ? (total - lanes->sum[lane]) - adjusted : 0.0; // An infinite sum has no rounding error to carry.
+	lanes->sum[lane] = total;
+	
+	lanes->count[lane] += 1.0;
+	double delta = value - lanes->mean[lane];
+	lanes->mean[lane] += delta / lanes->count[lane];
+	lanes->m2[lane] += delta * (value - lanes->mean[lane]);
+	
+	lanes->minimum[lane] = (value < lanes->minimum[lane]) ? value : lanes->minimum[lane];
+	lanes->maximum[lane] = (value > lanes->maximum[lane]) ? value : lanes->maximum[lane];
+}
+
+
+/**
+ * describe_merge_partials
+ *
+ * Combines the statistics of two disjoint sets of values(Chan et al.'s parallel variance update).
+ */
+static DescribePartial describe_merge_partials(DescribePartial a, DescribePartial b)
+{
+	if (b.count == 0)
+	{
+		a.nanCount += b.nanCount;
+		return a;
+	}
+	if (a.count == 0)
+	{
+		b.nanCount += a.nanCount;
+		return b;
+	}
+	
+	DescribePartial merged;
+	merged.count = a.count + b.count;
+	double delta = b.mean - a.mean;
+	merged.mean = a.mean + delta * (b.count / merged.count);
+	merged.m2 = a.m2 + b.m2 + delta * delta * (a.count * b.count / merged.count);
+	
+	/// Add the compensated sums, carrying both compensations and the rounding error of the addition itself.
+	double aSum = a.sum - a.compensation;
+	double bSum = b.sum - b.compensation;
+	merged.sum = aSum + bSum;
+	if (!isfinite(merged.sum))
+	{
+		merged.compensation = 0.0;
+	}
+	else
+	{
+		merged.compensation = (fabs(aSum) >= fabs(bSum)) ? -((aSum - merged.sum) + bSum) : -((bSum - merged.sum) + aSum);
+	}
+	
+	merged.minimum = (a.minimum < b.minimum) ? a.minimum : b.minimum;
+	merged.maximum = (a.maximum > b.maximum) ? a.maximum : b.maximum;
+	merged.nanCount = a.nanCount + b.nanCount;
+	return merged;
+}
+
+
+/**
+ * describe_chunk
+ *
+ * Runs the single-pass kernel over an array and folds its lanes into one partial result.
+ */
+static DescribePartial describe_chunk(const double *data, size_t n)
+{
+	DescribeLanes lanes;
+	for (int lane = 0; lane < DESCRIBE_LANES; lane++)
+	{
+		lanes.count[lane] = lanes.sum[lane] = lanes.compensation[lane] = lanes.mean[lane] = lanes.m2[lane] = 0.0;
+		lanes.minimum[lane] = INFINITY;
+		lanes.maximum[lane] = -INFINITY;
+	}
+	lanes.nanCount = 0;
+	size_t i = 0;
+	
+#if defined(SIMD_AVX2_AVAILABLE)
+	__m256d count = _mm256_setzero_pd();
+	__m256d sum = _mm256_setzero_pd();
+	__m256d compensation = _mm256_setzero_pd();
+	__m256d mean = _mm256_setzero_pd();
+	__m256d m2 = _mm256_setzero_pd();
+	__m256d minimum = _mm256_set1_pd(INFINITY);
+	__m256d maximum = _mm256_set1_pd(-INFINITY);
+	__m256d nanCounts = _mm256_setzero_pd();
+	const __m256d ones = _mm256_set1_pd(1.0);
+	
+	for (; i + DESCRIBE_LANES <= n; i += DESCRIBE_LANES)
+	{
+		__m256d values = _mm256_loadu_pd(data + i);
+		__m256d valid = _mm256_cmp_pd(values, values, _CMP_ORD_Q); // All ones where the value is not NaN.
+		nanCounts = _mm256_add_pd(nanCounts, _mm256_andnot_pd(valid, ones));
+		
+		__m256d adjusted = _mm256_sub_pd(values, compensation);
+		__m256d total = _mm256_add_pd(sum, adjusted);
+		__m256d finite = _mm256_cmp_pd(_mm256_sub_pd(total, total), _mm256_setzero_pd(), _CMP_EQ_OQ); // 'total - total' is NaN for an infinity.
+		compensation = _mm256_blendv_pd(compensation, _mm256_and_pd(finite, _mm256_sub_pd(_mm256_sub_pd(total, sum), adjusted)), valid);
+		sum = _mm256_blendv_pd(sum, total, valid);
+		
+		count = _mm256_add_pd(count, _mm256_and_pd(valid, ones));
+		__m256d delta = _mm256_sub_pd(values, mean);
+		__m256d updatedMean = _mm256_add_pd(mean, _mm256_div_pd(delta, count));
+		__m256d updatedM2 = _mm256_add_pd(m2, _mm256_mul_pd(delta, _mm256_sub_pd(values, updatedMean)));
+		mean = _mm256_blendv_pd(mean, updatedMean, valid);
+		m2 = _mm256_blendv_pd(m2, updatedM2, valid);
+		
+		minimum = _mm256_min_pd(values, minimum);
+		maximum = _mm256_max_pd(values, maximum);
+	}
+	
+	_mm256_storeu_pd(lanes.count, count);
+	_mm256_storeu_pd(lanes.sum, sum);
+	_mm256_storeu_pd(lanes.compensation, compensation);
+	_mm256_storeu_pd(lanes.mean, mean);
+	_mm256_storeu_pd(lanes.m2, m2);
+	_mm256_storeu_pd(lanes.minimum, minimum);
+	_mm256_storeu_pd(lanes.maximum, maximum);
+	double laneNanCounts[DESCRIBE_LANES];
+	_mm256_storeu_pd(laneNanCounts, nanCounts);
+	for (int lane = 0; lane < DESCRIBE_LANES; lane++)
+	{
+		lanes.nanCount += (size_t)laneNanCounts[lane];
+	}
+#endif
+	
+	for (; i < n; i++)
+	{
+		describe_lane_update(&lanes, (int)(i % DESCRIBE_LANES), data[i]);
+	}
+	
+	
+	/// Fold the lanes together.
+	DescribePartial result = { 0.0, 0.0, 0.0, 0.0, 0.0, INFINITY, -INFINITY, lanes.nanCount };
+	for (int lane = 0; lane < DESCRIBE_LANES; lane++)
+	{
+		DescribePartial partial = { lanes.count[lane], lanes.sum[lane], lanes.compensation[lane], lanes.mean[lane], lanes.m2[lane],
+									lanes.minimum[lane], lanes.maximum[lane], 0 };
+		result = describe_merge_partials(result, partial);
+	}
+	return result;
+}
+
+
+/**
+ * describe_finish
+ *
+ * Turns a partial result into the public statistics.
+ */
+static DescriptiveStatistics describe_finish(DescribePartial partial)
+{
+	DescriptiveStatistics statistics;
+	statistics.count = (size_t)partial.count;
+	statistics.nanCount = partial.nanCount;
+	statistics.sum = partial.sum - partial.compensation;
+	if (partial.count == 0)
+	{
+		statistics.minimum = statistics.maximum = statistics.mean = statistics.variance = statistics.sampleVariance = NAN;
+		return statistics;
+	}
+	statistics.minimum = partial.minimum;
+	statistics.maximum = partial.maximum;
+	statistics.mean = isfinite(partial.mean) ? partial.mean : statistics.sum / partial.count; // Welford's update turns infinities into NaN.
+	statistics.variance = partial.m2 / partial.count;
+	statistics.sampleVariance = (partial.count > 1) ? partial.m2 / (partial.count - 1) : NAN;
+	return statistics;
+}
+
+
+/**
+ * describe
+ *
+ * Computes the descriptive statistics of an array of doubles in a single pass: the number of values and of NaNs, and over the
+ * non-NaN values their minimum, maximum, compensated sum, mean, and population and sample variances. With AVX2 the pass runs four
+ * lanes at a time, masking NaNs rather than branching on them.
+ *
+ * @param data The array of doubles.
+ * @param n The number of elements in the array.
+ * @return The statistics, see 'DescriptiveStatistics'.
+ */
+DescriptiveStatistics describe(const double *data, size_t n)
+{
+	if (data == NULL && n > 0){ perror("\n\nError: data was NULL in 'describe'.\n");      n = 0; }
+	
+	return describe_finish(describe_chunk(data, n));
+}
+
+
+typedef struct DescribeTask
+{
+	const double *data;
+	size_t n;
+	DescribePartial partial;
+} DescribeTask;
+
+
+static void *describe_worker(void *argument)
+{
+	DescribeTask *task = (DescribeTask *)argument;
+	task->partial = describe_chunk(task->data, task->n);
+	return NULL;
+}
+
+
+/**
+ * describe_parallel
+ *
+ * Multi-threaded 'describe': the array is split into one contiguous chunk per thread, each described in a single pass, and the
+ * chunks' results are combined in order. Arrays shorter than 'DESCRIBE_PARALLEL_THRESHOLD' are described on the calling thread, and
+ * no thread gets fewer than a quarter of that many elements.
+ *
+ * @param data The array of doubles.
+ * @param n The number of elements in the array.
+ * @param numThreads The number of threads, or a value <= 0 for one per online processor.
+ * @return The statistics, see 'DescriptiveStatistics'.
+ */
+DescriptiveStatistics describe_parallel(const double *data, size_t n, int numThreads)
+{
+	if (data == NULL && n > 0){ perror("\n\nError: data was NULL in 'describe_parallel'.\n");      n = 0; }
+	
+	numThreads = resolve_thread_count(numThreads);
+	size_t maxThreads = n / (DESCRIBE_PARALLEL_THRESHOLD / 4);
+	if ((size_t)numThreads > maxThreads)
+	{
+		numThreads = (int)maxThreads;
+	}
+	if (n < DESCRIBE_PARALLEL_THRESHOLD || numThreads <= 1)
+	{
+		return describe(data, n);
+	}
+	
+	DescribeTask *tasks = (DescribeTask *)utilities_malloc(numThreads * sizeof(DescribeTask));
+	pthread_t *threads = (pthread_t *)utilities_malloc(numThreads * sizeof(pthread_t));
+	if (tasks == NULL || threads == NULL){ perror("\n\nError: Unable to allocate memory in 'describe_parallel'.\n");      exit(1); }
+	
+	size_t chunkSize = n / numThreads;
+	for (int t = 0; t < numThreads; t++)
+	{
+		tasks[t].data = data + t * chunkSize;
+		tasks[t].n = (t == numThreads - 1) ? n - t * chunkSize : chunkSize;
+		if (t > 0 && pthread_create(&threads[t], NULL, describe_worker, &tasks[t]) != 0)
+		{
+			perror("\n\nError: Unable to create thread in 'describe_parallel'.\n");
+			exit(1);
+		}
+	}
+	describe_worker(&tasks[0]); // The calling thread takes the first chunk.
+	
+	DescribePartial result = tasks[0].partial;
+	for (int t = 1; t < numThreads; t++)
+	{
+		pthread_join(threads[t], NULL);
+		result = describe_merge_partials(result, tasks[t].partial);
+	}
+	
+	utilities_free(tasks);
+	utilities_free(threads);
+	return describe_finish(result);
+}
+
+
+
+
+
+
+
+
+
+
+
+/**
+ * days_from_civil
+ *
+ * Returns the number of days from 1970-01-01 to the given proleptic Gregorian date(month 1-12), in pure integer arithmetic
+ * over 400-year eras, so it is valid for any year and needs neither the C library nor the time zone database.
+ */
+static int64_t days_from_civil(int64_t year, int64_t month, int64_t day)
+{
+	year -= (month <= 2);
+	int64_t era = (year >= 0 ? year : year - 399) / 400;
+	int64_t yearOfEra = year - era * 400; // [0, 399]
+	int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1; // [0, 365], counted from March 1st
+	int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear; // [0, 146096]
+	return era * 146097 + dayOfEra - 719468;
+}
+
+
+/**
+ * convert_tm_to_unix_time
+ *
+ * Converts a broken-down local time, as filled in by 'strptime' with 'tm_isdst' 0, into Unix time with the same result as 'mktime',
+ * but without 'mktime' on the common path. 'mktime' consults the time zone database under a process-wide lock, which
+ * serializes every thread converting date/times, so here the date is converted arithmetically with 'days_from_civil' and only
+ * the local UTC offset of each distinct day is obtained from 'mktime', once, and cached per thread. The cache assumes the time
+ * zone('TZ') is not changed while the process runs. The only known difference from 'mktime' is on the few historical days when a
+ * zone moved between two daylight saving offsets(e.g., British Double Summer Time), where a 'tm_isdst' of 0 is resolved heuristically by 'mktime'.
+ *
+ * @param tm The broken-down time, fields outside of their normal ranges are passed to 'mktime' to be normalized.
+ * @return Unix time as time_t, or -1 if the time cannot be represented.
+ */
+time_t convert_tm_to_unix_time(const struct tm *tm)
+{
+	// Check for NULL input and handle error.
+	if (tm == NULL){ perror("\n\nError: tm was NULL in 'convert_tm_to_unix_time'.\n");      return -1; }
+	
+	
+	/// Out of range fields need 'mktime' to normalize them.
+	if (tm->tm_mon < 0 || tm->tm_mon > 11 || tm->tm_mday < 1 || tm->tm_mday > 31 || tm->tm_hour < 0 || tm->tm_hour > 23 ||
+		tm->tm_min < 0 || tm->tm_min > 59 || tm->tm_sec < 0 || tm->tm_sec > 60 || tm->tm_isdst > 0)
+	{
+		struct tm copy = *tm;
+		return mktime(&copy);
+	}
+	
+	
+	int64_t day = days_from_civil((int64_t)tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
+	int64_t localSeconds = day * 86400 + tm->tm_hour * 3600 + tm->tm_min * 60 + tm->tm_sec;
+	
+	
+	/// Look the day's UTC offset up in a small direct-mapped per-thread cache, asking 'mktime' on a miss. A day during which the
+	/// offset changes(a historical change of a zone's standard time) is marked as such and always converted by 'mktime'.
+	static _Thread_local struct { int64_t day; int64_t utcOffset; bool valid; bool uniform; } offsetCache[64];
+	unsigned slot = (unsigned)((uint64_t)day & 63);
+	if (!offsetCache[slot].valid || offsetCache[slot].day != day)
+	{
+		struct tm startOfDay, endOfDay;
+		set_memory_block(&startOfDay, 0, sizeof(struct tm));
+		startOfDay.tm_year = tm->tm_year;
+		startOfDay.tm_mon = tm->tm_mon;
+		startOfDay.tm_mday = tm->tm_mday;
+		startOfDay.tm_isdst = tm->tm_isdst;
+		endOfDay = startOfDay;
+		endOfDay.tm_hour = 23;
+		endOfDay.tm_min = 59;
+		endOfDay.tm_sec = 59;
+		time_t startUnixTime = mktime(&startOfDay);
+		time_t endUnixTime = mktime(&endOfDay);
+		
+		offsetCache[slot].day = day;
+		offsetCache[slot].utcOffset = day * 86400 - (int64_t)startUnixTime;
+		offsetCache[slot].uniform = (startUnixTime != -1 && endUnixTime != -1 && (int64_t)endUnixTime - (int64_t)startUnixTime == 86399);
+		offsetCache[slot].valid = true;
+	}
+	
+	if (!offsetCache[slot].uniform)
+	{
+		struct tm copy = *tm;
+		return mktime(&copy);
+	}
+	return (time_t)(localSeconds - offsetCache[slot].utcOffset);
+}
+
+
+
+
+/**
+ * convert_to_unix_time
+ *
+ * Converts a date/time string into Unix time(the number of seconds since the Unix Epoch, January 1, 1970).
+ * It attempts to parse the string using various common date/time formats and returns the Unix time if successful.
+ * The purpose of this function is to help in standardizing data set file contents.
+ *
+ * @param dateTimeString A pointer to the string containing date/time information.
+ * @return Unix time as time_t. Returns -1 if conversion fails.
+ */
+time_t convert_to_unix_time(const char *dateTimeString)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_CONVERT_TO_UNIX_TIME);
+	struct tm tm; // Structure to hold the broken-down time.
+	char *parsed;  // A pointer to track where the parsing of the date/time string ended.
+	time_t unixTime = -1;
+	
+	
+	// Iterate through each date/time format specified in commonDateTimeFormats.
+	for (int i = 0; i < 12; ++i)
+	{
+		set_memory_block(&tm, 0, sizeof(struct tm)); // Reset the tm structure for each iteration.
+		
 		// Parse the input string according to these formats.
 		parsed = strptime(dateTimeString, commonDateTimeFormats[i], &tm);
 		
 		
-		// Check if parsing was successful and the entire string was consumed.
-		if (parsed != NULL && *parsed == '\0')
+		// Check if parsing was successful and the entire string was consumed.
+		if (parsed != NULL && *parsed == '\0')
+		{
+			// Convert the parsed time (tm structure) to Unix time.
+			unixTime = convert_tm_to_unix_time(&tm);
+			
+			// If conversion is successful (unixTime is not -1), break out of the loop.
+			if (unixTime != -1)
+			{
+				break;
+			}
+		}
+	}
+	
+	// Return the resulting Unix time, or -1 if none of the formats matched.
+	return unixTime;
+}
+
+
+static pthread_mutex_t localtime_mutex = PTHREAD_MUTEX_INITIALIZER; //Mutex for Thread Safety protecting access to localtime
+
+
+/**
+ * thread_safe_localtime
+ *
+ * Converts time_t to tm as Local Time in a thread-safe manner.
+ * Uses mutexes to ensure thread safety during the conversion.
+ *
+ * @param tim The time_t structure to convert.
+ * @param result A pointer to the struct tm where the result will be stored.
+ * @return A pointer to the result if successful, NULL otherwise.
+ */
+struct tm *thread_safe_localtime(const time_t *tim, struct tm *result)
+{
+	struct tm *t = NULL;
+	
+	// Ensure 'result' is a non-null pointer
+	if (result == NULL)
+	{
+		return NULL;
+	}
+	
+	
+	pthread_mutex_lock(&localtime_mutex);
+	t = localtime(tim);
+	if (t)
+	{
+		*result = *t;  // Copy the statically allocated struct
+	}
+	pthread_mutex_unlock(&localtime_mutex);
+	
+	pthread_mutex_destroy(&localtime_mutex);
+	
+	
+	return t ? result : NULL; // Return result if localtime didn't return NULL
+}
+
+
+
+
+
+
+
+
+/**
+ * flip_sign_bit
+ *
+ * Flip the Sign Bit of a 64-bit Integer.
+ * Flips(toggles) the sign bit(Most Significant Bit) of a 64-bit integer, effectively changing the sign of a floating-point number
+ * represented in its binary form(specifically IEEE 754 representation for doubles). This function is particularly
+ * useful in scenarios involving floating-point numbers where the sign needs to be altered while preserving the
+ * magnitude and exponent parts of the floating-point representation.
+ *
+ * @param value The 64-bit unsigned integer whose sign bit is to be flipped.
+ * @return The 64-bit unsigned integer with its sign bit flipped.
+ */
+uint64_t flip_sign_bit(uint64_t value)
+{
+	// '1ull << 63' creates a 64-bit integer with only the MSB set to 1 (i.e., the 63rd bit in zero-indexed notation).
+	
+	// 'value ^ ...' applies the bitwise XOR operation between the input 'value' and the above-created integer.
+	//   XOR with '1' toggles the corresponding bit, so if the sign bit in 'value' is 0 (positive number), it becomes 1 (negative number),
+	//   and vice versa, hence this operation flips the sign bit of the input 'value'.
+	return value ^ (1ull << 63);
+}
+
+
+/**
+ * double_to_uint64
+ *
+ * This function reinterprets a double value as a 64-bit unsigned integer (uint64_t) by directly copying its binary representation.
+ * This method of type-punning allows the bit pattern of a double to be reinterpreted as a uint64_t without any conversion,
+ * facilitating direct manipulation of a double's binary representation for bit-level operations, useful in certain algorithms like
+ * sorting or encoding, where floating-point operations are not required.
+ *
+ * @param value The double value to be reinterpreted as a uint64_t.
+ * @return The binary representation of the input double as a uint64_t.
+ */
+uint64_t double_to_uint64(double value)
+{
+	uint64_t result;
+	
+	// Copies the binary representation of 'value' into 'result', 'sizeof(double)' ensures that exactly 8 bytes (size of a double) are copied.
+	copy_memory_block(&result, &value, sizeof(double));
+	return result;
+}
+
+/**
+ * uint64_to_double
+ *
+ * This function reinterprets a 64-bit unsigned integer (uint64_t) as a double by copying its binary representation.
+ * It is the inverse operation of double_to_uint64, allowing for the conversion of a manipulated uint64_t representation
+ * back to a double. Allows for conversion of a uint64_t value back to a double after performing bit-level manipulations, enabling the use
+ *  or interpretation of the result as a floating-point number.
+ *
+ * @param value The 64-bit unsigned integer to be reinterpreted as a double.
+ * @return The binary representation of the input uint64_t as a double.
+ */
+double uint64_to_double(uint64_t value)
+{
+	double result;
+	
+	// Copies the binary representation of 'value' into 'result', sizeof(uint64_t)' ensures that exactly 8 bytes (size of a uint64_t) are copied.
+	copy_memory_block(&result, &value, sizeof(uint64_t));
+	return result;
+}
+
+
+/**
+ * double_to_sortable_key
+ *
+ * Maps a double to a 64-bit key whose unsigned integer order is the numeric order of the doubles, for radix sorting. The bits of
+ * a negative value are all inverted(a larger magnitude must give a smaller key), while a positive value only gets its sign bit set,
+ * placing it above every negative one. This is the IEEE 754 total order with one exception: a NaN has its sign bit cleared first,
+ * so every NaN sorts after +infinity. -0.0 sorts just before +0.0.
+ *
+ * @param value The double to map.
+ * @return The sortable key.
+ */
+uint64_t double_to_sortable_key(double value)
+{
+	union { double value; uint64_t bits; } pun = { value };
+	uint64_t bits = pun.bits;
+	if (isnan(value))
+	{
+		bits &= ~(1ull << 63);
+	}
+	return (bits >> 63) ? ~bits : (bits | (1ull << 63));
+}
+
+
+/**
+ * sortable_key_to_double
+ *
+ * Inverts 'double_to_sortable_key'. A NaN comes back with its payload and the sign bit cleared.
+ *
+ * @param key The sortable key.
+ * @return The double it was made from.
+ */
+double sortable_key_to_double(uint64_t key)
+{
+	union { uint64_t bits; double value; } pun = { (key >> 63) ? (key & ~(1ull << 63)) : ~key };
+	return pun.value;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/**
+ * Merge sort
+ *
+ * The sorts below share one scratch buffer as large as the array and never allocate while sorting. Each level of the recursion
+ * merges between the array and the scratch buffer in alternating directions(ping-pong), so no level copies its runs back before
+ * merging them: a call asked for its result in the scratch buffer has its halves sorted into the array, and vice versa. Runs of up to
+ * 'MERGE_SORT_INSERTION_CUTOFF' elements are insertion sorted, and two halves that are already in order are copied instead of merged.
+ */
+
+
+/**
+ * is_sorted_run
+ *
+ * Returns true if a run is in non-decreasing order.
+ */
+static bool is_sorted_run(const double *data, size_t numElements)
+{
+	for (size_t i = 1; i < numElements; i++)
+	{
+		if (data[i] < data[i - 1])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/**
+ * insertion_sort_run
+ *
+ * Stable insertion sort of a short run.
+ */
+static void insertion_sort_run(double *data, size_t numElements)
+{
+	for (size_t i = 1; i < numElements; i++)
+	{
+		double value = data[i];
+		size_t j = i;
+		while (j > 0 && data[j - 1] > value)
+		{
+			data[j] = data[j - 1];
+			j--;
+		}
+		data[j] = value;
+	}
+}
+
+
+/**
+ * merge_runs
+ *
+ * Stable merge of two sorted runs into 'destination', which may overlap the end of the right run(as in 'merge_data') but not the left.
+ */
+static void merge_runs(const double *left, size_t leftCount, const double *right, size_t rightCount, double *destination)
+{
+	size_t i = 0, j = 0, k = 0;
+	while (i < leftCount && j < rightCount)
+	{
+		destination[k++] = (right[j] < left[i]) ? right[j++] : left[i++];
+	}
+	while (i < leftCount)
+	{
+		destination[k++] = left[i++];
+	}
+	while (j < rightCount)
+	{
+		destination[k++] = right[j++];
+	}
+}
+
+
+/**
+ * merge_sort_runs
+ *
+ * Sorts 'data', leaving the result in 'scratch' if 'toScratch' is set, or in 'data' otherwise.
+ */
+static void merge_sort_runs(double *data, double *scratch, size_t numElements, bool toScratch)
+{
+	if (numElements <= MERGE_SORT_INSERTION_CUTOFF)
+	{
+		insertion_sort_run(data, numElements);
+		if (toScratch)
+		{
+			copy_memory_block(scratch, data, numElements * sizeof(double));
+		}
+		return;
+	}
+	
+	size_t middle = numElements / 2;
+	merge_sort_runs(data, scratch, middle, !toScratch);
+	merge_sort_runs(data + middle, scratch + middle, numElements - middle, !toScratch);
+	
+	const double *source = toScratch ? data : scratch;
+	double *destination = toScratch ? scratch : data;
+	if (source[middle - 1] <= source[middle])
+	{
+		copy_memory_block(destination, source, numElements * sizeof(double)); // Already in order.
+		return;
+	}
+	merge_runs(source, middle, source + middle, numElements - middle, destination);
+}
+
+
+/**
+ * merge_data
+ *
+ * Merges two subarrays of unsortedData[].
+ * This function is a part of the merge sort algorithm. It merges two sorted subarrays
+ * defined by the indices [left, middle] and [middle+1, right] into a single sorted array.
+ * Only the first subarray is copied out, to a temporary array, and the two are merged back
+ * into the original array from the front, which never overwrites an unread element of the second.
+ * 'merge_sort' itself does not use this function, it merges between its own scratch buffer and the array.
+ *
+ * @param unsortedData Pointer to the array of doubles to be sorted.
+ * @param left The starting index of the first subarray,  unsortedData[left..middle]
+ * @param middle The ending index of the first subarray and the starting index of the second subarray minus one.
+ * @param right The ending index of the second subarray,  unsortedData[middle+1..right]
+ */
+void merge_data(double *unsortedData, int left, int middle, int right)
+{
+	if (unsortedData == NULL){ perror("\n\nError: unsortedData was NULL in 'merge_data'.\n");      return; }
+	if (left > middle || middle >= right)
+	{
+		return; // One of the subarrays is empty.
+	}
+	
+	size_t size1 = (size_t)(middle - left + 1);  // Size of the first subarray
+	double *leftTempData = (double *)utilities_malloc(size1 * sizeof(double));
+	if (leftTempData == NULL){ perror("\n\nError: Memory allocation failed in 'merge_data'.\n");      exit(1); }
+	copy_memory_block(leftTempData, unsortedData + left, size1 * sizeof(double));
+	
+	merge_runs(leftTempData, size1, unsortedData + middle + 1, (size_t)(right - middle), unsortedData + left);
+	utilities_free(leftTempData);
+}
+
+
+/**
+ * merge_sort_data
+ *
+ * Sorts the portion unsortedData[left..right] with the merge sort algorithm, using a single scratch buffer
+ * for the whole sort rather than temporary arrays for every merge(see 'merge_sort').
+ *
+ * @param unsortedData Pointer to the array of doubles to be sorted.
+ * @param left The starting index of the array portion to be sorted.
+ * @param right The ending index of the array portion to be sorted.
+ */
+void merge_sort_data(double *unsortedData, int left, int right)
+{
+	if (unsortedData == NULL){ perror("\n\nError: unsortedData was NULL in 'merge_sort_data'.\n");      return; }
+	if (left >= right)
+	{
+		return;
+	}
+	
+	size_t numElements = (size_t)(right - left + 1);
+	double *data = unsortedData + left;
+	if (is_sorted_run(data, numElements))
+	{
+		return;
+	}
+	if (numElements <= MERGE_SORT_INSERTION_CUTOFF)
+	{
+		insertion_sort_run(data, numElements);
+		return;
+	}
+	
+	double *scratch = (double *)utilities_malloc(numElements * sizeof(double));
+	if (scratch == NULL){ perror("\n\nError: Memory allocation failed in 'merge_sort_data'.\n");      exit(1); }
+	merge_sort_runs(data, scratch, numElements, false);
+	utilities_free(scratch);
+}
+
+
+/**
+ * merge_sort,  a divide and conquer algorithm, O(nLogn)
+ *
+ * This function is the entry point for the merge sort algorithm. It checks for
+ * null pointers and then calls merge_sort_data to sort the entire array.
+ * The sort is stable, allocates one scratch buffer of 'numElements' doubles, and returns
+ * after a single pass over an array that is already sorted.
+ *
+ * @param unsortedData Pointer to the array of doubles to be sorted.
+ * @param numElements The number of elements in the array.
+ */
+void merge_sort(double *unsortedData, const int numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_MERGE_SORT);
+	// Check for null pointers to ensure data integrity
+	if(unsortedData == NULL)
+	{
+		perror("\n\nError: Data to be sorted was NULL in 'merge_sort'.\n");
+		exit(1);
+	}
+	
+	
+	// Sort the entire array
+	merge_sort_data(unsortedData, 0, numElements - 1);
+}
+
+
+typedef struct MergeSortTask
+{
+	double *data;
+	double *scratch;
+	size_t numElements;
+	bool toScratch;
+	int numThreads;
+} MergeSortTask;
+
+typedef struct ParallelMergeTask
+{
+	const double *left;
+	size_t leftCount;
+	const double *right;
+	size_t rightCount;
+	double *destination;
+	int numThreads;
+} ParallelMergeTask;
+
+
+/**
+ * parallel_merge_runs
+ *
+ * 'merge_runs' on several threads: the larger run is split at its middle element, the other run at the matching position(found by
+ * binary search, with ties placed so the merge stays stable), and the two halves of the output are merged concurrently, recursively
+ * until each thread has one piece.
+ */
+static void *parallel_merge_runs(void *argument)
+{
+	ParallelMergeTask *task = (ParallelMergeTask *)argument;
+	if (task->numThreads <= 1 || task->leftCount + task->rightCount < MERGE_SORT_PARALLEL_THRESHOLD)
+	{
+		merge_runs(task->left, task->leftCount, task->right, task->rightCount, task->destination);
+		return NULL;
+	}
+	
+	
+	/// Split both runs so every element before the split points belongs before every element after them.
+	size_t leftSplit, rightSplit;
+	if (task->leftCount >= task->rightCount)
+	{
+		leftSplit = task->leftCount / 2;
+		double pivot = task->left[leftSplit];
+		size_t low = 0, high = task->rightCount; // First right element not less than the pivot, equal ones stay after it.
+		while (low < high)
+		{
+			size_t middle = low + (high - low) / 2;
+			if (task->right[middle] < pivot) low = middle + 1; else high = middle;
+		}
+		rightSplit = low;
+	}
+	else
+	{
+		rightSplit = task->rightCount / 2;
+		double pivot = task->right[rightSplit];
+		size_t low = 0, high = task->leftCount; // First left element greater than the pivot, equal ones stay before it.
+		while (low < high)
+		{
+			size_t middle = low + (high - low) / 2;
+			if (task->left[middle] <= pivot) low = middle + 1; else high = middle;
+		}
+		leftSplit = low;
+	}
+	
+	int firstThreads = task->numThreads / 2;
+	ParallelMergeTask first = { task->left, leftSplit, task->right, rightSplit, task->destination, firstThreads };
+	ParallelMergeTask second = { task->left + leftSplit, task->leftCount - leftSplit, task->right + rightSplit, task->rightCount - rightSplit,
+								 task->destination + leftSplit + rightSplit, task->numThreads - firstThreads };
+	pthread_t thread;
+	bool threadStarted = (pthread_create(&thread, NULL, parallel_merge_runs, &first) == 0);
+	if (!threadStarted)
+	{
+		parallel_merge_runs(&first); // No thread to be had, merge this half here.
+	}
+	parallel_merge_runs(&second);
+	if (threadStarted)
+	{
+		pthread_join(thread, NULL);
+	}
+	return NULL;
+}
+
+
+/**
+ * parallel_merge_sort_runs
+ *
+ * 'merge_sort_runs' on several threads: the two halves are sorted concurrently, each with half of the threads, and then merged with
+ * 'parallel_merge_runs' on all of them.
+ */
+static void *parallel_merge_sort_runs(void *argument)
+{
+	MergeSortTask *task = (MergeSortTask *)argument;
+	size_t numElements = task->numElements;
+	if (task->numThreads <= 1 || numElements < MERGE_SORT_PARALLEL_THRESHOLD)
+	{
+		merge_sort_runs(task->data, task->scratch, numElements, task->toScratch);
+		return NULL;
+	}
+	
+	size_t middle = numElements / 2;
+	int firstThreads = task->numThreads / 2;
+	MergeSortTask first = { task->data, task->scratch, middle, !task->toScratch, firstThreads };
+	MergeSortTask second = { task->data + middle, task->scratch + middle, numElements - middle, !task->toScratch, task->numThreads - firstThreads };
+	pthread_t thread;
+	bool threadStarted = (pthread_create(&thread, NULL, parallel_merge_sort_runs, &first) == 0);
+	if (!threadStarted)
+	{
+		parallel_merge_sort_runs(&first); // No thread to be had, sort this half here.
+	}
+	parallel_merge_sort_runs(&second);
+	if (threadStarted)
+	{
+		pthread_join(thread, NULL);
+	}
+	
+	const double *source = task->toScratch ? task->data : task->scratch;
+	double *destination = task->toScratch ? task->scratch : task->data;
+	if (source[middle - 1] <= source[middle])
+	{
+		copy_memory_block(destination, source, numElements * sizeof(double));
+		return NULL;
+	}
+	ParallelMergeTask merge = { source, middle, source + middle, numElements - middle, destination, task->numThreads };
+	parallel_merge_runs(&merge);
+	return NULL;
+}
+
+
+/**
+ * merge_sort_parallel
+ *
+ * Multi-threaded 'merge_sort' with the same stable result: the halves of the array are sorted concurrently down to
+ * 'MERGE_SORT_PARALLEL_THRESHOLD' elements or one thread each, and every merge above that is itself split across the threads.
+ *
+ * @param unsortedData Pointer to the array of doubles to be sorted.
+ * @param numElements The number of elements in the array.
+ * @param numThreads The number of threads, or a value <= 0 for one per online processor.
+ */
+void merge_sort_parallel(double *unsortedData, const int numElements, int numThreads)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_MERGE_SORT_PARALLEL);
+	// Check for null pointers to ensure data integrity
+	if (unsortedData == NULL)
+	{
+		perror("\n\nError: Data to be sorted was NULL in 'merge_sort_parallel'.\n");
+		exit(1);
+	}
+	
+	numThreads = resolve_thread_count(numThreads);
+	if (numThreads <= 1 || numElements < (int)MERGE_SORT_PARALLEL_THRESHOLD)
+	{
+		merge_sort_data(unsortedData, 0, numElements - 1);
+		return;
+	}
+	if (is_sorted_run(unsortedData, (size_t)numElements))
+	{
+		return;
+	}
+	
+	double *scratch = (double *)utilities_malloc((size_t)numElements * sizeof(double));
+	if (scratch == NULL){ perror("\n\nError: Memory allocation failed in 'merge_sort_parallel'.\n");      exit(1); }
+	MergeSortTask task = { unsortedData, scratch, (size_t)numElements, false, numThreads };
+	parallel_merge_sort_runs(&task);
+	utilities_free(scratch);
+}
+
+
+
+
+
+/**
+ * Radix sort of doubles
+ *
+ * Each double is mapped to an unsigned 64-bit key whose integer order is the numeric order('double_to_sortable_key'). The keys are
+ * sorted least significant digit first: one read of the input converts every value and builds the histograms of all digits at
+ * once, a digit that is the same for every key(e.g., the top exponent bits of data in a narrow range) is skipped, and the passes
+ * scatter between two buffers in turn, the last one converting the keys back to doubles straight into the caller's array.
+ */
+
+
+/**
+ * radix_sort_double_keys
+ *
+ * Sorts an array of doubles with digits of 'digitBits' bits, which the callers pass as a constant so the histogram loop unrolls.
+ */
+static inline void radix_sort_double_keys(double *unsortedData, size_t numElements, const int digitBits)
+{
+	const int numPasses = (64 + digitBits - 1) / digitBits;
+	const size_t radix = (size_t)1 << digitBits;
+	const uint64_t digitMask = radix - 1;
+	if (numElements < 2)
+	{
+		return;
+	}
+	
+	uint64_t *keys = (uint64_t *)utilities_malloc(numElements * sizeof(uint64_t));
+	uint64_t *buffer = (uint64_t *)utilities_malloc(numElements * sizeof(uint64_t));
+	size_t *histograms = (size_t *)utilities_calloc((size_t)numPasses * radix, sizeof(size_t));
+	if (keys == NULL || buffer == NULL || histograms == NULL){ perror("\n\nError: Memory allocation failed in 'radix_sort_doubles'.\n");      exit(1); }
+	
+	
+	/// Convert every value to its key and count the digits of every pass in the same read.
+	for (size_t i = 0; i < numElements; i++)
+	{
+		uint64_t key = double_to_sortable_key(unsortedData[i]);
+		keys[i] = key;
+		for (int pass = 0; pass < numPasses; pass++)
+		{
+			histograms[pass * radix + ((key >> (pass * digitBits)) & digitMask)]++;
+		}
+	}
+	
+	
+	/// Keep the passes whose digit varies, a digit shared by every key leaves the order unchanged.
+	int activePasses[64];
+	int numActivePasses = 0;
+	for (int pass = 0; pass < numPasses; pass++)
+	{
+		if (histograms[pass * radix + ((keys[0] >> (pass * digitBits)) & digitMask)] != numElements)
+		{
+			activePasses[numActivePasses++] = pass;
+		}
+	}
+	
+	
+	/// Scatter by each remaining digit, ping-ponging between the two buffers.
+	uint64_t *source = keys;
+	uint64_t *destination = buffer;
+	for (int p = 0; p < numActivePasses; p++)
+	{
+		int shift = activePasses[p] * digitBits;
+		size_t *offsets = histograms + activePasses[p] * radix;
+		size_t offset = 0;
+		for (size_t digit = 0; digit < radix; digit++)
+		{
+			size_t count = offsets[digit];
+			offsets[digit] = offset;
+			offset += count;
+		}
+		
+		if (p == numActivePasses - 1)
+		{
+			for (size_t i = 0; i < numElements; i++)
+			{
+				unsortedData[offsets[(source[i] >> shift) & digitMask]++] = sortable_key_to_double(source[i]);
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < numElements; i++)
+			{
+				destination[offsets[(source[i] >> shift) & digitMask]++] = source[i];
+			}
+			uint64_t *swap = source;
+			source = destination;
+			destination = swap;
+		}
+	}
+	/// With no active pass every key is equal and the array is already in order.
+	
+	utilities_free(keys);
+	utilities_free(buffer);
+	utilities_free(histograms);
+}
+
+
+/**
+ * radix_sort_doubles
+ *
+ * Sorts an array of double precision floating-point numbers using Radix Sort algorithm. This implementation
+ * specifically deals with the floating-point nature of the data by converting doubles to 64-bit integer
+ * keys that sort in the same order(see 'double_to_sortable_key'). The sorting is performed on these keys
+ * eight bits at a time, in at most 8 passes, and is stable.
+ *
+ * Ordering of special values: -0.0 sorts before +0.0, infinities sort at the ends, and every NaN sorts after
+ * +infinity. NaNs keep their payload but come back positive.
+ *
+ * This function is particularly useful in scenarios where a fast, stable sorting of a large number of floating-point numbers( > 60) is required.
+ *
+ * @param unsortedData A pointer to the array of double values to be sorted.
+ * @param numElements The number of elements in the array.
+ */
+void radix_sort_doubles(double *unsortedData, const int numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_DOUBLES);
+	if (unsortedData == NULL){ perror("\n\nError: Data to be sorted was NULL in 'radix_sort_doubles'.\n");      exit(1); }
+	
+	radix_sort_double_keys(unsortedData, (numElements > 0) ? (size_t)numElements : 0, 8);
+}
+
+
+/**
+ * radix_sort_doubles_11bit
+ *
+ * 'radix_sort_doubles' with 11-bit digits: 6 passes instead of 8, at the cost of 2048-entry histograms, which still fit in the
+ * L1 cache. The ordering of special values is the same. Usually the faster choice for large arrays.
+ *
+ * @param unsortedData A pointer to the array of double values to be sorted.
+ * @param numElements The number of elements in the array.
+ */
+void radix_sort_doubles_11bit(double *unsortedData, const int numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_DOUBLES_11BIT);
+	if (unsortedData == NULL){ perror("\n\nError: Data to be sorted was NULL in 'radix_sort_doubles_11bit'.\n");      exit(1); }
+	
+	radix_sort_double_keys(unsortedData, (numElements > 0) ? (size_t)numElements : 0, 11);
+}
+
+
+/**
+ * Parallel radix sort of doubles
+ *
+ * Every thread owns a contiguous chunk of the current source buffer. For each pass whose digit varies it counts the digits of its
+ * chunk, then, after all threads have counted, derives where its elements of each digit go: after every element of a smaller digit,
+ * and after the elements of the same digit in the chunks of lower-numbered threads, which keeps the sort stable. The scatter writes
+ * through per-thread write-combining buffers, one cache-aligned 64-byte line per digit, so elements reach the destination a whole
+ * cache line at a time rather than as 256 interleaved single stores, cutting cache and TLB misses. A digit's first flush only fills
+ * up to the next line boundary of the destination, so every later flush covers exactly one destination cache line. Threads meet at
+ * a barrier between the phases.
+ */
+#define RADIX_WRITE_COMBINE_LINE 64 // Bytes per write-combining line, one cache line.
+#define RADIX_WRITE_COMBINE_KEYS (RADIX_WRITE_COMBINE_LINE / 8) // Keys per write-combining line.
+
+typedef struct SortBarrier
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t condition;
+	int numThreads;
+	int waiting;
+	unsigned long generation;
+} SortBarrier;
+
+typedef struct ParallelRadixSort
+{
+	double *unsortedData; // Read for the keys, written by the last pass.
+	uint64_t *keys;
+	uint64_t *buffer;
+	size_t numElements;
+	int numThreads;
+	size_t *digitHistograms; // Per thread, the histograms of all 8 digits, from the first read.
+	size_t *passHistograms; // Per thread, the histogram of the current pass's digit.
+	int activePasses[8];
+	int numActivePasses;
+	SortBarrier barrier;
+} ParallelRadixSort;
+
+typedef struct ParallelRadixSortWorker
+{
+	ParallelRadixSort *sort;
+	int index;
+} ParallelRadixSortWorker;
+
+
+/**
+ * sort_barrier_wait
+ *
+ * Blocks until every thread of the sort has arrived(a portable stand-in for 'pthread_barrier_wait', which macOS lacks).
+ */
+static void sort_barrier_wait(SortBarrier *barrier)
+{
+	pthread_mutex_lock(&barrier->mutex);
+	unsigned long generation = barrier->generation;
+	if (++barrier->waiting == barrier->numThreads)
+	{
+		barrier->waiting = 0;
+		barrier->generation++;
+		pthread_cond_broadcast(&barrier->condition);
+	}
+	else
+	{
+		while (generation == barrier->generation)
+		{
+			pthread_cond_wait(&barrier->condition, &barrier->mutex);
+		}
+	}
+	pthread_mutex_unlock(&barrier->mutex);
+}
+
+
+/**
+ * radix_chunk_bounds
+ *
+ * The range of elements a thread owns in every pass.
+ */
+static inline void radix_chunk_bounds(const ParallelRadixSort *sort, int index, size_t *begin, size_t *end)
+{
+	*begin = sort->numElements / sort->numThreads * index;
+	*end = (index == sort->numThreads - 1) ? sort->numElements : sort->numElements / sort->numThreads * (index + 1);
+}
+
+
+/**
+ * parallel_radix_count_worker
+ *
+ * Converts a thread's chunk to keys and counts all of its digits.
+ */
+static void *parallel_radix_count_worker(void *argument)
+{
+	ParallelRadixSortWorker *worker = (ParallelRadixSortWorker *)argument;
+	ParallelRadixSort *sort = worker->sort;
+	size_t begin, end;
+	radix_chunk_bounds(sort, worker->index, &begin, &end);
+	size_t *histograms = sort->digitHistograms + (size_t)worker->index * 8 * 256;
+	
+	for (size_t i = begin; i < end; i++)
+	{
+		uint64_t key = double_to_sortable_key(sort->unsortedData[i]);
+		sort->keys[i] = key;
+		for (int pass = 0; pass < 8; pass++)
+		{
+			histograms[pass * 256 + ((key >> (pass * 8)) & 0xFF)]++;
+		}
+	}
+	return NULL;
+}
+
+
+/**
+ * parallel_radix_flush_line
+ *
+ * Writes a write-combining line to its destination, as keys or, in the last pass, as doubles.
+ */
+static inline void parallel_radix_flush_line(const uint64_t *line, int count, size_t position, uint64_t *destination, double *output)
+{
+	if (output != NULL)
+	{
+		for (int k = 0; k < count; k++)
+		{
+			output[position + k] = sortable_key_to_double(line[k]);
+		}
+	}
+	else
+	{
+		for (int k = 0; k < count; k++)
+		{
+			destination[position + k] = line[k];
+		}
+	}
+}
+
+
+/**
+ * radix_keys_to_line_boundary
+ *
+ * Returns the number of 8-byte elements from 'position' of 'base' to the next cache line boundary, a whole line if it is on one.
+ */
+static inline int radix_keys_to_line_boundary(const void *base, size_t position)
+{
+	size_t misalignment = (uintptr_t)((const uint64_t *)base + position) % RADIX_WRITE_COMBINE_LINE;
+	return (misalignment == 0) ? RADIX_WRITE_COMBINE_KEYS : (int)((RADIX_WRITE_COMBINE_LINE - misalignment) / 8);
+}
+
+
+/**
+ * parallel_radix_pass_worker
+ *
+ * Runs a thread's share of every active pass: count, wait, scatter through the write-combining buffers, wait.
+ */
+static void *parallel_radix_pass_worker(void *argument)
+{
+	ParallelRadixSortWorker *worker = (ParallelRadixSortWorker *)argument;
+	ParallelRadixSort *sort = worker->sort;
+	size_t begin, end;
+	radix_chunk_bounds(sort, worker->index, &begin, &end);
+	size_t *histogram = sort->passHistograms + (size_t)worker->index * 256;
+	
+	// The lines are cache-line aligned by hand, 'utilities_malloc' only guarantees the alignment of 'malloc'.
+	char *linesBlock = (char *)utilities_malloc(256 * RADIX_WRITE_COMBINE_LINE + RADIX_WRITE_COMBINE_LINE - 1);
+	if (linesBlock == NULL){ perror("\n\nError: Memory allocation failed in 'radix_sort_doubles_parallel'.\n");      exit(1); }
+	uint64_t (*lines)[RADIX_WRITE_COMBINE_KEYS] = (uint64_t (*)[RADIX_WRITE_COMBINE_KEYS])(((uintptr_t)linesBlock + RADIX_WRITE_COMBINE_LINE - 1) & ~((uintptr_t)RADIX_WRITE_COMBINE_LINE - 1));
+	int fill[256];
+	int limit[256]; // Keys of each digit to buffer before its next flush, fewer than a line only up to the first destination line boundary.
+	size_t offsets[256];
+	
+	uint64_t *source = sort->keys;
+	uint64_t *destination = sort->buffer;
+	for (int p = 0; p < sort->numActivePasses; p++)
+	{
+		int shift = sort->activePasses[p] * 8;
+		double *output = (p == sort->numActivePasses - 1) ? sort->unsortedData : NULL;
+		const void *target = (output != NULL) ? (const void *)output : (const void *)destination;
+		
+		
+		/// Count this chunk's digits and wait for the other threads'.
+		set_memory_block(histogram, 0, 256 * sizeof(size_t));
+		for (size_t i = begin; i < end; i++)
+		{
+			histogram[(source[i] >> shift) & 0xFF]++;
+		}
+		sort_barrier_wait(&sort->barrier);
+		
+		
+		/// This thread's elements of a digit follow all smaller digits and the same digit of lower-numbered threads.
+		size_t position = 0;
+		for (int digit = 0; digit < 256; digit++)
+		{
+			for (int t = 0; t < sort->numThreads; t++)
+			{
+				if (t == worker->index)
+				{
+					offsets[digit] = position;
+				}
+				position += sort->passHistograms[(size_t)t * 256 + digit];
+			}
+			fill[digit] = 0;
+			limit[digit] = radix_keys_to_line_boundary(target, offsets[digit]);
+		}
+		
+		
+		/// Scatter, a cache line per digit at a time.
+		for (size_t i = begin; i < end; i++)
+		{
+			uint64_t key = source[i];
+			int digit = (int)((key >> shift) & 0xFF);
+			lines[digit][fill[digit]++] = key;
+			if (fill[digit] == limit[digit])
+			{
+				parallel_radix_flush_line(lines[digit], limit[digit], offsets[digit], destination, output);
+				offsets[digit] += limit[digit];
+				fill[digit] = 0;
+				limit[digit] = RADIX_WRITE_COMBINE_KEYS;
+			}
+		}
+		for (int digit = 0; digit < 256; digit++)
+		{
+			parallel_radix_flush_line(lines[digit], fill[digit], offsets[digit], destination, output);
+		}
+		sort_barrier_wait(&sort->barrier); // The next pass reads what every thread wrote.
+		
+		uint64_t *swap = source;
+		source = destination;
+		destination = swap;
+	}
+	
+	utilities_free(linesBlock);
+	return NULL;
+}
+
+
+/**
+ * run_parallel_radix_workers
+ *
+ * Runs a worker function on every thread of the sort, the calling thread being thread 0.
+ */
+static void run_parallel_radix_workers(ParallelRadixSort *sort, void *(*function)(void *))
+{
+	pthread_t *threads = (pthread_t *)utilities_malloc(sort->numThreads * sizeof(pthread_t));
+	ParallelRadixSortWorker *workers = (ParallelRadixSortWorker *)utilities_malloc(sort->numThreads * sizeof(ParallelRadixSortWorker));
+	if (threads == NULL || workers == NULL){ perror("\n\nError: Memory allocation failed in 'radix_sort_doubles_parallel'.\n");      exit(1); }
+	
+	for (int t = 0; t < sort->numThreads; t++)
+	{
+		workers[t].sort = sort;
+		workers[t].index = t;
+		if (t > 0 && pthread_create(&threads[t], NULL, function, &workers[t]) != 0)
+		{
+			perror("\n\nError: Unable to create thread in 'radix_sort_doubles_parallel'.\n");
+			exit(1);
+		}
+	}
+	function(&workers[0]);
+	for (int t = 1; t < sort->numThreads; t++)
+	{
+		pthread_join(threads[t], NULL);
+	}
+	
+	utilities_free(threads);
+	utilities_free(workers);
+}
+
+
+/**
+ * radix_sort_doubles_parallel
+ *
+ * Multi-threaded 'radix_sort_doubles' with the same stable result and ordering of special values. Arrays shorter than
+ * 'RADIX_SORT_PARALLEL_THRESHOLD' are sorted by 'radix_sort_doubles', and no thread gets fewer than 'RADIX_SORT_MIN_ELEMENTS_PER_THREAD'
+ * elements. As in the serial sort, digits that are the same for every value are skipped.
+ *
+ * @param unsortedData A pointer to the array of double values to be sorted.
+ * @param numElements The number of elements in the array.
+ * @param numThreads The number of threads, or a value <= 0 for one per online processor.
+ */
+void radix_sort_doubles_parallel(double *unsortedData, const int numElements, int numThreads)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_DOUBLES_PARALLEL);
+	if (unsortedData == NULL){ perror("\n\nError: Data to be sorted was NULL in 'radix_sort_doubles_parallel'.\n");      exit(1); }
+	
+	numThreads = resolve_thread_count(numThreads);
+	size_t count = (numElements > 0) ? (size_t)numElements : 0;
+	if ((size_t)numThreads > count / RADIX_SORT_MIN_ELEMENTS_PER_THREAD)
+	{
+		numThreads = (int)(count / RADIX_SORT_MIN_ELEMENTS_PER_THREAD);
+	}
+	if (count < RADIX_SORT_PARALLEL_THRESHOLD || numThreads <= 1)
+	{
+		radix_sort_doubles(unsortedData, numElements);
+		return;
+	}
+	
+	ParallelRadixSort sort;
+	sort.unsortedData = unsortedData;
+	sort.numElements = count;
+	sort.numThreads = numThreads;
+	sort.keys = (uint64_t *)utilities_malloc(count * sizeof(uint64_t));
+	sort.buffer = (uint64_t *)utilities_malloc(count * sizeof(uint64_t));
+	sort.digitHistograms = (size_t *)utilities_calloc((size_t)numThreads * 8 * 256, sizeof(size_t));
+	sort.passHistograms = (size_t *)utilities_malloc((size_t)numThreads * 256 * sizeof(size_t));
+	if (sort.keys == NULL || sort.buffer == NULL || sort.digitHistograms == NULL || sort.passHistograms == NULL)
+	{
+		perror("\n\nError: Memory allocation failed in 'radix_sort_doubles_parallel'.\n");
+		exit(1);
+	}
+	
+	
+	/// Convert and count every digit in one read, then keep the passes whose digit varies.
+	run_parallel_radix_workers(&sort, parallel_radix_count_worker);
+	sort.numActivePasses = 0;
+	for (int pass = 0; pass < 8; pass++)
+	{
+		size_t firstDigitCount = 0;
+		int firstDigit = (int)((sort.keys[0] >> (pass * 8)) & 0xFF);
+		for (int t = 0; t < numThreads; t++)
+		{
+			firstDigitCount += sort.digitHistograms[((size_t)t * 8 + pass) * 256 + firstDigit];
+		}
+		if (firstDigitCount != count)
+		{
+			sort.activePasses[sort.numActivePasses++] = pass;
+		}
+	}
+	
+	
+	/// Run the passes.
+	pthread_mutex_init(&sort.barrier.mutex, NULL);
+	pthread_cond_init(&sort.barrier.condition, NULL);
+	sort.barrier.numThreads = numThreads;
+	sort.barrier.waiting = 0;
+	sort.barrier.generation = 0;
+	run_parallel_radix_workers(&sort, parallel_radix_pass_worker);
+	pthread_mutex_destroy(&sort.barrier.mutex);
+	pthread_cond_destroy(&sort.barrier.condition);
+	
+	utilities_free(sort.keys);
+	utilities_free(sort.buffer);
+	utilities_free(sort.digitHistograms);
+	utilities_free(sort.passHistograms);
+}
+
+
+/**
+ * Key-value radix sort
+ *
+ * The keys are mapped to order-preserving unsigned 64-bit keys('double_to_sortable_key', or the sign bit flipped for an int64_t),
+ * and sorted with 11-bit digits while every move of a key moves its payload along, which keeps the association with the row it
+ * came from. As in 'radix_sort_doubles', one read builds all the histograms, constant digits are skipped, and the passes ping-pong
+ * between the caller's arrays and one buffer for each. The sort is stable, so an argsort lists equal keys in their original order.
+ */
+#define KEY_VALUE_DIGIT_BITS 11
+#define KEY_VALUE_PASSES ((64 + KEY_VALUE_DIGIT_BITS - 1) / KEY_VALUE_DIGIT_BITS)
+#define KEY_VALUE_RADIX ((size_t)1 << KEY_VALUE_DIGIT_BITS)
+
+
+/**
+ * radix_sort_keys_with_payloads
+ *
+ * Sorts 'keys' with 'payloads' of 'payloadSize'(4 or 8, a constant at every call so the moves specialize) bytes each in tandem.
+ */
+static inline void radix_sort_keys_with_payloads(uint64_t *keys, void *payloads, const size_t payloadSize, size_t numElements)
+{
+	const uint64_t digitMask = KEY_VALUE_RADIX - 1;
+	if (numElements < 2)
+	{
+		return;
+	}
+	
+	uint64_t *keyBuffer = (uint64_t *)utilities_malloc(numElements * sizeof(uint64_t));
+	void *payloadBuffer = utilities_malloc(numElements * payloadSize);
+	size_t *histograms = (size_t *)utilities_calloc(KEY_VALUE_PASSES * KEY_VALUE_RADIX, sizeof(size_t));
+	if (keyBuffer == NULL || payloadBuffer == NULL || histograms == NULL)
+	{
+		perror("\n\nError: Memory allocation failed in 'radix_sort_key_value'.\n");
+		exit(1);
+	}
+	
+	for (size_t i = 0; i < numElements; i++)
+	{
+		for (int pass = 0; pass < KEY_VALUE_PASSES; pass++)
+		{
+			histograms[pass * KEY_VALUE_RADIX + ((keys[i] >> (pass * KEY_VALUE_DIGIT_BITS)) & digitMask)]++;
+		}
+	}
+	
+	uint64_t *sourceKeys = keys, *destinationKeys = keyBuffer;
+	void *sourcePayloads = payloads, *destinationPayloads = payloadBuffer;
+	for (int pass = 0; pass < KEY_VALUE_PASSES; pass++)
+	{
+		int shift = pass * KEY_VALUE_DIGIT_BITS;
+		size_t *offsets = histograms + pass * KEY_VALUE_RADIX;
+		if (offsets[(keys[0] >> shift) & digitMask] == numElements)
+		{
+			continue; // Every key has the same digit.
+		}
+		
+		size_t offset = 0;
+		for (size_t digit = 0; digit < KEY_VALUE_RADIX; digit++)
+		{
+			size_t count = offsets[digit];
+			offsets[digit] = offset;
+			offset += count;
+		}
+		
+		if (payloadSize == sizeof(uint32_t))
+		{
+			const uint32_t *from = (const uint32_t *)sourcePayloads;
+			uint32_t *to = (uint32_t *)destinationPayloads;
+			for (size_t i = 0; i < numElements; i++)
+			{
+				size_t position = offsets[(sourceKeys[i] >> shift) & digitMask]++;
+				destinationKeys[position] = sourceKeys[i];
+				to[position] = from[i];
+			}
+		}
+		else
+		{
+			const uint64_t *from = (const uint64_t *)sourcePayloads;
+			uint64_t *to = (uint64_t *)destinationPayloads;
+			for (size_t i = 0; i < numElements; i++)
+			{
+				size_t position = offsets[(sourceKeys[i] >> shift) & digitMask]++;
+				destinationKeys[position] = sourceKeys[i];
+				to[position] = from[i];
+			}
+		}
+		
+		uint64_t *swapKeys = sourceKeys;
+		sourceKeys = destinationKeys;
+		destinationKeys = swapKeys;
+		void *swapPayloads = sourcePayloads;
+		sourcePayloads = destinationPayloads;
+		destinationPayloads = swapPayloads;
+	}
+	
+	
+	/// After an odd number of passes the result is in the buffers.
+	if (sourceKeys != keys)
+	{
+		copy_memory_block(keys, sourceKeys, numElements * sizeof(uint64_t));
+		copy_memory_block(payloads, sourcePayloads, numElements * payloadSize);
+	}
+	
+	utilities_free(keyBuffer);
+	utilities_free(payloadBuffer);
+	utilities_free(histograms);
+}
+
+
+/**
+ * radix_sort_key_value_doubles
+ *
+ * Shared body of the key-value sorts with double keys.
+ */
+static inline void radix_sort_key_value_doubles(double *keys, void *payloads, const size_t payloadSize, size_t numElements)
+{
+	if ((keys == NULL || payloads == NULL) && numElements > 0)
+	{
+		perror("\n\nError: keys or payloads was NULL in 'radix_sort_key_value'.\n");
+		exit(1);
+	}
+	if (numElements == 0)
+	{
+		return;
+	}
+	
+	uint64_t *sortableKeys = (uint64_t *)utilities_malloc(numElements * sizeof(uint64_t));
+	if (sortableKeys == NULL){ perror("\n\nError: Memory allocation failed in 'radix_sort_key_value'.\n");      exit(1); }
+	for (size_t i = 0; i < numElements; i++)
+	{
+		sortableKeys[i] = double_to_sortable_key(keys[i]);
+	}
+	radix_sort_keys_with_payloads(sortableKeys, payloads, payloadSize, numElements);
+	for (size_t i = 0; i < numElements; i++)
+	{
+		keys[i] = sortable_key_to_double(sortableKeys[i]);
+	}
+	utilities_free(sortableKeys);
+}
+
+
+/**
+ * radix_sort_key_value_int64s
+ *
+ * Shared body of the key-value sorts with int64_t keys, flipping the sign bit puts the negative keys first.
+ */
+static inline void radix_sort_key_value_int64s(int64_t *keys, void *payloads, const size_t payloadSize, size_t numElements)
+{
+	if ((keys == NULL || payloads == NULL) && numElements > 0)
+	{
+		perror("\n\nError: keys or payloads was NULL in 'radix_sort_key_value'.\n");
+		exit(1);
+	}
+	if (numElements == 0)
+	{
+		return;
+	}
+	
+	uint64_t *sortableKeys = (uint64_t *)utilities_malloc(numElements * sizeof(uint64_t));
+	if (sortableKeys == NULL){ perror("\n\nError: Memory allocation failed in 'radix_sort_key_value'.\n");      exit(1); }
+	for (size_t i = 0; i < numElements; i++)
+	{
+		sortableKeys[i] = flip_sign_bit((uint64_t)keys[i]);
+	}
+	radix_sort_keys_with_payloads(sortableKeys, payloads, payloadSize, numElements);
+	for (size_t i = 0; i < numElements; i++)
+	{
+		keys[i] = (int64_t)flip_sign_bit(sortableKeys[i]);
+	}
+	utilities_free(sortableKeys);
+}
+
+
+/**
+ * radix_sort_key_value_double_u32
+ *
+ * Stable radix sort of double keys, moving a 32-bit payload(e.g., a row index) with each key. Special values are ordered as in
+ * 'radix_sort_doubles': -0.0 before +0.0 and NaNs last.
+ *
+ * @param keys The keys, sorted in place.
+ * @param payloads The payloads, permuted in place along with their keys.
+ * @param numElements The number of keys and payloads.
+ */
+void radix_sort_key_value_double_u32(double *keys, uint32_t *payloads, size_t numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_KEY_VALUE);
+	radix_sort_key_value_doubles(keys, payloads, sizeof(uint32_t), numElements);
+}
+
+
+/**
+ * radix_sort_key_value_double_u64
+ *
+ * 'radix_sort_key_value_double_u32' with 64-bit payloads(e.g., pointers or row offsets).
+ *
+ * @param keys The keys, sorted in place.
+ * @param payloads The payloads, permuted in place along with their keys.
+ * @param numElements The number of keys and payloads.
+ */
+void radix_sort_key_value_double_u64(double *keys, uint64_t *payloads, size_t numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_KEY_VALUE);
+	radix_sort_key_value_doubles(keys, payloads, sizeof(uint64_t), numElements);
+}
+
+
+/**
+ * radix_sort_key_value_int64_u32
+ *
+ * Stable radix sort of int64_t keys(e.g., Unix timestamps), moving a 32-bit payload with each key.
+ *
+ * @param keys The keys, sorted in place.
+ * @param payloads The payloads, permuted in place along with their keys.
+ * @param numElements The number of keys and payloads.
+ */
+void radix_sort_key_value_int64_u32(int64_t *keys, uint32_t *payloads, size_t numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_KEY_VALUE);
+	radix_sort_key_value_int64s(keys, payloads, sizeof(uint32_t), numElements);
+}
+
+
+/**
+ * radix_sort_key_value_int64_u64
+ *
+ * 'radix_sort_key_value_int64_u32' with 64-bit payloads.
+ *
+ * @param keys The keys, sorted in place.
+ * @param payloads The payloads, permuted in place along with their keys.
+ * @param numElements The number of keys and payloads.
+ */
+void radix_sort_key_value_int64_u64(int64_t *keys, uint64_t *payloads, size_t numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_KEY_VALUE);
+	radix_sort_key_value_int64s(keys, payloads, sizeof(uint64_t), numElements);
+}
+
+
+/**
+ * argsort_doubles
+ *
+ * Computes the permutation that sorts an array of doubles, without changing it: 'values[permutation[0]]' is the smallest value,
+ * equal values keep their original order, and NaNs come last. Apply it to the other columns of the rows with the 'gather' functions.
+ *
+ * @param values The values to sort by.
+ * @param numElements The number of values, at most UINT32_MAX.
+ * @return The permutation, to be freed with 'utilities_free', or NULL if there are too many values or none.
+ */
+uint32_t *argsort_doubles(const double *values, size_t numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_ARGSORT);
+	if (values == NULL && numElements > 0){ perror("\n\nError: values was NULL in 'argsort_doubles'.\n");      return NULL; }
+	if (numElements > UINT32_MAX){ perror("\n\nError: Too many values for 32-bit indices in 'argsort_doubles'.\n");      return NULL; }
+	if (numElements == 0)
+	{
+		return NULL; // The empty permutation.
+	}
+	
+	uint64_t *sortableKeys = (uint64_t *)utilities_malloc(numElements * sizeof(uint64_t));
+	uint32_t *permutation = (uint32_t *)utilities_malloc(numElements * sizeof(uint32_t));
+	if (sortableKeys == NULL || permutation == NULL){ perror("\n\nError: Memory allocation failed in 'argsort_doubles'.\n");      exit(1); }
+	for (size_t i = 0; i < numElements; i++)
+	{
+		sortableKeys[i] = double_to_sortable_key(values[i]);
+		permutation[i] = (uint32_t)i;
+	}
+	radix_sort_keys_with_payloads(sortableKeys, permutation, sizeof(uint32_t), numElements);
+	utilities_free(sortableKeys);
+	return permutation;
+}
+
+
+/**
+ * argsort_int64
+ *
+ * 'argsort_doubles' for int64_t values(e.g., a column of Unix timestamps).
+ *
+ * @param values The values to sort by.
+ * @param numElements The number of values, at most UINT32_MAX.
+ * @return The permutation, to be freed with 'utilities_free', or NULL if there are too many values or none.
+ */
+uint32_t *argsort_int64(const int64_t *values, size_t numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_ARGSORT);
+	if (values == NULL && numElements > 0){ perror("\n\nError: values was NULL in 'argsort_int64'.\n");      return NULL; }
+	if (numElements > UINT32_MAX){ perror("\n\nError: Too many values for 32-bit indices in 'argsort_int64'.\n");      return NULL; }
+	if (numElements == 0)
+	{
+		return NULL; // The empty permutation.
+	}
+	
+	uint64_t *sortableKeys = (uint64_t *)utilities_malloc(numElements * sizeof(uint64_t));
+	uint32_t *permutation = (uint32_t *)utilities_malloc(numElements * sizeof(uint32_t));
+	if (sortableKeys == NULL || permutation == NULL){ perror("\n\nError: Memory allocation failed in 'argsort_int64'.\n");      exit(1); }
+	for (size_t i = 0; i < numElements; i++)
+	{
+		sortableKeys[i] = flip_sign_bit((uint64_t)values[i]);
+		permutation[i] = (uint32_t)i;
+	}
+	radix_sort_keys_with_payloads(sortableKeys, permutation, sizeof(uint32_t), numElements);
+	utilities_free(sortableKeys);
+	return permutation;
+}
+
+
+/**
+ * gather_strings
+ *
+ * Applies a permutation to an array of strings: 'destination[i] = source[permutation[i]]'. Only the pointers are copied, the
+ * strings stay where they are and still belong to the source array's owner.
+ *
+ * @param destination The array to fill, which must not overlap the source.
+ * @param source The strings to reorder.
+ * @param permutation The permutation, e.g., from 'argsort_doubles'.
+ * @param numElements The number of elements of the permutation.
+ */
+void gather_strings(char **destination, char *const *source, const uint32_t *permutation, size_t numElements)
+{
+	if ((destination == NULL || source == NULL || permutation == NULL) && numElements > 0){ perror("\n\nError: NULL array in 'gather_strings'.\n");      return; }
+	
+	for (size_t i = 0; i < numElements; i++)
+	{
+		destination[i] = source[permutation[i]];
+	}
+}
+
+
+/**
+ * gather_doubles
+ *
+ * Applies a permutation to a column of doubles: 'destination[i] = source[permutation[i]]'.
+ *
+ * @param destination The array to fill, which must not overlap the source.
+ * @param source The values to reorder.
+ * @param permutation The permutation, e.g., from 'argsort_doubles'.
+ * @param numElements The number of elements of the permutation.
+ */
+void gather_doubles(double *destination, const double *source, const uint32_t *permutation, size_t numElements)
+{
+	if ((destination == NULL || source == NULL || permutation == NULL) && numElements > 0){ perror("\n\nError: NULL array in 'gather_doubles'.\n");      return; }
+	
+	for (size_t i = 0; i < numElements; i++)
+	{
+		destination[i] = source[permutation[i]];
+	}
+}
+
+
+/**
+ * gather_int64
+ *
+ * Applies a permutation to a column of int64_t values(e.g., Unix timestamps): 'destination[i] = source[permutation[i]]'.
+ *
+ * @param destination The array to fill, which must not overlap the source.
+ * @param source The values to reorder.
+ * @param permutation The permutation, e.g., from 'argsort_int64'.
+ * @param numElements The number of elements of the permutation.
+ */
+void gather_int64(int64_t *destination, const int64_t *source, const uint32_t *permutation, size_t numElements)
+{
+	if ((destination == NULL || source == NULL || permutation == NULL) && numElements > 0){ perror("\n\nError: NULL array in 'gather_int64'.\n");      return; }
+	
+	for (size_t i = 0; i < numElements; i++)
+	{
+		destination[i] = source[permutation[i]];
+	}
+}
+
+
+
+/**
+ * StringSortEntry
+ *
+ * Pairs a string with a cached, big-endian packed copy of (up to) 8 of its bytes starting at the current sorting depth.
+ * Comparing two cached prefixes as unsigned 64-bit integers is equivalent to comparing those 8 bytes lexicographically,
+ * so the string sorts below only dereference the string pointers when the prefixes are exhausted and must be refilled.
+ * Bytes past the end of a string are stored as zero, which sorts shorter strings before their extensions.
+ */
+typedef struct StringSortEntry
+{
+	uint64_t prefix; // Bytes [depth, depth + 8) of the string, first byte in the most significant position.
+	char *string; // The string the prefix was loaded from.
+} StringSortEntry;
+
+
+#define STRING_SORT_INSERTION_CUTOFF 32 // Buckets at or below this size are finished with an insertion sort.
+#define STRING_SORT_PARALLEL_THRESHOLD 65536 // Inputs below this size are not worth distributing across threads.
+#define STRING_SORT_MAX_RADIX_LEVELS 64 // Deeper buckets leave the radix sort, whose frames hold 6 KB of histograms, for a comparison sort.
+
+
+/**
+ * load_string_prefix
+ *
+ * Packs up to 8 bytes of 'characterString', starting at 'depth', into a big-endian 64-bit key.
+ * The caller guarantees that the string is at least 'depth' characters long.
+ *
+ * @param characterString The string to load the prefix from.
+ * @param depth The offset of the first byte to load.
+ * @return The packed prefix, zero-padded past the end of the string.
+ */
+static inline uint64_t load_string_prefix(const char *characterString, size_t depth)
+{
+	const unsigned char *s = (const unsigned char *)characterString + depth;
+	uint64_t prefix = 0;
+	int i = 0;
+	
+	for (; i < 8 && s[i] != '\0'; i++)
+	{
+		prefix = (prefix << 8) | s[i];
+	}
+	return i == 0 ? 0 : prefix << (8 * (8 - i)); // Shift any partial prefix up so its first byte is the most significant one.
+}
+
+
+/**
+ * prefix_is_terminal
+ *
+ * Checks whether a cached prefix already contains the end of its string, in which case two entries with equal
+ * prefixes are equal strings and no deeper comparison is necessary.
+ */
+static inline bool prefix_is_terminal(uint64_t prefix)
+{
+	return (prefix & 0xFF) == 0;
+}
+
+
+/**
+ * compare_string_entries
+ *
+ * Compares two string sort entries whose strings are known to be equal before 'depth'.
+ * The cached prefixes are compared first and the strings are only dereferenced if the prefixes tie.
+ */
+static inline int compare_string_entries(const StringSortEntry *a, const StringSortEntry *b, size_t depth)
+{
+	if (a->prefix != b->prefix)
+	{
+		return a->prefix < b->prefix ? -1 : 1;
+	}
+	if (prefix_is_terminal(a->prefix))
+	{
+		return 0;
+	}
+	
+	const unsigned char *s1 = (const unsigned char *)a->string + depth + 8;
+	const unsigned char *s2 = (const unsigned char *)b->string + depth + 8;
+	while (*s1 && *s1 == *s2)
+	{
+		s1++;
+		s2++;
+	}
+	return (int)*s1 - (int)*s2;
+}
+
+
+/**
+ * insertion_sort_string_entries
+ *
+ * Stable insertion sort used to finish small buckets, all entries share their first 'depth' bytes.
+ */
+static void insertion_sort_string_entries(StringSortEntry *entries, size_t numElements, size_t depth)
+{
+	for (size_t i = 1; i < numElements; i++)
+	{
+		StringSortEntry current = entries[i];
+		size_t j = i;
+		while (j > 0 && compare_string_entries(&entries[j - 1], &current, depth) > 0)
+		{
+			entries[j] = entries[j - 1];
+			j--;
+		}
+		entries[j] = current;
+	}
+}
+
+
+/**
+ * prefix_byte
+ *
+ * Extracts byte 'b'(0 = most significant) of a cached prefix.
+ */
+static inline unsigned prefix_byte(uint64_t prefix, int b)
+{
+	return (unsigned)(prefix >> (56 - 8 * b)) & 0xFF;
+}
+
+
+/**
+ * merge_sort_string_entries
+ *
+ * Stable merge sort of entries that share their first 'depth' bytes, through the scratch buffer 'aux'. The fallback of the
+ * stable radix sort for buckets nested too deeply to keep recursing on the stack.
+ */
+static void merge_sort_string_entries(StringSortEntry *entries, StringSortEntry *aux, size_t numElements, size_t depth)
+{
+	if (numElements <= STRING_SORT_INSERTION_CUTOFF)
+	{
+		insertion_sort_string_entries(entries, numElements, depth);
+		return;
+	}
+	
+	size_t middle = numElements / 2;
+	merge_sort_string_entries(entries, aux, middle, depth);
+	merge_sort_string_entries(entries + middle, aux, numElements - middle, depth);
+	if (compare_string_entries(&entries[middle - 1], &entries[middle], depth) <= 0)
+	{
+		return; // Already in order.
+	}
+	
+	copy_memory_block(aux, entries, middle * sizeof(StringSortEntry));
+	size_t i = 0, j = middle, k = 0;
+	while (i < middle && j < numElements)
+	{
+		entries[k++] = (compare_string_entries(&entries[j], &aux[i], depth) < 0) ? entries[j++] : aux[i++];
+	}
+	while (i < middle)
+	{
+		entries[k++] = aux[i++];
+	}
+}
+
+
+static void mkqs_string_entries(StringSortEntry *entries, size_t numElements, size_t depth);
+
+
+/**
+ * msd_radix_sort_string_entries
+ *
+ * MSD radix sort over the cached prefixes. Entries are distributed into 256 buckets by byte 'b' of their prefix,
+ * and each bucket is sorted on the next byte. Once all 8 cached bytes are consumed the prefixes of that bucket are refilled
+ * from the strings 8 bytes deeper. Bucket 0 holds strings that end at the current byte and is therefore already sorted.
+ *
+ * A byte on which every entry agrees(a long shared prefix) is skipped by looping rather than recursing, so only bytes that
+ * split the entries add a level of recursion. Past 'STRING_SORT_MAX_RADIX_LEVELS' levels a bucket is finished by a merge sort
+ * through 'aux'(stable) or by the multikey quicksort(in place), which bounds the stack whatever the strings.
+ *
+ * When 'aux' is non-NULL the distribution is a stable counting sort through 'aux', otherwise the entries are permuted in
+ * place with the American flag cycle-leader scheme, which needs no extra memory but does not preserve the order of equal keys.
+ *
+ * @param entries The entries to be sorted, all sharing their first 'depth + b' bytes.
+ * @param aux Scratch space of at least 'numElements' entries for the stable variant, or NULL.
+ * @param numElements The number of entries.
+ * @param depth The string offset the cached prefixes were loaded from.
+ * @param b The byte of the cached prefix to distribute on.
+ * @param level The number of enclosing recursive calls.
+ */
+static void msd_radix_sort_string_entries(StringSortEntry *entries, StringSortEntry *aux, size_t numElements, size_t depth, int b, int level)
+{
+	size_t counts[256];
+	for (;;)
+	{
+		if (numElements <= STRING_SORT_INSERTION_CUTOFF)
+		{
+			// Bytes before 'b' are equal in this bucket, so comparing the full prefixes orders them by the remaining bytes.
+			insertion_sort_string_entries(entries, numElements, depth);
+			return;
+		}
+		if (level >= STRING_SORT_MAX_RADIX_LEVELS)
+		{
+			if (aux != NULL)
+			{
+				merge_sort_string_entries(entries, aux, numElements, depth);
+			}
+			else
+			{
+				mkqs_string_entries(entries, numElements, depth);
+			}
+			return;
+		}
+		
+		
+		set_memory_block(counts, 0, sizeof(counts));
+		for (size_t i = 0; i < numElements; i++)
+		{
+			counts[prefix_byte(entries[i].prefix, b)]++;
+		}
+		
+		
+		// Every entry has the same byte: nothing to distribute, move on to the next byte in place.
+		unsigned shared = prefix_byte(entries[0].prefix, b);
+		if (counts[shared] != numElements)
+		{
+			break;
+		}
+		if (shared == 0)
+		{
+			return; // Every string ends here, they are all equal.
+		}
+		if (b < 7)
+		{
+			b++;
+		}
+		else
+		{
+			for (size_t i = 0; i < numElements; i++)
+			{
+				entries[i].prefix = load_string_prefix(entries[i].string, depth + 8);
+			}
+			depth += 8;
+			b = 0;
+		}
+	}
+	
+	
+	size_t offsets[256];
+	offsets[0] = 0;
+	for (int c = 1; c < 256; c++)
+	{
+		offsets[c] = offsets[c - 1] + counts[c - 1];
+	}
+	
+	
+	if (aux != NULL)
+	{
+		// Stable counting sort through the scratch buffer.
+		size_t next[256];
+		copy_memory_block(next, offsets, sizeof(next));
+		for (size_t i = 0; i < numElements; i++)
+		{
+			aux[next[prefix_byte(entries[i].prefix, b)]++] = entries[i];
+		}
+		copy_memory_block(entries, aux, numElements * sizeof(StringSortEntry));
+	}
+	else
+	{
+		// American flag sort: swap each entry directly into its bucket until every bucket is full.
+		size_t next[256];
+		copy_memory_block(next, offsets, sizeof(next));
+		for (int c = 0; c < 256; c++)
+		{
+			size_t end = offsets[c] + counts[c];
+			while (next[c] < end)
+			{
+				StringSortEntry entry = entries[next[c]];
+				unsigned digit = prefix_byte(entry.prefix, b);
+				while (digit != (unsigned)c)
+				{
+					StringSortEntry displaced = entries[next[digit]];
+					entries[next[digit]++] = entry;
+					entry = displaced;
+					digit = prefix_byte(entry.prefix, b);
+				}
+				entries[next[c]++] = entry;
+			}
+		}
+	}
+	
+	
+	// Recurse into every non-terminal bucket.
+	for (int c = 1; c < 256; c++)
+	{
+		if (counts[c] < 2)
+		{
+			continue;
+		}
+		
+		StringSortEntry *bucket = entries + offsets[c];
+		if (b < 7)
+		{
+			msd_radix_sort_string_entries(bucket, aux, counts[c], depth, b + 1, level + 1);
+		}
+		else
 		{
-			// Convert the parsed time (tm structure) to Unix time.
-			unixTime = mktime(&tm);
-			
-			// If conversion is successful (unixTime is not -1), break out of the loop.
-			if (unixTime != -1)
+			// All 8 cached bytes are consumed, refill the prefixes from the next 8 bytes of each string.
+			for (size_t i = 0; i < counts[c]; i++)
 			{
-				break;
+				bucket[i].prefix = load_string_prefix(bucket[i].string, depth + 8);
 			}
+			msd_radix_sort_string_entries(bucket, aux, counts[c], depth + 8, 0, level + 1);
 		}
 	}
-	
-	// Return the resulting Unix time, or -1 if none of the formats matched.
-	return unixTime;
 }
 
 
 /**
- * thread_safe_localtime
- *
- * Converts time_t to tm as Local Time in a thread-safe manner.
- * Uses mutexes to ensure thread safety during the conversion.
+ * create_string_sort_entries
  *
- * @param tim The time_t structure to convert.
- * @param result A pointer to the struct tm where the result will be stored.
- * @return A pointer to the result if successful, NULL otherwise.
+ * Allocates and fills the prefix-cached entries for an array of strings.
  */
-struct tm *thread_safe_localtime(const time_t *tim, struct tm *result)
+static StringSortEntry *create_string_sort_entries(char **strings, size_t numElements, const char *caller)
 {
-	struct tm *t = NULL;
-	
-	// Ensure 'result' is a non-null pointer
-	if (result == NULL)
+	StringSortEntry *entries = (StringSortEntry *)utilities_malloc(numElements * sizeof(StringSortEntry));
+	if (entries == NULL)
 	{
-		return NULL;
+		fprintf(stderr, "\n\nError: Unable to allocate memory in '%s'.\n", caller);
+		exit(1);
 	}
 	
-	
-	pthread_mutex_lock(&localtime_mutex);
-	t = localtime(tim);
-	if (t)
+	for (size_t i = 0; i < numElements; i++)
 	{
-		*result = *t;  // Copy the statically allocated struct
+		entries[i].string = strings[i];
+		entries[i].prefix = load_string_prefix(strings[i], 0);
 	}
-	pthread_mutex_unlock(&localtime_mutex);
-	
-	pthread_mutex_destroy(&localtime_mutex);
-	
-	
-	return t ? result : NULL; // Return result if localtime didn't return NULL
+	return entries;
 }
 
 
-
-
-
-
-
-
 /**
- * flip_sign_bit
- *
- * Flip the Sign Bit of a 64-bit Integer.
- * Flips(toggles) the sign bit(Most Significant Bit) of a 64-bit integer, effectively changing the sign of a floating-point number
- * represented in its binary form(specifically IEEE 754 representation for doubles). This function is particularly
- * useful in scenarios involving floating-point numbers where the sign needs to be altered while preserving the
- * magnitude and exponent parts of the floating-point representation.
+ * store_string_sort_entries
  *
- * @param value The 64-bit unsigned integer whose sign bit is to be flipped.
- * @return The 64-bit unsigned integer with its sign bit flipped.
+ * Writes the sorted string pointers back to the caller's array and releases the entries.
  */
-uint64_t flip_sign_bit(uint64_t value)
+static void store_string_sort_entries(char **strings, StringSortEntry *entries, size_t numElements)
 {
-	// '1ull << 63' creates a 64-bit integer with only the MSB set to 1 (i.e., the 63rd bit in zero-indexed notation).
-	
-	// 'value ^ ...' applies the bitwise XOR operation between the input 'value' and the above-created integer.
-	//   XOR with '1' toggles the corresponding bit, so if the sign bit in 'value' is 0 (positive number), it becomes 1 (negative number),
-	//   and vice versa, hence this operation flips the sign bit of the input 'value'.
-	return value ^ (1ull << 63);
+	for (size_t i = 0; i < numElements; i++)
+	{
+		strings[i] = entries[i].string;
+	}
+	utilities_free(entries);
 }
 
 
 /**
- * double_to_uint64
+ * radix_sort_strings
  *
- * This function reinterprets a double value as a 64-bit unsigned integer (uint64_t) by directly copying its binary representation.
- * This method of type-punning allows the bit pattern of a double to be reinterpreted as a uint64_t without any conversion,
- * facilitating direct manipulation of a double's binary representation for bit-level operations, useful in certain algorithms like
- * sorting or encoding, where floating-point operations are not required.
+ * Sorts an array of strings into ascending byte-wise(unsigned char) order, the same order produced by 'compare_strings',
+ * using a most-significant-digit radix sort. Each string is paired with a cached 8-byte big-endian prefix, so the
+ * distribution passes only touch the contiguous entry array, and the strings themselves are only dereferenced
+ * once every 8 bytes of shared prefix. Buckets are permuted in place(American flag sort), so the only allocation is the entry array.
  *
- * @param value The double value to be reinterpreted as a uint64_t.
- * @return The binary representation of the input double as a uint64_t.
+ * This sort is not stable, see 'radix_sort_strings_stable' when the relative order of equal strings matters.
+ *
+ * @param unsortedStrings The array of NULL-terminated strings to be sorted, none of its elements may be NULL.
+ * @param numElements The number of strings in the array.
  */
-uint64_t double_to_uint64(double value)
+void radix_sort_strings(char **unsortedStrings, const size_t numElements)
 {
-	uint64_t result;
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_STRINGS);
+	// Check for null pointers to ensure data integrity
+	if (unsortedStrings == NULL)
+	{
+		perror("\n\nError: Data to be sorted was NULL in 'radix_sort_strings'.\n");
+		exit(1);
+	}
+	if (numElements < 2)
+	{
+		return;
+	}
 	
-	// Copies the binary representation of 'value' into 'result', 'sizeof(double)' ensures that exactly 8 bytes (size of a double) are copied.
-	copy_memory_block(&result, &value, sizeof(double));
-	return result;
+	StringSortEntry *entries = create_string_sort_entries(unsortedStrings, numElements, "radix_sort_strings");
+	msd_radix_sort_string_entries(entries, NULL, numElements, 0, 0, 0);
+	store_string_sort_entries(unsortedStrings, entries, numElements);
 }
 
+
 /**
- * uint64_to_double
+ * radix_sort_strings_stable
  *
- * This function reinterprets a 64-bit unsigned integer (uint64_t) as a double by copying its binary representation.
- * It is the inverse operation of double_to_uint64, allowing for the conversion of a manipulated uint64_t representation
- * back to a double. Allows for conversion of a uint64_t value back to a double after performing bit-level manipulations, enabling the use
- *  or interpretation of the result as a floating-point number.
+ * Stable variant of 'radix_sort_strings'. The distribution passes are counting sorts through a scratch
+ * buffer and small buckets are finished with an insertion sort, both of which preserve the original relative
+ * order of equal strings, at the cost of a second entry-sized allocation.
  *
- * @param value The 64-bit unsigned integer to be reinterpreted as a double.
- * @return The binary representation of the input uint64_t as a double.
+ * @param unsortedStrings The array of NULL-terminated strings to be sorted, none of its elements may be NULL.
+ * @param numElements The number of strings in the array.
  */
-double uint64_to_double(uint64_t value)
+void radix_sort_strings_stable(char **unsortedStrings, const size_t numElements)
 {
-	double result;
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_STRINGS_STABLE);
+	// Check for null pointers to ensure data integrity
+	if (unsortedStrings == NULL)
+	{
+		perror("\n\nError: Data to be sorted was NULL in 'radix_sort_strings_stable'.\n");
+		exit(1);
+	}
+	if (numElements < 2)
+	{
+		return;
+	}
 	
-	// Copies the binary representation of 'value' into 'result', sizeof(uint64_t)' ensures that exactly 8 bytes (size of a uint64_t) are copied.
-	copy_memory_block(&result, &value, sizeof(uint64_t));
-	return result;
+	StringSortEntry *entries = create_string_sort_entries(unsortedStrings, numElements, "radix_sort_strings_stable");
+	StringSortEntry *aux = (StringSortEntry *)utilities_malloc(numElements * sizeof(StringSortEntry));
+	if (aux == NULL)
+	{
+		perror("\n\nError: Unable to allocate memory in 'radix_sort_strings_stable'.\n");
+		exit(1);
+	}
+	
+	msd_radix_sort_string_entries(entries, aux, numElements, 0, 0, 0);
+	
+	utilities_free(aux);
+	store_string_sort_entries(unsortedStrings, entries, numElements);
 }
 
 
 
 
+/**
+ * StringSortBucketTask
+ *
+ * Shared state for the worker threads of 'radix_sort_strings_parallel'. Workers claim top-level buckets through
+ * an atomic cursor into 'bucketOrder', which lists the buckets from largest to smallest to balance the load.
+ */
+typedef struct StringSortBucketTask
+{
+	StringSortEntry *entries;
+	StringSortEntry *aux;
+	const size_t *offsets;
+	const size_t *counts;
+	const unsigned *bucketOrder;
+	size_t numBuckets;
+	size_t nextBucket; // Accessed atomically.
+} StringSortBucketTask;
 
 
-
-
-
-
-
-
+/**
+ * sort_string_buckets_worker
+ *
+ * Thread entry point, repeatedly claims the next unsorted top-level bucket and sorts it on the third cached byte.
+ */
+static void *sort_string_buckets_worker(void *argument)
+{
+	StringSortBucketTask *task = (StringSortBucketTask *)argument;
+	
+	for (;;)
+	{
+		size_t claimed = __atomic_fetch_add(&task->nextBucket, 1, __ATOMIC_RELAXED);
+		if (claimed >= task->numBuckets)
+		{
+			break;
+		}
+		
+		unsigned bucket = task->bucketOrder[claimed];
+		size_t offset = task->offsets[bucket];
+		msd_radix_sort_string_entries(task->entries + offset, task->aux + offset, task->counts[bucket], 0, 2, 1);
+	}
+	return NULL;
+}
 
 
 /**
- * merge_data
+ * radix_sort_strings_parallel
  *
- * Merges two subarrays of unsortedData[].
- * This function is a part of the merge sort algorithm. It merges two sorted subarrays
- * defined by the indices [left, middle] and [middle+1, right] into a single sorted array.
- * It uses two temporary arrays to hold the subarrays and then merges them back into the
- * original array in a sorted manner.
+ * Multi-threaded variant of 'radix_sort_strings_stable'. The entries are first distributed with a single stable
+ * counting pass on their leading 16 bits into 65536 top-level buckets, which spreads even skewed inputs (for example a column
+ * where every value starts with the same letter) across many independent buckets. The worker threads then claim
+ * buckets, largest first, and finish each one with the serial stable radix sort. Buckets whose first or second
+ * byte is the string terminator hold equal strings and are skipped.
  *
- * @param unsortedData Pointer to the array of doubles to be sorted.
- * @param left The starting index of the first subarray,  unsortedData[left..middle]
- * @param middle The ending index of the first subarray and the starting index of the second subarray minus one.
- * @param right The ending index of the second subarray,  unsortedData[middle+1..right]
+ * Inputs smaller than an internal threshold, or a thread count of 1, fall back to 'radix_sort_strings_stable'.
+ *
+ * @param unsortedStrings The array of NULL-terminated strings to be sorted, none of its elements may be NULL.
+ * @param numElements The number of strings in the array.
+ * @param numThreads The number of worker threads to use, a value <= 0 uses one thread per online processor.
  */
-void merge_data(double *unsortedData, int left, int middle, int right)
+void radix_sort_strings_parallel(char **unsortedStrings, const size_t numElements, int numThreads)
 {
-	// Calculate the sizes of the two subarrays to be merged
-	int i, j, k;
-	int size1 = middle - left + 1;  // Size of the first subarray
-	int size2 = right - middle;   // Size of the second subarray
+	INSTRUMENT_FUNCTION(INSTRUMENT_RADIX_SORT_STRINGS_PARALLEL);
+	// Check for null pointers to ensure data integrity
+	if (unsortedStrings == NULL)
+	{
+		perror("\n\nError: Data to be sorted was NULL in 'radix_sort_strings_parallel'.\n");
+		exit(1);
+	}
 	
+	numThreads = resolve_thread_count(numThreads);
+	if (numThreads == 1 || numElements < STRING_SORT_PARALLEL_THRESHOLD)
+	{
+		radix_sort_strings_stable(unsortedStrings, numElements);
+		return;
+	}
 	
 	
-	// Dynamically allocate memory for temporary arrays holding subarray elements
-	double *leftTempData = (double*)malloc(size1 * sizeof(double));//  = allocate_memory_double_ptr(size1);
-	double *rightTempData = (double*)malloc(size2 * sizeof(double));// = allocate_memory_double_ptr(size2);
+	const size_t numBuckets = 65536;
+	StringSortEntry *entries = create_string_sort_entries(unsortedStrings, numElements, "radix_sort_strings_parallel");
+	StringSortEntry *aux = (StringSortEntry *)utilities_malloc(numElements * sizeof(StringSortEntry));
+	size_t *counts = (size_t *)utilities_calloc(numBuckets, sizeof(size_t));
+	size_t *offsets = (size_t *)utilities_malloc(numBuckets * sizeof(size_t));
+	unsigned *bucketOrder = (unsigned *)utilities_malloc(numBuckets * sizeof(unsigned));
+	pthread_t *threads = (pthread_t *)utilities_malloc(numThreads * sizeof(pthread_t));
+	if (aux == NULL || counts == NULL || offsets == NULL || bucketOrder == NULL || threads == NULL)
+	{
+		perror("\n\nError: Unable to allocate memory in 'radix_sort_strings_parallel'.\n");
+		exit(1);
+	}
 	
 	
-	// Copying data to the temporary arrays to isolate the subarrays
-	for (i = 0; i < size1; i++)
+	/// Step 1: Stable distribution of the entries on the leading 16 bits of their prefixes.
+	for (size_t i = 0; i < numElements; i++)
 	{
-		leftTempData[i] = (unsortedData)[left + i];
+		counts[entries[i].prefix >> 48]++;
 	}
-	for (j = 0; j < size2; j++)
+	offsets[0] = 0;
+	for (size_t c = 1; c < numBuckets; c++)
 	{
-		rightTempData[j] = (unsortedData)[middle + 1 + j];
+		offsets[c] = offsets[c - 1] + counts[c - 1];
+	}
+	for (size_t i = 0; i < numElements; i++)
+	{
+		aux[offsets[entries[i].prefix >> 48]++] = entries[i];
+	}
+	for (size_t c = 0; c < numBuckets; c++) // The scatter advanced every offset to the end of its bucket, step them back to the start.
+	{
+		offsets[c] -= counts[c];
 	}
 	
+	// The distributed entries become the primary array, the original array is reused as the workers' scratch space.
+	StringSortEntry *swap = entries;
+	entries = aux;
+	aux = swap;
 	
 	
-	// Merging the temporary arrays back into the original array[left..right]
-	i = 0; // Initial index of the first subarray
-	j = 0; // Initial index of the second subarray
-	k = left; // Initial index of the merged subarray
-	while (i < size1 && j < size2)
+	/// Step 2: Collect the buckets that still need sorting, largest first.
+	size_t numPendingBuckets = 0;
+	for (unsigned c = 0; c < numBuckets; c++)
 	{
-		if (leftTempData[i] <= rightTempData[j])
-		{
-			(unsortedData)[k] = leftTempData[i];
-			i++;
-		}
-		else
+		// Buckets where the string ends at the first or second byte contain only equal strings.
+		if (counts[c] > 1 && (c >> 8) != 0 && (c & 0xFF) != 0)
 		{
-			(unsortedData)[k] = rightTempData[j];
-			j++;
+			bucketOrder[numPendingBuckets++] = c;
 		}
-		k++;
-	}
-	while (i < size1)  // Copy the remaining elements from leftTempData to unsortedData
-	{
-		(unsortedData)[k] = leftTempData[i];
-		i++;
-		k++;
 	}
-	while (j < size2)  // Copy the remaining elements from rightTempData to unsortedData
+	for (size_t i = 1; i < numPendingBuckets; i++) // Buckets are mostly small, an insertion sort on their sizes is sufficient.
 	{
-		(unsortedData)[k] = rightTempData[j];
-		j++;
-		k++;
+		unsigned current = bucketOrder[i];
+		size_t j = i;
+		while (j > 0 && counts[bucketOrder[j - 1]] < counts[current])
+		{
+			bucketOrder[j] = bucketOrder[j - 1];
+			j--;
+		}
+		bucketOrder[j] = current;
 	}
 	
 	
-	free(leftTempData);
-	free(rightTempData);
-}
-
-
-/**
- * merge_sort_data
- *
- * This function implements the recursive part of the merge sort algorithm. It recursively divides
- * the array into two halves, calls itself for the two halves, and then merges the two sorted halves
- * using the merge_data function..
- *
- * @param unsortedData Pointer to the array of doubles to be sorted.
- * @param left The starting index of the array portion to be sorted.
- * @param right The ending index of the array portion to be sorted.
- */
-void merge_sort_data(double *unsortedData, int left, int right)
-{
-	if(left < right)  // Check to ensure valid indexing bounds
+	/// Step 3: Sort the buckets concurrently.
+	StringSortBucketTask task = { entries, aux, offsets, counts, bucketOrder, numPendingBuckets, 0 };
+	for (int t = 0; t < numThreads; t++)
 	{
-		// Find the middle point to divide the array into two halves
-		int middle = left + (right - left) / 2; // Same as (left+right)/2, but avoids overflow for large left and right
-		
-		// Recursive call to sort the first half of the array until the sub-arrays are small enough to be solved directly
-		merge_sort_data(unsortedData, left, middle);
-		
-		// Recursive call to sort the second half of the array until the sub-arrays are small enough to be solved directly
-		merge_sort_data(unsortedData, middle + 1, right);
-		
-		// Merge the sorted halves
-		merge_data(unsortedData, left, middle, right);
+		if (pthread_create(&threads[t], NULL, sort_string_buckets_worker, &task) != 0)
+		{
+			perror("\n\nError: Unable to create thread in 'radix_sort_strings_parallel'.\n");
+			exit(1);
+		}
 	}
-}
-
-
-/**
- * merge_sort,  a divide and conquer algorithm, O(nLogn)
- *
- * This function is the entry point for the merge sort algorithm. It checks for
- * null pointers and then calls merge_sort_data to sort the entire array.
- *
- * @param unsortedData Pointer to the array of doubles to be sorted.
- * @param numElements The number of elements in the array.
- */
-void merge_sort(double *unsortedData, const int numElements)
-{
-	// Check for null pointers to ensure data integrity
-	if(unsortedData == NULL)
+	for (int t = 0; t < numThreads; t++)
 	{
-		perror("\n\nError: Data to be sorted was NULL in 'merge_sort'.\n");
-		exit(1);
+		pthread_join(threads[t], NULL);
 	}
 	
 	
-	// Initial call to the recursive merge sort function on the entire array
-	merge_sort_data(unsortedData, 0, numElements - 1);
+	utilities_free(aux);
+	utilities_free(counts);
+	utilities_free(offsets);
+	utilities_free(bucketOrder);
+	utilities_free(threads);
+	store_string_sort_entries(unsortedStrings, entries, numElements);
 }
 
 
 
 
 /**
- * radix_sort_doubles
- *
- * Sorts an array of double precision floating-point numbers using Radix Sort algorithm. This implementation
- * specifically deals with the floating-point nature of the data by converting doubles to their 64-bit integer
- * representations. The sorting is performed on these integer representations, enabling the Radix Sort algorithm
- * to be applied to floating-point numbers.
- *
+ * mkqs_string_entries
  *
- * Perform a radix sort on an array of double values. This function sorts an array of doubles
- * using a radix sort algorithm, which is a non-comparative integer sorting algorithm. It achieves this by
- * interpreting the bit representation of double values as unsigned 64-bit integers (uint64_t).
+ * Multikey quicksort(Bentley and Sedgewick's three-way radix quicksort) over the cached prefixes.
+ * Rather than partitioning on a single character, each partition step compares whole 8-byte prefixes, so one
+ * three-way partition resolves up to 8 characters at once. The '<' and '>' partitions are sorted recursively at the same depth,
+ * and the '=' partition, unless its prefix already holds the terminator, is refilled 8 bytes deeper and sorted again.
  *
- * The radix sort is done on the binary representation of these integers. Special handling is done for negative
- * numbers by flipping the sign bit, to ensure they are sorted correctly. Post sorting, the binary representations
- * are converted back to double values.
- *
- * This function is particularly useful in scenarios where a fast, stable sorting of a large number of floating-point numbers( > 60) is required.
- *
- * @param unsortedData A pointer to the array of double values to be sorted.
- * @param numElements The number of elements in the array.
+ * @param entries The entries to be sorted, all sharing their first 'depth' bytes.
+ * @param numElements The number of entries.
+ * @param depth The string offset the cached prefixes were loaded from.
  */
-void radix_sort_doubles(double *unsortedData, const int numElements)
+static void mkqs_string_entries(StringSortEntry *entries, size_t numElements, size_t depth)
 {
-	// Allocate memory for temporary arrays used in sorting
-	uint64_t* temp = (uint64_t*)malloc(numElements * sizeof(uint64_t));
-	uint64_t* intValues = (uint64_t*)malloc(numElements * sizeof(uint64_t));
-	
-	/// Step 1: Convert doubles to uint64_t for sorting, reinterpreting each double as a 64-bit integer.
-	for (size_t i = 0; i < numElements; i++)
+	while (numElements > STRING_SORT_INSERTION_CUTOFF)
 	{
-		uint64_t intValue = double_to_uint64(unsortedData[i]);
+		// Median-of-three pivot selection guards against presorted inputs.
+		uint64_t a = entries[0].prefix;
+		uint64_t b = entries[numElements / 2].prefix;
+		uint64_t c = entries[numElements - 1].prefix;
+		uint64_t pivot = (a < b) ? ((b < c) ? b : ((a < c) ? c : a)) : ((a < c) ? a : ((b < c) ? c : b));
 		
 		
-		// Check if the number is negative (indicated by the sign bit).
-		// If so, flip the sign bit to ensure correct sorting order
-		if (intValue >> 63)
+		// Dijkstra three-way partition: [0, lt) < pivot, [lt, i) == pivot, (gt, n) > pivot.
+		size_t lt = 0, i = 0, gt = numElements;
+		while (i < gt)
 		{
-			intValue = flip_sign_bit(intValue);
+			uint64_t key = entries[i].prefix;
+			if (key < pivot)
+			{
+				StringSortEntry temp = entries[lt];
+				entries[lt++] = entries[i];
+				entries[i++] = temp;
+			}
+			else if (key > pivot)
+			{
+				StringSortEntry temp = entries[--gt];
+				entries[gt] = entries[i];
+				entries[i] = temp;
+			}
+			else
+			{
+				i++;
+			}
 		}
-		intValues[i] = intValue;
-	}
-	
-	
-	
-	
-	/// Step 2: Perform Radix Sort on the 64-bit integer representations.
-	for (int shift = 0; shift < 64; shift += 8)
-	{
-		// Sorts the array byte-by-byte (8 bits at a time).
-		size_t counts[256] = {0};
-		size_t offsets[256] = {0};
 		
 		
-		// Counting occurrences for each byte value
-		for (size_t i = 0; i < numElements; i++)
+		// Sort the equal partition on the next 8 bytes, looping rather than recursing when it holds every entry.
+		size_t equalCount = gt - lt;
+		if (equalCount > 1 && !prefix_is_terminal(pivot))
 		{
-			size_t index = (intValues[i] >> shift) & 0xFF;
-			counts[index]++;
+			StringSortEntry *equal = entries + lt;
+			for (size_t k = 0; k < equalCount; k++)
+			{
+				equal[k].prefix = load_string_prefix(equal[k].string, depth + 8);
+			}
+			if (equalCount == numElements)
+			{
+				depth += 8;
+				continue;
+			}
+			mkqs_string_entries(equal, equalCount, depth + 8);
 		}
 		
-		// Calculate offsets for each byte value
-		for (size_t i = 1; i < 256; i++)
+		
+		// Recurse into the smaller outer partition and loop on the larger one to bound the stack depth.
+		size_t lessCount = lt;
+		size_t greaterCount = numElements - gt;
+		if (lessCount < greaterCount)
 		{
-			offsets[i] = offsets[i - 1] + counts[i - 1];
+			mkqs_string_entries(entries, lessCount, depth);
+			entries += gt;
+			numElements = greaterCount;
 		}
-		
-		// Reorder elements based on the current byte
-		for (size_t i = 0; i < numElements; i++)
+		else
 		{
-			size_t index = (intValues[i] >> shift) & 0xFF;
-			temp[offsets[index]] = intValues[i];
-			offsets[index]++;
+			mkqs_string_entries(entries + gt, greaterCount, depth);
+			numElements = lessCount;
 		}
-		
-		// Copy the sorted temporary array to the original one
-		copy_memory_block(intValues, temp, numElements * sizeof(uint64_t));
 	}
 	
-	
-	/// Step 3: Convert uint64_t back to double
-	for (size_t i = 0; i < numElements; i++)
+	insertion_sort_string_entries(entries, numElements, depth);
+}
+
+
+/**
+ * multikey_quicksort_strings
+ *
+ * Sorts an array of strings into ascending byte-wise(unsigned char) order using a multikey quicksort over
+ * cached 8-byte prefixes. Compared to 'radix_sort_strings' it has no per-level histogram cost, which makes it the
+ * better choice for small arrays and for strings with long shared prefixes(for example timestamps or paths). This sort is not stable.
+ *
+ * @param unsortedStrings The array of NULL-terminated strings to be sorted, none of its elements may be NULL.
+ * @param numElements The number of strings in the array.
+ */
+void multikey_quicksort_strings(char **unsortedStrings, const size_t numElements)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_MULTIKEY_QUICKSORT_STRINGS);
+	// Check for null pointers to ensure data integrity
+	if (unsortedStrings == NULL)
 	{
-		// Re-flip sign bit if necessary to restore the original sign.
-		if (intValues[i] >> 63)
-		{
-			intValues[i] = flip_sign_bit(intValues[i]);
-		}
-		unsortedData[i] = uint64_to_double(intValues[i]);
+		perror("\n\nError: Data to be sorted was NULL in 'multikey_quicksort_strings'.\n");
+		exit(1);
+	}
+	if (numElements < 2)
+	{
+		return;
 	}
 	
-	free(temp);
-	free(intValues);
+	StringSortEntry *entries = create_string_sort_entries(unsortedStrings, numElements, "multikey_quicksort_strings");
+	mkqs_string_entries(entries, numElements, 0);
+	store_string_sort_entries(unsortedStrings, entries, numElements);
 }
 
 
@@ -786,6 +4686,7 @@ void radix_sort_doubles(double *unsortedData, const int numElements)
 
 
 
+
 /**
  * set_memory_block
  *
@@ -931,3 +4832,22 @@ void *copy_memory_block(void *destination, const void *source, size_t n)
 
 
 
+/**
+ * resolve_thread_count
+ *
+ * Resolves the number of worker threads to use for the multi-threaded utilities. Any positive request is
+ * honoured as-is, while zero or a negative value selects one thread per online processor.
+ *
+ * @param requestedThreads The requested number of threads, or a value <= 0 for the processor count.
+ * @return The number of threads to use, always at least 1.
+ */
+int resolve_thread_count(int requestedThreads)
+{
+	if (requestedThreads > 0)
+	{
+		return requestedThreads;
+	}
+	
+	long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+	return processorCount > 0 ? (int)processorCount : 1;
+}
@@ -9,7 +9,7 @@
  * Additionally, it includes utilities for bitwise operations on numerical data, useful in scenarios requiring
  * direct manipulation of the binary representation of data. It also provides robust sorting algorithms, including
  * merge sort and radix sort, optimized for handling large datasets, especially useful for sorting double precision
- * floating-point numbers.
+ * floating-point numbers, as well as radix and multikey quicksorts for arrays of strings.
  */
 
 #ifndef AuxiliaryUtilities_h
@@ -17,7 +17,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <math.h>
+#include <time.h>
 #include <pthread.h>
 
 
@@ -58,7 +61,6 @@ extern const char *weekDays[7];
 extern const char *commonDateTimeFormats[12]; // Used for converting date/time strings from datasets into standardized formats.
 
 
-static pthread_mutex_t localtime_mutex = PTHREAD_MUTEX_INITIALIZER; //Mutex for Thread Safety protecting access to localtime
 // \}
 
 
@@ -66,6 +68,200 @@ static pthread_mutex_t localtime_mutex = PTHREAD_MUTEX_INITIALIZER; //Mutex for
 
 
 
+// ------------------ SIMD Feature Detection and Byte Mask Helpers -------------------
+// \{
+/**
+ * The SIMD kernels throughout the library are written against 16-byte blocks, with an SSE2 implementation on x86-64,
+ * a NEON implementation on AArch64(Apple silicon), and a portable scalar fallback everywhere else. Byte shuffles(SSSE3), wider AVX2
+ * and AVX-512 paths are only compiled when the translation unit is built with them enabled(e.g., '-mavx2').
+ */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define SIMD_SSE2_AVAILABLE 1
+#endif
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define SIMD_SSSE3_AVAILABLE 1
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_AVX2_AVAILABLE 1
+#endif
+
+#if defined(__AVX512BW__) && defined(__AVX512VBMI2__)
+#include <immintrin.h>
+#define SIMD_AVX512_VBMI2_AVAILABLE 1
+#endif
+
+#if defined(__PCLMUL__)
+#include <wmmintrin.h>
+#define SIMD_CLMUL_AVAILABLE 1
+#endif
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SIMD_NEON_AVAILABLE 1
+#if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+#define SIMD_CLMUL_AVAILABLE 1
+#endif
+#endif
+
+
+#if defined(SIMD_NEON_AVAILABLE)
+/**
+ * neon_movemask
+ * Packs the most significant bit of each byte of a NEON comparison result into a 16-bit mask, emulating SSE2's '_mm_movemask_epi8'.
+ */
+static inline uint32_t neon_movemask(uint8x16_t comparison)
+{
+	static const uint8_t bitWeights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x16_t bits = vandq_u8(comparison, vld1q_u8(bitWeights));
+	return (uint32_t)vaddv_u8(vget_low_u8(bits)) | ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+#endif
+
+
+/**
+ * simd_equal_mask16
+ *
+ * Compares 16 bytes starting at 'block' against the byte 'c' and returns a mask with bit i set when block[i] == c.
+ * The caller guarantees that all 16 bytes are readable.
+ */
+static inline uint32_t simd_equal_mask16(const unsigned char *block, unsigned char c)
+{
+#if defined(SIMD_SSE2_AVAILABLE)
+	__m128i bytes = _mm_loadu_si128((const __m128i *)block);
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8((char)c)));
+#elif defined(SIMD_NEON_AVAILABLE)
+	return neon_movemask(vceqq_u8(vld1q_u8(block), vdupq_n_u8(c)));
+#else
+	uint32_t mask = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		mask |= (uint32_t)(block[i] == c) << i;
+	}
+	return mask;
+#endif
+}
+
+
+/**
+ * simd_any_equal_mask16
+ *
+ * Compares 16 bytes starting at 'block' against a small number of candidate bytes and returns a mask with bit i set when block[i]
+ * equals any of the first 'count' entries of 'candidates'(one compare per candidate, so intended for up to about 8 candidates).
+ * The caller guarantees that all 16 bytes are readable.
+ */
+static inline uint32_t simd_any_equal_mask16(const unsigned char *block, const unsigned char *candidates, int count)
+{
+#if defined(SIMD_SSE2_AVAILABLE)
+	__m128i bytes = _mm_loadu_si128((const __m128i *)block);
+	__m128i matches = _mm_setzero_si128();
+	for (int k = 0; k < count; k++)
+	{
+		matches = _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, _mm_set1_epi8((char)candidates[k])));
+	}
+	return (uint32_t)_mm_movemask_epi8(matches);
+#elif defined(SIMD_NEON_AVAILABLE)
+	uint8x16_t bytes = vld1q_u8(block);
+	uint8x16_t matches = vdupq_n_u8(0);
+	for (int k = 0; k < count; k++)
+	{
+		matches = vorrq_u8(matches, vceqq_u8(bytes, vdupq_n_u8(candidates[k])));
+	}
+	return neon_movemask(matches);
+#else
+	uint32_t mask = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		for (int k = 0; k < count; k++)
+		{
+			if (block[i] == candidates[k])
+			{
+				mask |= 1u << i;
+				break;
+			}
+		}
+	}
+	return mask;
+#endif
+}
+
+
+/**
+ * simd_equal_mask64
+ *
+ * Compares 64 bytes starting at 'block' against the byte 'c' and returns a mask with bit i set when block[i] == c.
+ * The caller guarantees that all 64 bytes are readable.
+ */
+static inline uint64_t simd_equal_mask64(const unsigned char *block, unsigned char c)
+{
+	return (uint64_t)simd_equal_mask16(block, c) | ((uint64_t)simd_equal_mask16(block + 16, c) << 16) |
+	((uint64_t)simd_equal_mask16(block + 32, c) << 32) | ((uint64_t)simd_equal_mask16(block + 48, c) << 48);
+}
+
+
+/**
+ * prefix_xor64
+ *
+ * Returns the prefix XOR of a 64-bit mask: bit i of the result is the XOR of bits 0..i of the input. Applied to a mask of
+ * quote characters this yields the mask of bytes inside quoted regions. The prefix XOR is a carry-less multiplication by an
+ * all-ones word(PCLMULQDQ on x86-64, PMULL on AArch64), with a six-step shift-XOR cascade when neither is available.
+ */
+static inline uint64_t prefix_xor64(uint64_t bits)
+{
+#if defined(SIMD_CLMUL_AVAILABLE) && defined(SIMD_NEON_AVAILABLE)
+	return vgetq_lane_u64(vreinterpretq_u64_p128(vmull_p64((poly64_t)bits, (poly64_t)~0ULL)), 0);
+#elif defined(SIMD_CLMUL_AVAILABLE)
+	return (uint64_t)_mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)bits), _mm_set1_epi8((char)0xFF), 0));
+#else
+	bits ^= bits << 1;
+	bits ^= bits << 2;
+	bits ^= bits << 4;
+	bits ^= bits << 8;
+	bits ^= bits << 16;
+	bits ^= bits << 32;
+	return bits;
+#endif
+}
+// \}
+
+
+
+
+
+
+// ------------- Helper Functions for Allocator Hooks and Pooled Allocation -------------
+/// \{
+/**
+ * 'UtilitiesAllocator' struct: the allocator hook every allocation of the library goes through(see 'utilities_set_allocator').
+ */
+typedef struct UtilitiesAllocator
+{
+	void *(*allocate)(size_t size, void *context);
+	void *(*reallocate)(void *block, size_t size, void *context);
+	void (*deallocate)(void *block, void *context);
+	void *context;
+} UtilitiesAllocator;
+
+#define POOL_SLAB_SIZE ((size_t)1 << 16) // The pooled allocator carves its blocks from 64 KiB slabs.
+#define POOL_THREAD_CACHE_LIMIT 512 // Free blocks of a size class a thread keeps before returning a batch to the global pool.
+#define POOL_BATCH_SIZE 256 // Blocks moved between a thread and the global pool at a time.
+
+void utilities_set_allocator(const UtilitiesAllocator *allocator); // Routes the library's allocations to an allocator, NULL restores 'malloc'; select it before allocating anything.
+void *utilities_malloc(size_t size); // Allocates through the selected allocator.
+void *utilities_calloc(size_t count, size_t size); // Allocates zeroed memory through the selected allocator.
+void *utilities_realloc(void *block, size_t size); // Resizes through the selected allocator.
+void utilities_free(void *block); // Frees through the selected allocator.
+const UtilitiesAllocator *utilities_pooled_allocator(void); // Returns the thread-caching size-class pool allocator for small blocks.
+/// \}
+
+
+
+
+
 // ------------- Helper Functions for Allocating Memory Safely For Basic Types -------------
 /// \{
 int *allocate_memory_int_ptr(size_t sizeI);
@@ -79,15 +275,152 @@ char *allocate_memory_char_ptr(size_t sizeC);
 
 // ------------- Helper Functions for Allocating and Deallocating Memory Safely For Derived Types -------------
 /// \{
-int **allocate_memory_int_ptr_ptr(size_t sizeI);
-float **allocate_memory_float_ptr_ptr(size_t sizeF);
-double **allocate_memory_double_ptr_ptr(size_t sizeD);
+/**
+ * Deprecated: 'allocate_memory_int_ptr_ptr', 'allocate_memory_float_ptr_ptr' and 'allocate_memory_double_ptr_ptr' take no column count,
+ * so each of their rows holds only 'sizeof(pointer)' bytes(2 ints or floats, 1 double). They cannot be given a correct row size without
+ * changing their signatures, and are kept unchanged for existing callers; new code should use 'allocate_matrix' and its typed variants.
+ */
+int **allocate_memory_int_ptr_ptr(size_t sizeI) __attribute__((deprecated("rows hold only sizeof(int *) bytes, use 'allocate_matrix_int'")));
+float **allocate_memory_float_ptr_ptr(size_t sizeF) __attribute__((deprecated("rows hold only sizeof(float *) bytes, use 'allocate_matrix_float'")));
+double **allocate_memory_double_ptr_ptr(size_t sizeD) __attribute__((deprecated("rows hold only sizeof(double *) bytes, use 'allocate_matrix_double'")));
 char **allocate_memory_char_ptr_ptr(size_t strSize, size_t numStrings);
 
 void deallocate_memory_int_ptr_ptr(int **intPtrPtr, size_t numInts);
 void deallocate_memory_float_ptr_ptr(float **floatPtrPtr, size_t numFloats);
 void deallocate_memory_double_ptr_ptr(double **doublePtrPtr, size_t numDoubles);
 void deallocate_memory_char_ptr_ptr(char **charPtrPtr, size_t numStrings);
+
+#define MATRIX_ALIGNMENT 64 // Alignment of the elements of a matrix, a cache line.
+void **allocate_matrix(size_t rows, size_t columns, size_t elementSize); // Allocates a row-major matrix as one cache-aligned block with a row-pointer index, freed by 'deallocate_matrix'.
+int **allocate_matrix_int(size_t rows, size_t columns); // 'allocate_matrix' for ints.
+float **allocate_matrix_float(size_t rows, size_t columns); // 'allocate_matrix' for floats.
+double **allocate_matrix_double(size_t rows, size_t columns); // 'allocate_matrix' for doubles.
+char **allocate_matrix_char(size_t rows, size_t columns); // 'allocate_matrix' for chars, e.g., fixed-size string buffers.
+void deallocate_matrix(void *matrix); // Frees a matrix from 'allocate_matrix' with a single call.
+/// \}
+
+
+
+
+
+// ------------- Helper Functions for Arena Allocation -------------
+/// \{
+#define ARENA_DEFAULT_BLOCK_SIZE ((size_t)1 << 20) // Arenas grow in 1 MiB blocks unless told otherwise.
+#define ARENA_ALIGNMENT 16 // Alignment of every arena allocation, sufficient for any basic type and for SSE loads.
+
+typedef struct Arena Arena; // Bump-pointer allocator whose allocations are all released at once.
+
+Arena *arena_create(size_t blockSize); // Creates an arena growing in blocks of 'blockSize' bytes(0 for the default).
+void *arena_alloc(Arena *arena, size_t size); // Allocates aligned memory from an arena by bumping a pointer.
+void arena_reset(Arena *arena); // Releases all allocations of an arena at once, keeping its blocks for reuse.
+void arena_destroy(Arena *arena); // Frees an arena and all of its allocations.
+/// \}
+
+
+
+
+
+
+
+// ------------- Helper Functions for Formatting Numbers -------------
+/// \{
+#define NUMBER_FORMAT_BUFFER_SIZE 32 // Minimum size of the buffers passed to the number formatting functions.
+
+size_t format_uint64(uint64_t value, char *buffer); // Formats an unsigned 64-bit integer in decimal with a digit-pair table, returns the length.
+size_t format_int64(int64_t value, char *buffer); // Formats a signed 64-bit integer in decimal with a digit-pair table, returns the length.
+size_t format_double_shortest(double value, char *buffer); // Formats a double with the shortest digits that read back as the same value(Grisu2) in a "%g" layout, returns the length.
+/// \}
+
+
+
+
+
+// ------------- Helper Functions for Buffered Output -------------
+/// \{
+#define WRITER_DEFAULT_BUFFER_SIZE ((size_t)1 << 16) // Writers buffer 64 KiB unless told otherwise.
+
+typedef struct BufferedWriter BufferedWriter; // Large user-space output buffer flushed to a file descriptor('write'/'writev') or a 'FILE*'.
+
+BufferedWriter *writer_create_fd(int fd, size_t bufferSize); // Creates a writer for a file descriptor with a buffer of 'bufferSize' bytes(0 for the default).
+BufferedWriter *writer_create_file(FILE *file, size_t bufferSize); // Creates a writer for a stream, written through its descriptor after flushing it.
+bool writer_write(BufferedWriter *writer, const char *bytes, size_t length); // Appends bytes, writing runs larger than the buffer directly with 'writev'.
+bool writer_write_string(BufferedWriter *writer, const char *characterString); // Appends a NULL-terminated string.
+bool writer_write_double(BufferedWriter *writer, double value, int precision); // Appends a double with 'precision' significant digits, or the shortest round-trip digits if < 0.
+bool writer_write_int64(BufferedWriter *writer, int64_t value); // Appends a signed 64-bit integer in decimal.
+bool writer_flush(BufferedWriter *writer); // Writes the buffered bytes to the target.
+bool writer_destroy(BufferedWriter *writer); // Flushes and frees a writer, leaving its target open.
+/// \}
+
+
+
+
+
+
+// ------------- Helper Functions for Instrumentation -------------
+/// \{
+/**
+ * Opt-in counters for the library's major entry points and its allocations, compiled in only when 'UTILITIES_INSTRUMENTATION' is
+ * defined(e.g., '-DUTILITIES_INSTRUMENTATION'); otherwise the macros below expand to nothing and none of this code exists.
+ * Each thread counts into its own counters, which are merged when a snapshot is taken. A function's time is inclusive of the
+ * instrumented functions it calls.
+ */
+#ifdef UTILITIES_INSTRUMENTATION
+
+typedef enum InstrumentedFunction
+{
+	INSTRUMENT_PREPROCESS_STRING_ARRAY,
+	INSTRUMENT_PREPROCESS_STRING_ARRAY_PARALLEL,
+	INSTRUMENT_CONVERT_TO_UNIX_TIME,
+	INSTRUMENT_PARSE_DATE_TIME_FIELD,
+	INSTRUMENT_SPLIT_TOKENIZED_STRING,
+	INSTRUMENT_IDENTIFY_DELIMITER,
+	INSTRUMENT_MERGE_SORT,
+	INSTRUMENT_MERGE_SORT_PARALLEL,
+	INSTRUMENT_RADIX_SORT_DOUBLES,
+	INSTRUMENT_RADIX_SORT_DOUBLES_11BIT,
+	INSTRUMENT_RADIX_SORT_DOUBLES_PARALLEL,
+	INSTRUMENT_RADIX_SORT_KEY_VALUE,
+	INSTRUMENT_ARGSORT,
+	INSTRUMENT_RADIX_SORT_STRINGS,
+	INSTRUMENT_RADIX_SORT_STRINGS_STABLE,
+	INSTRUMENT_RADIX_SORT_STRINGS_PARALLEL,
+	INSTRUMENT_MULTIKEY_QUICKSORT_STRINGS,
+	INSTRUMENTED_FUNCTION_COUNT
+} InstrumentedFunction;
+
+typedef struct InstrumentationSnapshot
+{
+	uint64_t calls[INSTRUMENTED_FUNCTION_COUNT]; // Calls of each instrumented function.
+	uint64_t nanoseconds[INSTRUMENTED_FUNCTION_COUNT]; // Cumulative wall-clock time spent in each instrumented function.
+	uint64_t allocations; // Calls of 'utilities_malloc', 'utilities_calloc' and 'utilities_realloc'.
+	uint64_t bytesAllocated; // Bytes requested by those calls.
+} InstrumentationSnapshot;
+
+typedef struct InstrumentationScope
+{
+	InstrumentedFunction function;
+	uint64_t start;
+} InstrumentationScope;
+
+extern const char *instrumentedFunctionNames[INSTRUMENTED_FUNCTION_COUNT]; // The name of each instrumented function.
+
+InstrumentationScope instrumentation_scope_begin(InstrumentedFunction function); // Starts timing a call.
+void instrumentation_scope_end(InstrumentationScope *scope); // Counts a call and its time, run when the scope's variable goes out of scope.
+void instrumentation_count_allocation(size_t size); // Counts an allocation of 'size' bytes.
+void instrumentation_snapshot(InstrumentationSnapshot *snapshot); // Merges the counters of every thread, past and present.
+void instrumentation_reset(void); // Zeroes every counter.
+bool instrumentation_write_text(const InstrumentationSnapshot *snapshot, BufferedWriter *writer); // Writes a snapshot as a plain-text table.
+bool instrumentation_write_json(const InstrumentationSnapshot *snapshot, BufferedWriter *writer); // Writes a snapshot as a JSON object.
+
+#define INSTRUMENT_FUNCTION(function) InstrumentationScope instrumentationScope __attribute__((cleanup(instrumentation_scope_end))) = instrumentation_scope_begin(function) // Times the rest of the enclosing function.
+#define INSTRUMENT_ALLOCATION(size) instrumentation_count_allocation(size)
+
+#else
+
+#define INSTRUMENT_FUNCTION(function) ((void)0)
+#define INSTRUMENT_ALLOCATION(size) ((void)0)
+
+#endif
 /// \}
 
 
@@ -102,6 +435,29 @@ double max(double a, double b);  // Returns the maximum of two values.
 
 double min_element(double *data, int n); // Returns the minimum element in an array of values.
 double max_element(double *data, int n); // Returns the maximum element in an array of values.
+void minmax_element(const double *data, size_t n, double *minimum, double *maximum); // Finds the minimum and maximum non-NaN elements in a single pass.
+
+/**
+ * 'DescriptiveStatistics' struct: the summary 'describe' computes over the non-NaN values of an array. The minimum, maximum, mean and
+ * variances are NaN when there are no such values(and the sample variance with fewer than two). Infinite values make the sum and
+ * mean infinite(NaN when both signs occur) and the variances NaN.
+ */
+typedef struct DescriptiveStatistics
+{
+	size_t count; // Values that are not NaN.
+	size_t nanCount; // Values that are NaN.
+	double minimum;
+	double maximum;
+	double sum; // Compensated(Kahan) sum.
+	double mean;
+	double variance; // Population variance, from Welford's algorithm.
+	double sampleVariance; // Unbiased sample variance.
+} DescriptiveStatistics;
+
+#define DESCRIBE_PARALLEL_THRESHOLD ((size_t)1 << 18) // Arrays shorter than this are described on the calling thread.
+
+DescriptiveStatistics describe(const double *data, size_t n); // Computes count, NaN count, min, max, compensated sum, mean and variance in a single pass.
+DescriptiveStatistics describe_parallel(const double *data, size_t n, int numThreads); // Multi-threaded 'describe' for large arrays, a 'numThreads' <= 0 uses one thread per online processor.
 /// \}
 
 
@@ -111,6 +467,7 @@ double max_element(double *data, int n); // Returns the maximum element in an ar
 
 // ------------- Helper Functions for Operations with Time -------------
 /// \{
+time_t convert_tm_to_unix_time(const struct tm *tm); // Converts a broken-down local time into Unix time like 'mktime', arithmetically with a per-thread cache of daily UTC offsets.
 time_t convert_to_unix_time(const char *dateTimeString); // Converts a date/time string into Unix time.
 struct tm *thread_safe_localtime(const time_t *tim, struct tm *result); // A thread-safe wrapper around localtime.
 /// \}
@@ -125,6 +482,8 @@ struct tm *thread_safe_localtime(const time_t *tim, struct tm *result); // A thr
 uint64_t flip_sign_bit(uint64_t value); // Helper function to flip the sign bit of the double's binary representation.
 uint64_t double_to_uint64(double value); // Helper function to reinterpret a double as an uint64_t.
 double uint64_to_double(uint64_t value); // Helper function to reinterpret a uint64_t as an double.
+uint64_t double_to_sortable_key(double value); // Maps a double to a key whose unsigned integer order is the numeric order, NaNs last.
+double sortable_key_to_double(uint64_t key); // Inverts 'double_to_sortable_key'.
 /// \}
 
 
@@ -134,13 +493,48 @@ double uint64_to_double(uint64_t value); // Helper function to reinterpret a uin
 
 // ------------- Helper Functions for Sorting -------------
 /// \{
+#define MERGE_SORT_INSERTION_CUTOFF 32 // Runs of up to this many elements are insertion sorted.
+#define MERGE_SORT_PARALLEL_THRESHOLD ((size_t)1 << 16) // Runs shorter than this are sorted and merged on a single thread.
+#define RADIX_SORT_PARALLEL_THRESHOLD ((size_t)1 << 20) // Arrays shorter than this are radix sorted on a single thread.
+#define RADIX_SORT_MIN_ELEMENTS_PER_THREAD ((size_t)1 << 17) // The parallel radix sort gives no thread fewer elements.
+
 void merge_data(double *unsortedData, int left, int middle, int right); // Merges two sorted subarrays into a single sorted array.
-void merge_sort_data(double *unsortedData, int left, int right); // Recursively divides and sorts an array using the merge sort algorithm.
+void merge_sort_data(double *unsortedData, int left, int right); // Merge sorts unsortedData[left..right] with a single scratch buffer.
 void merge_sort(double *unsortedData, const int numElements); // Sorts an array of doubles using the merge sort algorithm.
+void merge_sort_parallel(double *unsortedData, const int numElements, int numThreads); // Multi-threaded stable merge sort that sorts halves concurrently and splits each merge across the threads.
 
 
 
-void radix_sort_doubles(double *unsortedData, const int numElements); // Sorts an array of double precision floating-point numbers by interpreting their bit patterns as unsigned 64-bit integers using Radix Sort.
+void radix_sort_doubles(double *unsortedData, const int numElements); // Stable LSD radix sort of an array of doubles over order-preserving 64-bit keys, 8 bits per pass.
+void radix_sort_doubles_11bit(double *unsortedData, const int numElements); // 'radix_sort_doubles' with 11-bit digits, 6 passes instead of 8.
+void radix_sort_doubles_parallel(double *unsortedData, const int numElements, int numThreads); // Multi-threaded 'radix_sort_doubles' with per-thread histograms and write-combining scatter.
+
+void radix_sort_key_value_double_u32(double *keys, uint32_t *payloads, size_t numElements); // Stable radix sort of double keys, permuting 32-bit payloads along with them.
+void radix_sort_key_value_double_u64(double *keys, uint64_t *payloads, size_t numElements); // Stable radix sort of double keys, permuting 64-bit payloads along with them.
+void radix_sort_key_value_int64_u32(int64_t *keys, uint32_t *payloads, size_t numElements); // Stable radix sort of int64_t keys, permuting 32-bit payloads along with them.
+void radix_sort_key_value_int64_u64(int64_t *keys, uint64_t *payloads, size_t numElements); // Stable radix sort of int64_t keys, permuting 64-bit payloads along with them.
+uint32_t *argsort_doubles(const double *values, size_t numElements); // Returns the stable permutation that sorts an array of doubles, freed with 'utilities_free'.
+uint32_t *argsort_int64(const int64_t *values, size_t numElements); // Returns the stable permutation that sorts an array of int64_t values, freed with 'utilities_free'.
+void gather_strings(char **destination, char *const *source, const uint32_t *permutation, size_t numElements); // Reorders string pointers by a permutation, destination[i] = source[permutation[i]].
+void gather_doubles(double *destination, const double *source, const uint32_t *permutation, size_t numElements); // Reorders a column of doubles by a permutation.
+void gather_int64(int64_t *destination, const int64_t *source, const uint32_t *permutation, size_t numElements); // Reorders a column of int64_t values by a permutation.
+
+
+
+void radix_sort_strings(char **unsortedStrings, const size_t numElements); // Sorts an array of strings with an in-place MSD radix sort over cached 8-byte key prefixes.
+void radix_sort_strings_stable(char **unsortedStrings, const size_t numElements); // Stable MSD radix sort of an array of strings, equal strings keep their original relative order.
+void radix_sort_strings_parallel(char **unsortedStrings, const size_t numElements, int numThreads); // Stable MSD radix sort of an array of strings that sorts the top-level buckets on multiple threads.
+void multikey_quicksort_strings(char **unsortedStrings, const size_t numElements); // Sorts an array of strings with a multikey(three-way radix) quicksort over cached 8-byte key prefixes.
+/// \}
+
+
+
+
+
+
+// ------------- Helper Functions for Multithreading -------------
+/// \{
+int resolve_thread_count(int requestedThreads); // Resolves a requested thread count, a value <= 0 selects the number of online processors.
 /// \}
 
 
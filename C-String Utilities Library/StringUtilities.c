@@ -3,9 +3,15 @@
 //  DavidRichardson02
 
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // Declares 'strptime' on glibc, which otherwise defaults to an 'int' return and truncates its pointer.
+#endif
 #include "StringUtilities.h"
 
 
+#define DATE_TIME_FIELD_BUFFER_SIZE 64 // Fields up to this length are NULL-terminated on the stack before being handed to 'strptime'.
+
+
 
 
 
@@ -113,6 +119,43 @@ bool char_is_delimiter(char c)
 
 
 
+/**
+ * ascii_to_lower
+ * Branch-free ASCII lower-case folding of a single byte, bytes outside 'A'..'Z' are returned unchanged.
+ */
+static inline unsigned char ascii_to_lower(unsigned char c)
+{
+	return c | ((unsigned char)(c - 'A') < 26) << 5; // 'A'..'Z' differ from 'a'..'z' only in bit 5.
+}
+
+
+/**
+ * char_to_lower_case
+ * Converts an ASCII upper-case letter to lower case.
+ *
+ * @param c The character to be converted.
+ * @return The lower-case equivalent of 'c' if it is an upper-case letter, 'c' unchanged otherwise.
+ */
+char char_to_lower_case(char c)
+{
+	return (char)ascii_to_lower((unsigned char)c);
+}
+
+
+/**
+ * char_to_upper_case
+ * Converts an ASCII lower-case letter to upper case.
+ *
+ * @param c The character to be converted.
+ * @return The upper-case equivalent of 'c' if it is a lower-case letter, 'c' unchanged otherwise.
+ */
+char char_to_upper_case(char c)
+{
+	return (char)((unsigned char)c & ~(((unsigned char)((unsigned char)c - 'a') < 26) << 5));
+}
+
+
+
 
 /**
  * string_is_numeric
@@ -168,6 +211,33 @@ bool string_is_hyphen_else_is_minus_sign(char *characterString)
 
 
 
+/**
+ * terminate_field
+ *
+ * Produces a NULL-terminated copy of a field known only as a pointer and a length, for the C library parsers('strptime')
+ * that need one. Fields that fit are copied into the caller's stack buffer, longer ones into a heap copy that is returned
+ * through 'heapCopy' and must be freed by the caller(it is set to NULL when the stack buffer was used).
+ */
+static const char *terminate_field(StringView field, char *buffer, size_t bufferSize, char **heapCopy)
+{
+	*heapCopy = NULL;
+	if (field.length < bufferSize)
+	{
+		copy_memory_block(buffer, field.characters, field.length);
+		buffer[field.length] = '\0';
+		return buffer;
+	}
+	
+	*heapCopy = duplicate_n_string(field.characters, field.length);
+	if (*heapCopy == NULL)
+	{
+		perror("\n\nError: Unable to allocate memory in 'terminate_field'.\n");
+		exit(1);
+	}
+	return *heapCopy;
+}
+
+
 /**
  * string_is_date_time
  *
@@ -194,19 +264,24 @@ int* string_is_date_time(const char *characterString, const char *delimiter, con
 	
 	
 	// Allocate memory to store results. Each element represents a field with a value indicating whether it matches a date/time format.
-	int *results = (int *)malloc(fieldCount * sizeof(int));
-	char *copyOfString = duplicate_string(characterString);     // Create a duplicate of the input string because 'duplicate_string' modifies the string it processes.
-	
-	// Tokenize the duplicated string using the provided delimiter.
-	char *token = tokenize_string(copyOfString, delimiter);
+	// Fields beyond the number of tokens in the string are reported as 0.
+	int *results = (int *)utilities_calloc(fieldCount > 0 ? fieldCount : 1, sizeof(int));
+	if (results == NULL){ perror("\n\nError: Unable to allocate memory in 'string_is_date_time'.\n");      exit(1); }
+	
+	// Tokenize the string using the provided delimiter, the tokenizer leaves the input untouched so no duplicate is needed.
+	StringTokenizer tokenizer;
+	StringView token;
+	string_tokenizer_init(&tokenizer, characterString, string_length(characterString), delimiter, true);
 	int index = 0; // Index for tracking current field.
 	
 	
-	// Iterate over each token(field) in the string.
-	while (token != NULL)
+	// Iterate over each token(field) in the string, never writing past the 'fieldCount' results.
+	while (index < fieldCount && string_tokenizer_next(&tokenizer, &token))
 	{
 		struct tm tm; // Holds the parsed date/time values.
-		bool foundDateTime = false; // Flag to indicate if a date/time format is found.
+		char fieldBuffer[DATE_TIME_FIELD_BUFFER_SIZE]; // NULL-terminated copy of the field for 'strptime'.
+		char *heapCopy;
+		const char *field = terminate_field(token, fieldBuffer, sizeof(fieldBuffer), &heapCopy);
 		
 		
 		// Iterate over the common date/time formats.
@@ -216,7 +291,7 @@ int* string_is_date_time(const char *characterString, const char *delimiter, con
 			set_memory_block(&tm, 0, sizeof(struct tm));
 			
 			// Parse the current field(token) using the current format.
-			char *parsed = strptime(token, commonDateTimeFormats[i], &tm);
+			char *parsed = strptime(field, commonDateTimeFormats[i], &tm);
 			
 			
 			
@@ -224,23 +299,14 @@ int* string_is_date_time(const char *characterString, const char *delimiter, con
 			if (parsed != NULL && *parsed == '\0')
 			{
 				results[index] = 1;  // Field matches a date/time format from 'commonDateTimeFormats', set the corresponding index in results to 1.
-				foundDateTime = true;
 				break;
 			}
 		}
-		
-		
-		if (foundDateTime == false) // If no date/time format matched, set the corresponding index in results to 0.
-		{
-			results[index] = 0; // Field does not match a date/time format from 'commonDateTimeFormats'
-		}
+		utilities_free(heapCopy);
 		
 		// Increment the index and move to the next field(token) in the string.
 		index++;
-		token = tokenize_string(NULL, delimiter);
 	}
-	// Cleanup
-	free(copyOfString);
 	
 	
 	return results; // Return the results array.
@@ -264,7 +330,7 @@ int* string_is_date_time(const char *characterString, const char *delimiter, con
  */
 bool string_array_contains_date_time(char **stringArray, int stringCount, const char *delimiter)
 {
-	for (size_t i = 0; i < stringCount; i++)
+	for (int i = 0; i < stringCount; i++)
 	{
 		// Split the string into fields and count them
 		int fieldCount = 1;
@@ -287,12 +353,12 @@ bool string_array_contains_date_time(char **stringArray, int stringCount, const
 		{
 			if (dateTimeResults[j] == 1)
 			{
-				free(dateTimeResults);
+				utilities_free(dateTimeResults);
 				return true; // A date/time format was found
 			}
 		}
 		
-		free(dateTimeResults);
+		utilities_free(dateTimeResults);
 	}
 	
 	return false; // No date/time format was found in any string
@@ -467,7 +533,7 @@ char *find_potential_delimiters(const char *characterString, int *delimiterCount
 	
 	int ascii[256] = {0}; // Initialize an ASCII array to zero
 	int maxCount = 0;
-	char *delimiters = malloc(256); // Allocate memory to store potential delimiters.
+	char *delimiters = utilities_malloc(256); // Allocate memory to store potential delimiters.
 	
 	
 	/// Iterate over each character of the string.
@@ -525,6 +591,7 @@ char *find_potential_delimiters(const char *characterString, int *delimiterCount
  */
 char *identify_delimiter(char** stringArray, int stringCount)
 {
+	INSTRUMENT_FUNCTION(INSTRUMENT_IDENTIFY_DELIMITER);
 	if (stringArray == NULL || stringCount <= 0)
 	{
 		perror("\n\nError: stringArray was NULL in 'identify_delimiter'.\n");
@@ -551,7 +618,7 @@ char *identify_delimiter(char** stringArray, int stringCount)
 		{
 			delimitersCounts[(unsigned char)delimiters[j]]++;
 		}
-		free(delimiters); // Free the memory allocated for delimiters
+		utilities_free(delimiters); // Free the memory allocated for delimiters
 	}
 	
 	
@@ -573,7 +640,7 @@ char *identify_delimiter(char** stringArray, int stringCount)
 	/// If a most common delimiter was found, return it. Otherwise, return '\0'.
 	if (mostCommonDelimiter != '\0')
 	{
-		char *identifiedDelimiter = (char*)malloc(2 * sizeof(char));//allocate_memory_char_ptr(2);
+		char *identifiedDelimiter = (char*)utilities_malloc(2 * sizeof(char));//allocate_memory_char_ptr(2);
 		identifiedDelimiter[0] = mostCommonDelimiter;
 		identifiedDelimiter[1] = '\0';
 		return identifiedDelimiter;
@@ -652,7 +719,7 @@ char *identify_delimiter_recursive(char** stringArray, int stringCount, char **p
 			}
 		}
 		/// Free the memory allocated for the potential delimiters.
-		free(delimiters);
+		utilities_free(delimiters);
 	}
 	
 	/// Find the most common non-primary delimiter.
@@ -671,7 +738,7 @@ char *identify_delimiter_recursive(char** stringArray, int stringCount, char **p
 	/// If a most common non-primary delimiter was found, return it. Otherwise, return a null character.
 	if (mostCommonDelimiter != '\0')
 	{
-		char *identifiedDelimiter = (char*)malloc(2 * sizeof(char));//= allocate_memory_char_ptr(2);
+		char *identifiedDelimiter = (char*)utilities_malloc(2 * sizeof(char));//= allocate_memory_char_ptr(2);
 		identifiedDelimiter[0] = mostCommonDelimiter;
 		identifiedDelimiter[1] = '\0';
 		return identifiedDelimiter;
@@ -731,320 +798,685 @@ const char* determine_string_representation_type(const char* token)
 
 
 
-
 /**
- * duplicate_string
+ * twoway_find_substring
  *
- * This function duplicates a string by allocating memory for a new string and copying the contents of the original string.
- * The duplicated string is a deep copy, and the caller is responsible for freeing the memory allocated for the new string.
+ * Crochemore-Perrin Two-Way string matching over an explicit-length haystack. The needle is split at a critical
+ * factorization(computed from its maximal suffixes under both byte orderings), the right half is matched left to right
+ * and the left half right to left, and the known period of the needle is used to skip ahead without ever re-examining
+ * more than a constant number of haystack bytes. This gives O(n + m) time in the worst case with O(1) extra state, which is
+ * why 'find_substring_n' falls back to it when its SIMD prefilter produces too many false candidates.
+ * With 'ignoreCase' set every byte is folded to ASCII lower case as it is read, which serves 'find_substring_nocase_n'.
  *
- * @param characterString The string to be duplicated.
- * @return A pointer to the duplicated string, or NULL if memory allocation fails.
+ * @param haystack The bytes to be searched.
+ * @param haystackEnd One past the last byte of the haystack.
+ * @param needle The bytes to search for.
+ * @param needleLength The number of bytes in the needle, at least 1.
+ * @param ignoreCase Whether ASCII letters compare equal regardless of case.
+ * @return A pointer to the first occurrence of the needle, or NULL if there is none.
  */
-char *duplicate_string(const char *characterString)
+static const unsigned char *twoway_find_substring(const unsigned char *haystack, const unsigned char *haystackEnd, const unsigned char *needle, size_t needleLength, bool ignoreCase)
 {
-	if (characterString == NULL)
+#define FOLD(x) (ignoreCase ? ascii_to_lower(x) : (x))
+	size_t i, ip, jp, k, p, maximalSuffix, period0, memory, memory0;
+	size_t byteSet[256 / (8 * sizeof(size_t))] = {0}; // Bitset of the bytes present in the needle.
+	size_t shift[256]; // For each byte in the needle, one past its last position.
+	
+	
+	for (i = 0; i < needleLength; i++)
 	{
-		return NULL; // Return NULL if the input string is NULL
+		unsigned char c = FOLD(needle[i]);
+		byteSet[c / (8 * sizeof(size_t))] |= (size_t)1 << (c % (8 * sizeof(size_t)));
+		shift[c] = i + 1;
 	}
 	
-	size_t length = string_length(characterString) + 1; // Calculate the length of the string including the null terminator
-	char *dup = (char *)malloc(length); // Allocate memory for the duplicated string
 	
-	if (dup == NULL)
+	/// Compute the maximal suffix and its period under the '<' ordering, 'ip' starts at -1 and relies on unsigned wrap-around.
+	ip = (size_t)-1; jp = 0; k = p = 1;
+	while (jp + k < needleLength)
 	{
-		return NULL; // Return NULL if memory allocation fails
+		if (FOLD(needle[ip + k]) == FOLD(needle[jp + k]))
+		{
+			if (k == p) { jp += p; k = 1; }
+			else { k++; }
+		}
+		else if (FOLD(needle[ip + k]) > FOLD(needle[jp + k]))
+		{
+			jp += k; k = 1; p = jp - ip;
+		}
+		else
+		{
+			ip = jp++; k = p = 1;
+		}
 	}
+	maximalSuffix = ip;
+	period0 = p;
 	
-	copy_memory_block(dup, characterString, length); // Copy the original string to the newly allocated memory
-	return dup; // Return the pointer to the duplicated string
+	
+	/// Repeat under the '>' ordering and keep the later of the two suffixes, which yields a critical factorization.
+	ip = (size_t)-1; jp = 0; k = p = 1;
+	while (jp + k < needleLength)
+	{
+		if (FOLD(needle[ip + k]) == FOLD(needle[jp + k]))
+		{
+			if (k == p) { jp += p; k = 1; }
+			else { k++; }
+		}
+		else if (FOLD(needle[ip + k]) < FOLD(needle[jp + k]))
+		{
+			jp += k; k = 1; p = jp - ip;
+		}
+		else
+		{
+			ip = jp++; k = p = 1;
+		}
+	}
+	if (ip + 1 > maximalSuffix + 1)
+	{
+		maximalSuffix = ip;
+	}
+	else
+	{
+		p = period0;
+	}
+	
+	
+	/// Determine whether the needle is periodic, i.e., whether its left half repeats 'p' bytes later.
+	bool periodic = true;
+	for (i = 0; i < maximalSuffix + 1; i++)
+	{
+		if (FOLD(needle[i]) != FOLD(needle[i + p]))
+		{
+			periodic = false;
+			break;
+		}
+	}
+	if (periodic)
+	{
+		memory0 = needleLength - p;
+	}
+	else
+	{
+		memory0 = 0;
+		p = (maximalSuffix > needleLength - maximalSuffix - 1 ? maximalSuffix : needleLength - maximalSuffix - 1) + 1;
+	}
+	memory = 0;
+	
+	
+	/// Search loop.
+	for (;;)
+	{
+		if ((size_t)(haystackEnd - haystack) < needleLength)
+		{
+			return NULL;
+		}
+		
+		
+		// Check the last byte of the window first and use the shift table to skip on a mismatch.
+		unsigned char lastByte = FOLD(haystack[needleLength - 1]);
+		if (byteSet[lastByte / (8 * sizeof(size_t))] & ((size_t)1 << (lastByte % (8 * sizeof(size_t)))))
+		{
+			k = needleLength - shift[lastByte];
+			if (k)
+			{
+				if (k < memory) k = memory;
+				haystack += k;
+				memory = 0;
+				continue;
+			}
+		}
+		else
+		{
+			haystack += needleLength;
+			memory = 0;
+			continue;
+		}
+		
+		
+		// Compare the right half.
+		for (k = (maximalSuffix + 1 > memory ? maximalSuffix + 1 : memory); k < needleLength && FOLD(needle[k]) == FOLD(haystack[k]); k++);
+		if (k < needleLength)
+		{
+			haystack += k - maximalSuffix;
+			memory = 0;
+			continue;
+		}
+		
+		// Compare the left half.
+		for (k = maximalSuffix + 1; k > memory && FOLD(needle[k - 1]) == FOLD(haystack[k - 1]); k--);
+		if (k <= memory)
+		{
+			return haystack;
+		}
+		haystack += p;
+		memory = memory0;
+	}
+#undef FOLD
 }
 
 
-
-
 /**
- * copy_string
+ * find_byte_n
  *
- * This function copies the string pointed to by src, including the null terminator,
- * to the buffer pointed to by dest. The destination buffer must be large enough to
- * receive the copied string.
+ * Finds the first occurrence of the byte 'c' within the first 'length' bytes of 'characters', 16 bytes at a time.
  *
- * @param destination The destination buffer where the string will be copied.
- * @param source The source string to be copied.
- * @return A pointer to the destination string.
+ * @return A pointer to the first occurrence, or NULL if there is none.
  */
-char *copy_string(char *destination, const char *source)
+static const unsigned char *find_byte_n(const unsigned char *characters, size_t length, unsigned char c)
 {
-	char *dest_start = destination; // Save the start of destination buffer
-	
-	//while ((*destination++ = *source++) != '\0'); // Copy each character from source to destination including the null terminator
-	while ((*destination++ = *source++)); // Copy each character from src to dest, including the null terminator
-	
-	return dest_start; // Return the start of the destination buffer
+	size_t i = 0;
+	for (; i + 16 <= length; i += 16)
+	{
+		uint32_t mask = simd_equal_mask16(characters + i, c);
+		if (mask)
+		{
+			return characters + i + __builtin_ctz(mask);
+		}
+	}
+	for (; i < length; i++)
+	{
+		if (characters[i] == c)
+		{
+			return characters + i;
+		}
+	}
+	return NULL;
 }
 
 
-
-
 /**
- * copy_n_string
+ * find_substring_n
  *
- * This function copies up to 'n' characters from the source string to the destination string.
- * If the length of the source string is less than 'n', the remainder of the destination string is padded with null characters.
- * The destination string must be large enough to receive the copy.
+ * Finds the first occurrence of a needle within an explicit-length haystack, neither needs to be NULL-terminated.
  *
- * @param destination The destination buffer where the content is to be copied.
- * @param source The source null-terminated string to be copied.
- * @param n The maximum number of characters to copy from source to destination.
- * @return A pointer to the destination string.
+ * Candidate positions are found 16 at a time by comparing the first byte of the needle against the haystack and the last
+ * byte of the needle against the haystack shifted by 'needleLength - 1', so a position is only verified when both of its ends
+ * already match. The bytes compared during verification are tracked, and if they exceed a constant multiple of the bytes
+ * scanned(which only happens on adversarial, highly repetitive inputs) the search continues with the Two-Way algorithm,
+ * so the worst case remains linear in the length of the haystack.
+ *
+ * @param haystack The string to be searched.
+ * @param haystackLength The number of bytes in the haystack.
+ * @param needle The string to search for.
+ * @param needleLength The number of bytes in the needle.
+ * @return A pointer to the first occurrence of the needle in the haystack, the haystack itself for an empty needle, or NULL if there is none.
  */
-char *copy_n_string(char *destination, const char *source, size_t n)
+char *find_substring_n(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength)
 {
-	char *dest_start = destination; // Save the start of the destination buffer
+	// Check for NULL input and handle error.
+	if (haystack == NULL || needle == NULL){ perror("\n\nError: haystack and/or needle was NULL in 'find_substring_n'.\n");      return NULL; }
 	
+	if (needleLength == 0)
+	{
+		return (char *)haystack;
+	}
+	if (needleLength > haystackLength)
+	{
+		return NULL;
+	}
 	
-	// Copy up to n characters from source to destination
-	while (n > 0 && (*source != '\0'))
+	const unsigned char *h = (const unsigned char *)haystack;
+	const unsigned char *n = (const unsigned char *)needle;
+	if (needleLength == 1)
 	{
-		*destination++ = *source++;
-		n--;
+		return (char *)find_byte_n(h, haystackLength, n[0]);
 	}
 	
 	
-	// Null-pad the remaining bytes
-	while (n > 0)
+	const size_t lastStart = haystackLength - needleLength; // The last position at which the needle can start.
+	const unsigned char firstByte = n[0];
+	const unsigned char lastByte = n[needleLength - 1];
+	size_t verificationWork = 0;
+	size_t i = 0;
+	
+	
+	/// Scan 16 candidate start positions per iteration while both loads stay inside the haystack.
+	for (; i + 15 <= lastStart; i += 16)
 	{
-		*destination++ = '\0';
-		n--;
+		uint32_t candidates = simd_equal_mask16(h + i, firstByte) & simd_equal_mask16(h + i + needleLength - 1, lastByte);
+		while (candidates)
+		{
+			size_t position = i + __builtin_ctz(candidates);
+			size_t k = 1;
+			while (k < needleLength - 1 && h[position + k] == n[k])
+			{
+				k++;
+			}
+			if (k >= needleLength - 1)
+			{
+				return (char *)(h + position);
+			}
+			verificationWork += k;
+			candidates &= candidates - 1;
+		}
+		
+		
+		// Too many false candidates, switch to the linear-time algorithm for the remainder of the haystack.
+		if (verificationWork > 4 * (i + 16) + 256)
+		{
+			return (char *)twoway_find_substring(h + i + 16, h + haystackLength, n, needleLength, false);
+		}
 	}
 	
-	return dest_start; // Return the start of the destination buffer
+	
+	/// Check the remaining (fewer than 16) start positions one at a time.
+	for (; i <= lastStart; i++)
+	{
+		if (h[i] == firstByte && h[i + needleLength - 1] == lastByte)
+		{
+			size_t k = 1;
+			while (k < needleLength - 1 && h[i + k] == n[k])
+			{
+				k++;
+			}
+			if (k >= needleLength - 1)
+			{
+				return (char *)(h + i);
+			}
+		}
+	}
+	return NULL;
 }
 
 
-
-
 /**
- * concatenate_string
+ * find_substring
  *
- * This function concatenates the source string to the destination string.
- * The destination string must have enough space to hold the concatenated result.
+ * Finds the first occurrence of 'substring' within 'characterString', the NULL-terminated counterpart of 'find_substring_n'
+ * (and a drop-in replacement for the standard 'strstr').
  *
- * @param destination The destination string to which the source string will be concatenated.
- * @param source The source string to be concatenated.
- * @return A pointer to the destination string.
+ * @param characterString The string to be searched.
+ * @param substring The string to search for.
+ * @return A pointer to the first occurrence of 'substring' in 'characterString', 'characterString' itself for an empty substring, or NULL if there is none.
  */
-char *concatenate_string(char *destination, const char *source)
+char *find_substring(const char *characterString, const char *substring)
 {
-	char *dest_start = destination; // Save the start of destination buffer
-	
-	// Move dest to the end of the current string
-	while (*destination)
-	{
-		destination++;
-	}
-	
-	// Copy each character from source to destination, including the null terminator
-	while ((*destination++ = *source++));
+	// Check for NULL input and handle error.
+	if (characterString == NULL || substring == NULL){ perror("\n\nError: characterString and/or substring was NULL in 'find_substring'.\n");      return NULL; }
 	
-	return dest_start; // Return the start of the destination buffer
+	return find_substring_n(characterString, string_length(characterString), substring, string_length(substring));
 }
 
 
 
 
-
+/**
+ * folded_equal_mask16
+ *
+ * Folds 16 bytes starting at 'block' to ASCII lower case and compares them against the (already folded) byte 'c',
+ * returning a mask with bit i set when block[i] matches 'c' regardless of case.
+ */
+static inline uint32_t folded_equal_mask16(const unsigned char *block, unsigned char c)
+{
+#if defined(SIMD_SSE2_AVAILABLE)
+	__m128i bytes = _mm_loadu_si128((const __m128i *)block);
+	__m128i isUpper = _mm_cmplt_epi8(_mm_add_epi8(bytes, _mm_set1_epi8((char)(128 - 'A'))), _mm_set1_epi8((char)(-128 + 26)));
+	__m128i folded = _mm_or_si128(bytes, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(folded, _mm_set1_epi8((char)c)));
+#elif defined(SIMD_NEON_AVAILABLE)
+	uint8x16_t bytes = vld1q_u8(block);
+	uint8x16_t isUpper = vcltq_u8(vsubq_u8(bytes, vdupq_n_u8('A')), vdupq_n_u8(26));
+	uint8x16_t folded = vorrq_u8(bytes, vandq_u8(isUpper, vdupq_n_u8(0x20)));
+	return neon_movemask(vceqq_u8(folded, vdupq_n_u8(c)));
+#else
+	uint32_t mask = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		mask |= (uint32_t)(ascii_to_lower(block[i]) == c) << i;
+	}
+	return mask;
+#endif
+}
 
 
 /**
- * concatenate_n_string
+ * find_substring_nocase_n
  *
- * Appends at most 'n' characters from the source string to the destination string,
- * and then appends a null terminator. The destination string must have enough space
- * to hold the resulting concatenated string.
+ * Case-insensitive(ASCII) counterpart of 'find_substring_n'. The haystack is folded to lower case 16 bytes at a time inside
+ * the first/last-byte prefilter and candidate positions are verified by folding each byte as it is compared, so neither the
+ * haystack nor the needle is ever copied. The search falls back to a case-folding Two-Way search on adversarial inputs.
  *
- * @param destination The destination string to which the source string will be concatenated.
- * @param source The source string to be concatenated.
- * @param n The maximum number of characters to concatenate from the source string.
- * @return A pointer to the destination string.
+ * @param haystack The string to be searched.
+ * @param haystackLength The number of bytes in the haystack.
+ * @param needle The string to search for.
+ * @param needleLength The number of bytes in the needle.
+ * @return A pointer to the first case-insensitive occurrence of the needle in the haystack, the haystack itself for an empty needle, or NULL if there is none.
  */
-char *concatenate_n_string(char *destination, const char *source, size_t n)
+char *find_substring_nocase_n(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength)
 {
-	char *dest_start = destination; // Save the start of destination buffer
+	// Check for NULL input and handle error.
+	if (haystack == NULL || needle == NULL){ perror("\n\nError: haystack and/or needle was NULL in 'find_substring_nocase_n'.\n");      return NULL; }
 	
-	// Move destination to the end of the current string
-	while (*destination)
+	if (needleLength == 0)
 	{
-		destination++;
+		return (char *)haystack;
+	}
+	if (needleLength > haystackLength)
+	{
+		return NULL;
 	}
 	
-	// Copy up to 'n' characters from source to destination
-	while (n-- > 0 && *source)
+	
+	const unsigned char *h = (const unsigned char *)haystack;
+	const unsigned char *n = (const unsigned char *)needle;
+	const size_t lastStart = haystackLength - needleLength;
+	const unsigned char firstByte = ascii_to_lower(n[0]);
+	const unsigned char lastByte = ascii_to_lower(n[needleLength - 1]);
+	size_t verificationWork = 0;
+	size_t i = 0;
+	
+	
+	/// Scan 16 candidate start positions per iteration while both loads stay inside the haystack.
+	for (; i + 15 <= lastStart; i += 16)
 	{
-		*destination++ = *source++;
+		uint32_t candidates = folded_equal_mask16(h + i, firstByte) & folded_equal_mask16(h + i + needleLength - 1, lastByte);
+		while (candidates)
+		{
+			size_t position = i + __builtin_ctz(candidates);
+			size_t k = 1;
+			while (k < needleLength - 1 && ascii_to_lower(h[position + k]) == ascii_to_lower(n[k]))
+			{
+				k++;
+			}
+			if (k >= needleLength - 1)
+			{
+				return (char *)(h + position);
+			}
+			verificationWork += k;
+			candidates &= candidates - 1;
+		}
+		
+		
+		// Too many false candidates, switch to the linear-time algorithm for the remainder of the haystack.
+		if (verificationWork > 4 * (i + 16) + 256)
+		{
+			return (char *)twoway_find_substring(h + i + 16, h + haystackLength, n, needleLength, true);
+		}
 	}
 	
-	// Null-terminate the destination string
-	*destination = '\0';
 	
-	return dest_start; // Return the start of the destination buffer
+	/// Check the remaining (fewer than 16) start positions one at a time.
+	for (; i <= lastStart; i++)
+	{
+		size_t k = 0;
+		while (k < needleLength && ascii_to_lower(h[i + k]) == ascii_to_lower(n[k]))
+		{
+			k++;
+		}
+		if (k == needleLength)
+		{
+			return (char *)(h + i);
+		}
+	}
+	return NULL;
 }
 
 
+/**
+ * find_substring_nocase
+ *
+ * Finds the first case-insensitive(ASCII) occurrence of 'substring' within 'characterString', the NULL-terminated counterpart
+ * of 'find_substring_nocase_n'.
+ *
+ * @param characterString The string to be searched.
+ * @param substring The string to search for.
+ * @return A pointer to the first occurrence of 'substring' in 'characterString', 'characterString' itself for an empty substring, or NULL if there is none.
+ */
+char *find_substring_nocase(const char *characterString, const char *substring)
+{
+	// Check for NULL input and handle error.
+	if (characterString == NULL || substring == NULL){ perror("\n\nError: characterString and/or substring was NULL in 'find_substring_nocase'.\n");      return NULL; }
+	
+	return find_substring_nocase_n(characterString, string_length(characterString), substring, string_length(substring));
+}
 
 
 
 
+/**
+ * MultiPatternMatcher
+ *
+ * A compiled Aho-Corasick automaton. The trie of the patterns is completed into a full deterministic automaton, so every
+ * text byte costs exactly one table lookup regardless of how many patterns there are. Each state records the pattern that ends
+ * at it(if any) and a link to the nearest proper suffix state that also ends a pattern, so overlapping matches are reported
+ * without walking failure links during the scan.
+ */
+struct MultiPatternMatcher
+{
+	int32_t *transitions; // 'stateCount' rows of 256 next-state entries.
+	int32_t *outputPattern; // Per state, the index of the pattern ending at that state, or -1.
+	int32_t *outputLink; // Per state, the nearest suffix state with an output, or -1.
+	size_t *patternLengths; // Per pattern, its length, used to turn end positions into start offsets.
+	int stateCount;
+	int patternCount;
+	unsigned char firstBytes[4]; // The distinct first bytes of the patterns, used to skip through the text while in the root state.
+	int firstByteCount; // The number of entries in 'firstBytes', or -1 if there are more than 4 and the root skip is disabled.
+};
 
 
 /**
- * determine_most_common_string
+ * multi_pattern_matcher_create
  *
- * This function determines the most frequently occurring string in a given array of strings.
- * It returns a pointer to a new memory location containing the most common string from the array.
- * If the array is empty or stringCount is less than or equal to 0, it returns NULL.
+ * Compiles an Aho-Corasick automaton for a set of patterns so they can be searched for simultaneously, in a single pass
+ * over each text, with 'multi_pattern_matcher_find_all'. The automaton is compiled once and is read-only afterwards, so it can be
+ * shared between threads and reused across any number of rows. Empty patterns are ignored, and if a pattern occurs more than
+ * once in the array its matches are reported under its lowest index.
  *
- * @note This function uses two arrays to keep track of each unique string and its frequency in the array.
- *       It iterates over each string in the given array and checks if it is already present in the unique strings array.
- *       If present, it increments the count of that string in the counts array, otherwise, it adds the string to the unique strings array and sets its count to 1.
- *       It also keeps track of the string with the maximum count.
+ * @note The automaton uses 1 KiB per state, with at most one state per pattern byte, so it is intended for marker and keyword sets
+ *       rather than for dictionaries of many thousands of long patterns.
  *
- * @param stringArray This is a pointer to an array of pointers to strings. Each element in this array points to a string.
- * @param stringCount The number of strings in the array.
- * @return The most common string in the array.
+ * @param patterns The array of NULL-terminated patterns.
+ * @param patternCount The number of patterns in the array.
+ * @return A pointer to the compiled matcher, to be released with 'multi_pattern_matcher_destroy'.
  */
-char* determine_most_common_string(char **stringArray, int stringCount)
+MultiPatternMatcher *multi_pattern_matcher_create(const char **patterns, int patternCount)
 {
-	// Check if the count is less than or equal to 0. If so, return NULL.
-	if(stringCount <= 0)
+	// Check for NULL input and handle error.
+	if (patterns == NULL || patternCount < 0){ perror("\n\nError: patterns was NULL in 'multi_pattern_matcher_create'.\n");      exit(1); }
+	
+	
+	/// Allocate the matcher with room for the worst case of one state per pattern byte plus the root.
+	size_t maxStates = 1;
+	for (int i = 0; i < patternCount; i++)
 	{
-		return NULL;
+		maxStates += string_length(patterns[i]);
 	}
 	
-	// Allocate memory for two arrays: one to store unique strings and another to store their counts.
-	char **uniqueStrings = (char**)calloc(stringCount, sizeof(char*));
-	int *counts = (int*)calloc(stringCount, sizeof(int));
-	int maxCount = 0, maxIndex = 0;
+	MultiPatternMatcher *matcher = (MultiPatternMatcher *)utilities_malloc(sizeof(MultiPatternMatcher));
+	int32_t *transitions = (int32_t *)utilities_malloc(maxStates * 256 * sizeof(int32_t));
+	int32_t *outputPattern = (int32_t *)utilities_malloc(maxStates * sizeof(int32_t));
+	int32_t *outputLink = (int32_t *)utilities_malloc(maxStates * sizeof(int32_t));
+	int32_t *failure = (int32_t *)utilities_malloc(maxStates * sizeof(int32_t));
+	int32_t *queue = (int32_t *)utilities_malloc(maxStates * sizeof(int32_t));
+	size_t *patternLengths = (size_t *)utilities_malloc((patternCount + 1) * sizeof(size_t));
+	if (matcher == NULL || transitions == NULL || outputPattern == NULL || outputLink == NULL || failure == NULL || queue == NULL || patternLengths == NULL)
+	{
+		perror("\n\nError: Unable to allocate memory in 'multi_pattern_matcher_create'.\n");
+		exit(1);
+	}
+	set_memory_block(transitions, 0xFF, maxStates * 256 * sizeof(int32_t)); // Every byte 0xFF gives -1, meaning "no trie edge".
 	
-	// Iterate over each string in the given array to find unique strings and count their occurrences.
-	for(int i = 0; i < stringCount; i++)
+	
+	/// Step 1: Build the trie of the patterns.
+	int stateCount = 1;
+	outputPattern[0] = -1;
+	bool hasFirstByte[256] = {false};
+	for (int i = 0; i < patternCount; i++)
 	{
-		int j;
+		const unsigned char *pattern = (const unsigned char *)patterns[i];
+		patternLengths[i] = string_length(patterns[i]);
+		if (patternLengths[i] == 0)
+		{
+			continue;
+		}
+		hasFirstByte[pattern[0]] = true;
 		
-		// If the string is already present in the unique strings array increment its count in the counts array.
-		for(j = 0; j < i; j++)
+		int32_t state = 0;
+		for (size_t k = 0; k < patternLengths[i]; k++)
 		{
-			// If the string is present, increment its count, done to keep track of the frequency of each unique string.
-			if(uniqueStrings[j] != NULL && compare_strings(stringArray[i], uniqueStrings[j]) == 0)
+			int32_t *edge = &transitions[(size_t)state * 256 + pattern[k]];
+			if (*edge < 0)
 			{
-				counts[j]++;
-				
-				// If the count of the current string is greater than maxCount, update maxCount and maxIndex, done to keep track of the most common string as the array is processed.
-				if(counts[j] > maxCount)
-				{
-					maxCount = counts[j];
-					maxIndex = j;
-				}
-				break;
+				*edge = stateCount;
+				outputPattern[stateCount] = -1;
+				stateCount++;
 			}
+			state = *edge;
 		}
-		
-		
-		// If the string is not present in the unique strings array, add it to the array and set its count to 1, done to keep track of the frequency of each unique string.
-		if(j == i)
+		if (outputPattern[state] < 0)
 		{
-			uniqueStrings[i] = stringArray[i];
-			counts[i] = 1;
+			outputPattern[state] = i;
 		}
 	}
 	
-	// Allocate for the most common string and copy it to this location.
-	char* mostCommonString = duplicate_string(uniqueStrings[maxIndex]);
 	
-	// Cleanup.
-	free(uniqueStrings);
-	free(counts);
+	/// Step 2: Breadth-first traversal computing failure links, output links and the completed transitions.
+	size_t head = 0, tail = 0;
+	failure[0] = 0;
+	outputLink[0] = -1;
+	for (int c = 0; c < 256; c++)
+	{
+		int32_t child = transitions[c];
+		if (child < 0)
+		{
+			transitions[c] = 0; // Missing edges out of the root loop back to the root.
+		}
+		else
+		{
+			failure[child] = 0;
+			outputLink[child] = -1;
+			queue[tail++] = child;
+		}
+	}
+	while (head < tail)
+	{
+		int32_t state = queue[head++];
+		int32_t *row = &transitions[(size_t)state * 256];
+		const int32_t *failureRow = &transitions[(size_t)failure[state] * 256];
+		for (int c = 0; c < 256; c++)
+		{
+			if (row[c] < 0)
+			{
+				row[c] = failureRow[c]; // Borrow the transition of the failure state, which is already complete.
+			}
+			else
+			{
+				int32_t child = row[c];
+				failure[child] = failureRow[c];
+				outputLink[child] = outputPattern[failure[child]] >= 0 ? failure[child] : outputLink[failure[child]];
+				queue[tail++] = child;
+			}
+		}
+	}
 	
-	return mostCommonString; // Return the most common string.
+	
+	/// Step 3: Record the first bytes of the patterns for the root-state skip.
+	matcher->firstByteCount = 0;
+	for (int c = 0; c < 256; c++)
+	{
+		if (hasFirstByte[c])
+		{
+			if (matcher->firstByteCount == 4)
+			{
+				matcher->firstByteCount = -1;
+				break;
+			}
+			matcher->firstBytes[matcher->firstByteCount++] = (unsigned char)c;
+		}
+	}
+	
+	
+	utilities_free(failure);
+	utilities_free(queue);
+	matcher->transitions = transitions;
+	matcher->outputPattern = outputPattern;
+	matcher->outputLink = outputLink;
+	matcher->patternLengths = patternLengths;
+	matcher->stateCount = stateCount;
+	matcher->patternCount = patternCount;
+	return matcher;
 }
 
 
-
-
 /**
- * compare_strings
+ * multi_pattern_matcher_find_all
  *
- * Performs a binary comparison of the characters of the two strings and returns an integer value based on the
- * comparison result(0 if equal, -1 if less than, 1 if greater than).
- * This function compares two character strings for equality, returning an integer value
- * indicating the difference between the first non-matching characters in the strings.
- * It is designed to handle unaligned memory access and optimize the comparison process
- * by comparing aligned memory blocks of the strings.
+ * Runs a compiled matcher over a text and reports every occurrence of every pattern, including overlapping ones, ordered by
+ * the position at which they end(and, for matches ending at the same position, longest first). While the automaton is in its
+ * root state and the patterns begin with at most 4 distinct bytes, the text is skipped 16 bytes at a time to the next possible pattern start.
  *
- * @param characterString1 The first character string to compare.
- * @param characterString2 The second character string to compare.
- * @return An integer value indicating the difference between the first non-matching characters.
+ * @param matcher The matcher compiled by 'multi_pattern_matcher_create'.
+ * @param text The text to be searched, it does not need to be NULL-terminated.
+ * @param textLength The number of bytes in the text.
+ * @param matches Output array receiving the start offset and pattern index of each match, may be NULL if 'maxMatches' is 0.
+ * @param maxMatches The capacity of the 'matches' array.
+ * @return The total number of matches in the text, which may exceed 'maxMatches', in which case only the first 'maxMatches' were stored.
  */
-int compare_strings(const char *characterString1, const char *characterString2)
+int multi_pattern_matcher_find_all(const MultiPatternMatcher *matcher, const char *text, size_t textLength, PatternMatch *matches, int maxMatches)
 {
-	// Handle unaligned bytes of characterString1 first
-	uintptr_t numUnalignedBytes = -(uintptr_t)characterString1 % sizeof(unsigned long); // Calculate the number of unaligned bytes
+	// Check for NULL input and handle error.
+	if (matcher == NULL || text == NULL){ perror("\n\nError: matcher and/or text was NULL in 'multi_pattern_matcher_find_all'.\n");      return 0; }
 	
 	
-	// Iterate over the unaligned bytes
-	for (uintptr_t i = 0; i < numUnalignedBytes; ++i)
+	const unsigned char *t = (const unsigned char *)text;
+	const int32_t *transitions = matcher->transitions;
+	int32_t state = 0;
+	int matchCount = 0;
+	size_t i = 0;
+	
+	while (i < textLength)
 	{
-		unsigned char c1 = *characterString1++;
-		unsigned char c2 = *characterString2++;
-		
-		int diff = c1 - c2;
-		if (c1 == '\0' || diff != 0)
+		// In the root state nothing is partially matched, so jump straight to the next byte that can start a pattern.
+		if (state == 0 && matcher->firstByteCount > 0 && i + 16 <= textLength)
 		{
-			return diff;
+			uint32_t mask = simd_any_equal_mask16(t + i, matcher->firstBytes, matcher->firstByteCount);
+			if (mask == 0)
+			{
+				i += 16;
+				continue;
+			}
+			i += __builtin_ctz(mask);
 		}
-	}
-	
-	
-	// characterString1 is now aligned to unsigned long, characterString2 may or may not be
-	
-	
-	// Cast the strings to unsigned long pointers for the aligned comparison.
-	const unsigned long *x1 = (const unsigned long *) characterString1;
-	const unsigned long *x2 = (const unsigned long *) characterString2;
-	
-	
-	
-	
-	// Compare the aligned parts of the strings
-	while (*x1 == *x2)
-	{
-		// Check for null character in the aligned memory
-		if (((const unsigned char*)x1)[0] == '\0' || ((const unsigned char*)x1)[1] == '\0' ||
-			((const unsigned char*)x1)[2] == '\0' || ((const unsigned char*)x1)[3] == '\0')
+		
+		
+		state = transitions[(size_t)state * 256 + t[i]];
+		
+		
+		// Report the pattern ending at this state and every pattern ending at one of its suffix states.
+		for (int32_t output = matcher->outputPattern[state] >= 0 ? state : matcher->outputLink[state]; output >= 0; output = matcher->outputLink[output])
 		{
-			break;
+			if (matchCount < maxMatches)
+			{
+				int32_t patternIndex = matcher->outputPattern[output];
+				matches[matchCount].offset = i + 1 - matcher->patternLengths[patternIndex];
+				matches[matchCount].patternIndex = patternIndex;
+			}
+			matchCount++;
 		}
-		x1++;
-		x2++;
+		i++;
 	}
 	
-	
-	// Cast the pointers back to char pointers to compare the remaining bytes.
-	characterString1 = (const char *)x1;
-	characterString2 = (const char *)x2;
-	
-	
-	// Compare the remaining bytes character by character while they are equal and neither string has reached its null terminator
-	while (*characterString1 && (*characterString1 == *characterString2))
+	return matchCount;
+}
+
+
+/**
+ * multi_pattern_matcher_destroy
+ *
+ * Releases a matcher compiled by 'multi_pattern_matcher_create'.
+ *
+ * @param matcher The matcher to be released, may be NULL.
+ */
+void multi_pattern_matcher_destroy(MultiPatternMatcher *matcher)
+{
+	if (matcher != NULL)
 	{
-		characterString1++;
-		characterString2++;
+		utilities_free(matcher->transitions);
+		utilities_free(matcher->outputPattern);
+		utilities_free(matcher->outputLink);
+		utilities_free(matcher->patternLengths);
+		utilities_free(matcher);
 	}
-	
-	
-	// Return the difference between the first non-matching characters
-	return (unsigned char)*characterString1 - (unsigned char)*characterString2;
 }
 
 
@@ -1055,828 +1487,3413 @@ int compare_strings(const char *characterString1, const char *characterString2)
 
 
 /**
- * combine_strings
+ * duplicate_string
  *
- * Combine two strings into a new string. Allocates memory for the new string, intitializes
- * it with the first input string, and appends the contents of the second input string to the first.
- * Handles NULL inputs by treating them as empty strings.
+ * This function duplicates a string by allocating memory for a new string and copying the contents of the original string.
+ * The duplicated string is a deep copy, and the caller is responsible for freeing the memory allocated for the new string.
  *
- * @param characterString1 The first character string.
- * @param characterString2 The second character string.
- * @return A pointer to the combined new string.
+ * @param characterString The string to be duplicated.
+ * @return A pointer to the duplicated string, or NULL if memory allocation fails.
  */
-char *combine_strings(const char* characterString1, const char* characterString2)
+char *duplicate_string(const char *characterString)
 {
-	// Check for NULL input and handle error.
-	if (characterString1 == NULL) characterString1 = " ";
-	if (characterString2 == NULL) characterString2 = " ";
-	
-	
-	/* Determine Count of Characters of Both Strings and Allocate Memory Appropriately */
-	int characterCount = string_length(characterString1) + 1 + string_length(characterString2) + 1;
-	char *combinedString = (char*)malloc(characterCount * sizeof(char));   //Allocate memory based on character count.
+	if (characterString == NULL)
+	{
+		return NULL; // Return NULL if the input string is NULL
+	}
 	
+	size_t length = string_length(characterString) + 1; // Calculate the length of the string including the null terminator
+	char *dup = (char *)utilities_malloc(length); // Allocate memory for the duplicated string
 	
-	/* Populate the CombinedString with the contents of the two strings */
-	copy_string(combinedString, characterString1);     // Initialize with the first string.
-	concatenate_string(combinedString, characterString2);   // Append the second string to the first.
+	if (dup == NULL)
+	{
+		return NULL; // Return NULL if memory allocation fails
+	}
 	
-	return combinedString;
+	copy_memory_block(dup, characterString, length); // Copy the original string to the newly allocated memory
+	return dup; // Return the pointer to the duplicated string
 }
 
 
 
 
 /**
- * combine_string_arrays
+ * duplicate_n_string
  *
- * Merges two arrays of strings into a new array. Each element of the new array is
- * created by concatenating corresponding elements from the two input arrays.
- * Allocates memory for the new array and individual strings. Handles different sizes
- * of input arrays and NULL elements.
+ * Duplicates the first 'n' characters of a string(or all of it if it is shorter) into a newly allocated, NULL-terminated string.
+ * Useful for materializing a token or field that is only known as a pointer and a length.
  *
- * @param stringArray1 The first array of strings.
- * @param stringCountArray1 The number of strings in the first array.
- * @param stringArray2 The second array of strings.
- * @param stringCountArray2 The number of strings in the second array.
- * @return A pointer to the combined new array of strings.
+ * @param characterString The string to be duplicated, it does not need to be NULL-terminated if it is at least 'n' characters long.
+ * @param n The maximum number of characters to duplicate.
+ * @return A pointer to the duplicated string, or NULL if the input string is NULL or memory allocation fails.
  */
-char **combine_string_arrays(const char **stringArray1, int stringCountArray1, const char **stringArray2, int stringCountArray2)
+char *duplicate_n_string(const char *characterString, size_t n)
 {
-	// Check for NULL input and handle error.
-	if (stringArray1 == NULL){ perror("\n\nError: stringArray1 was NULL in 'combine_string_arrays'.\n");      exit(1); }
-	if (stringArray2 == NULL){ perror("\n\nError: stringArray2 was NULL in 'combine_string_arrays'.\n");      exit(1); }
-	
-	
-	/* Determine the total number of strings and allocate memory appropriately */
-	int maxNumStrings = max(stringCountArray1, stringCountArray2);
-	char **combinedStringArray = (char**)malloc((maxNumStrings + 1) * sizeof(char*));// = allocate_memory_char_ptr_ptr(strlen(*stringArray1), (maxNumStrings + 1));
-																					 //For each pointer, allocate memory for a char pointer
-	for(size_t i = 0; i < (maxNumStrings + 1); i++)
+	if (characterString == NULL)
 	{
-		combinedStringArray[i] = (char*)malloc(string_length(*stringArray1) * sizeof(char));// = allocate_memory_char_ptr(strSize);
+		return NULL; // Return NULL if the input string is NULL
 	}
 	
-	
-	
-	
-	// Combine strings while both arrays have elements
-	for (int i = 0; i < stringCountArray1 && i < stringCountArray2; i++)
+	size_t length = 0;
+	while (length < n && characterString[length] != '\0') // Stop at 'n' characters without reading past them
 	{
-		/* Determine Count of Characters of Both Strings and Allocate Memory Appropriately */
-		char *str1 = (i < stringCountArray1) ? stringArray1[i] : "";
-		char *str2 = (i < stringCountArray2) ? stringArray2[i] : "";
-		
-		// Protect against NULL pointers
-		if (str1 == NULL) str1 = "";
-		if (str2 == NULL) str2 = "";
-		
-		
-		combinedStringArray[i] = combine_strings(str1, str2);
-		
-		free(str1);
-		free(str2);
+		length++;
 	}
 	
-	// Copy remaining strings from the longer array
-	if (stringCountArray1 > stringCountArray2)
-	{
-		for (int i = 0; i < stringCountArray1; i++)
-		{
-			combinedStringArray[i] = stringArray1[i]; // Copy remaining strings from array1
-		}
-	}
-	else
+	char *dup = (char *)utilities_malloc(length + 1); // Allocate memory for the duplicated string and its null terminator
+	if (dup == NULL)
 	{
-		for (int i = 0; i < stringCountArray2; i++)
-		{
-			combinedStringArray[i] = stringArray2[i]; // Copy remaining strings from array2
-		}
+		return NULL; // Return NULL if memory allocation fails
 	}
 	
-	// Null-terminate the array
-	combinedStringArray[maxNumStrings] = NULL;
-	return combinedStringArray;
+	copy_memory_block(dup, characterString, length);
+	dup[length] = '\0';
+	return dup;
 }
 
 
-
-
 /**
- * append_string_array_to_string
+ * duplicate_n_string_arena
  *
- * Combines a string with each string in an array, creating a new combined string.
- * Allocates memory for a new string that combines the initial string with each string in the array.
+ * Arena-backed 'duplicate_n_string': the copy is allocated from an arena and released with it, never individually.
  *
- * @param characterString1 The initial string.
- * @param characterStringArray The array of strings to be combined with the initial string.
- * @param stringCount The number of strings in the array.
- * @return A pointer to the newly allocated combined string.
+ * @param arena The arena to allocate the copy from.
+ * @param characterString The string to be duplicated, it does not need to be NULL-terminated if it is at least 'n' characters long.
+ * @param n The maximum number of characters to duplicate.
+ * @return A pointer to the duplicated string, or NULL if the input string is NULL.
  */
-char *append_string_array_to_string(const char *characterString1, const char *characterStringArray[], int stringCount, const char *delimiter)
+char *duplicate_n_string_arena(Arena *arena, const char *characterString, size_t n)
 {
-	// Check for NULL input and handle error.
-	if (characterString1 == NULL || characterStringArray == NULL){ perror("\n\nError: characterString1 and/or characterStringArray was NULL in 'combine_char_ptr_arr'.\n");      return NULL; }
-	
-	
-	size_t characterCount = string_length(characterString1) + 1; // +1 for the null terminator
-	for(int i = 0; i < stringCount && characterStringArray[i] != NULL; i++)
+	if (characterString == NULL)
 	{
-		characterCount += string_length(characterStringArray[i]);
+		return NULL; // Return NULL if the input string is NULL
 	}
 	
-	
-	char *combinedString = (char*)malloc(characterCount * sizeof(char)); //initialize with memory to copy first string
-	copy_string(combinedString, characterString1); // Initialize the string
-	
-	
-	for(int i = 0; i < stringCount; i++)
+	size_t length = 0;
+	while (length < n && characterString[length] != '\0') // Stop at 'n' characters without reading past them
 	{
-		concatenate_string(combinedString, characterStringArray[i]);  //append each string in the string array to the combined string
-		
-		
-		// Insert the delimiter between strings
-		if (i < stringCount - 1 && characterStringArray[i + 1] != NULL) // Last string in the string array is not reached and the next string is not null(avoids interruptor strings)
-		{
-			// Because it is assumed we are in the midst of concatenating strings, the number of delimiters should be less than
-			// or equal to the number of strings in the array, if the number of delimiters is equal to or greater than the number
-			// of strings at any point, then it means that either the delimiter is not present as intended in the string
-			// array(very unlikely at this point) or it means that the delimiting character has been inserted into the string
-			// array at some point in an unintended manner.
-			concatenate_string(combinedString, delimiter);
-		}
+		length++;
 	}
 	
-	return combinedString;
+	char *dup = (char *)arena_alloc(arena, length + 1);
+	copy_memory_block(dup, characterString, length);
+	dup[length] = '\0';
+	return dup;
 }
 
 
-
-
+/**
+ * duplicate_string_arena
+ *
+ * Arena-backed 'duplicate_string': the copy is allocated from an arena and released with it, never individually.
+ *
+ * @param arena The arena to allocate the copy from.
+ * @param characterString The string to be duplicated.
+ * @return A pointer to the duplicated string, or NULL if the input string is NULL.
+ */
+char *duplicate_string_arena(Arena *arena, const char *characterString)
+{
+	if (characterString == NULL)
+	{
+		return NULL; // Return NULL if the input string is NULL
+	}
+	
+	size_t length = string_length(characterString);
+	char *dup = (char *)arena_alloc(arena, length + 1);
+	copy_memory_block(dup, characterString, length + 1);
+	return dup;
+}
+
+
+
+
+/**
+ * copy_string
+ *
+ * This function copies the string pointed to by src, including the null terminator,
+ * to the buffer pointed to by dest. The destination buffer must be large enough to
+ * receive the copied string.
+ *
+ * @param destination The destination buffer where the string will be copied.
+ * @param source The source string to be copied.
+ * @return A pointer to the destination string.
+ */
+char *copy_string(char *destination, const char *source)
+{
+	char *dest_start = destination; // Save the start of destination buffer
+	
+	//while ((*destination++ = *source++) != '\0'); // Copy each character from source to destination including the null terminator
+	while ((*destination++ = *source++)); // Copy each character from src to dest, including the null terminator
+	
+	return dest_start; // Return the start of the destination buffer
+}
+
+
+
+
+/**
+ * copy_n_string
+ *
+ * This function copies up to 'n' characters from the source string to the destination string.
+ * If the length of the source string is less than 'n', the remainder of the destination string is padded with null characters.
+ * The destination string must be large enough to receive the copy.
+ *
+ * @param destination The destination buffer where the content is to be copied.
+ * @param source The source null-terminated string to be copied.
+ * @param n The maximum number of characters to copy from source to destination.
+ * @return A pointer to the destination string.
+ */
+char *copy_n_string(char *destination, const char *source, size_t n)
+{
+	char *dest_start = destination; // Save the start of the destination buffer
+	
+	
+	// Copy up to n characters from source to destination
+	while (n > 0 && (*source != '\0'))
+	{
+		*destination++ = *source++;
+		n--;
+	}
+	
+	
+	// Null-pad the remaining bytes
+	while (n > 0)
+	{
+		*destination++ = '\0';
+		n--;
+	}
+	
+	return dest_start; // Return the start of the destination buffer
+}
+
+
+
+
+/**
+ * concatenate_string
+ *
+ * This function concatenates the source string to the destination string.
+ * The destination string must have enough space to hold the concatenated result.
+ *
+ * @param destination The destination string to which the source string will be concatenated.
+ * @param source The source string to be concatenated.
+ * @return A pointer to the destination string.
+ */
+char *concatenate_string(char *destination, const char *source)
+{
+	char *dest_start = destination; // Save the start of destination buffer
+	
+	// Move dest to the end of the current string
+	while (*destination)
+	{
+		destination++;
+	}
+	
+	// Copy each character from source to destination, including the null terminator
+	while ((*destination++ = *source++));
+	
+	return dest_start; // Return the start of the destination buffer
+}
+
+
+
+
+
+
+
+/**
+ * concatenate_n_string
+ *
+ * Appends at most 'n' characters from the source string to the destination string,
+ * and then appends a null terminator. The destination string must have enough space
+ * to hold the resulting concatenated string.
+ *
+ * @param destination The destination string to which the source string will be concatenated.
+ * @param source The source string to be concatenated.
+ * @param n The maximum number of characters to concatenate from the source string.
+ * @return A pointer to the destination string.
+ */
+char *concatenate_n_string(char *destination, const char *source, size_t n)
+{
+	char *dest_start = destination; // Save the start of destination buffer
+	
+	// Move destination to the end of the current string
+	while (*destination)
+	{
+		destination++;
+	}
+	
+	// Copy up to 'n' characters from source to destination
+	while (n-- > 0 && *source)
+	{
+		*destination++ = *source++;
+	}
+	
+	// Null-terminate the destination string
+	*destination = '\0';
+	
+	return dest_start; // Return the start of the destination buffer
+}
+
+
+
+
+
+
+
+
+/**
+ * determine_most_common_string
+ *
+ * This function determines the most frequently occurring string in a given array of strings.
+ * It returns a pointer to a new memory location containing the most common string from the array.
+ * If the array is empty or stringCount is less than or equal to 0, it returns NULL.
+ *
+ * @note This function uses two arrays to keep track of each unique string and its frequency in the array.
+ *       It iterates over each string in the given array and checks if it is already present in the unique strings array.
+ *       If present, it increments the count of that string in the counts array, otherwise, it adds the string to the unique strings array and sets its count to 1.
+ *       It also keeps track of the string with the maximum count.
+ *
+ * @param stringArray This is a pointer to an array of pointers to strings. Each element in this array points to a string.
+ * @param stringCount The number of strings in the array.
+ * @return The most common string in the array.
+ */
+char* determine_most_common_string(char **stringArray, int stringCount)
+{
+	// Check if the count is less than or equal to 0. If so, return NULL.
+	if(stringCount <= 0)
+	{
+		return NULL;
+	}
+	
+	// Allocate memory for two arrays: one to store unique strings and another to store their counts.
+	char **uniqueStrings = (char**)utilities_calloc(stringCount, sizeof(char*));
+	int *counts = (int*)utilities_calloc(stringCount, sizeof(int));
+	int maxCount = 0, maxIndex = 0;
+	
+	// Iterate over each string in the given array to find unique strings and count their occurrences.
+	for(int i = 0; i < stringCount; i++)
+	{
+		int j;
+		
+		// If the string is already present in the unique strings array increment its count in the counts array.
+		for(j = 0; j < i; j++)
+		{
+			// If the string is present, increment its count, done to keep track of the frequency of each unique string.
+			if(uniqueStrings[j] != NULL && compare_strings(stringArray[i], uniqueStrings[j]) == 0)
+			{
+				counts[j]++;
+				
+				// If the count of the current string is greater than maxCount, update maxCount and maxIndex, done to keep track of the most common string as the array is processed.
+				if(counts[j] > maxCount)
+				{
+					maxCount = counts[j];
+					maxIndex = j;
+				}
+				break;
+			}
+		}
+		
+		
+		// If the string is not present in the unique strings array, add it to the array and set its count to 1, done to keep track of the frequency of each unique string.
+		if(j == i)
+		{
+			uniqueStrings[i] = stringArray[i];
+			counts[i] = 1;
+		}
+	}
+	
+	// Allocate for the most common string and copy it to this location.
+	char* mostCommonString = duplicate_string(uniqueStrings[maxIndex]);
+	
+	// Cleanup.
+	utilities_free(uniqueStrings);
+	utilities_free(counts);
+	
+	return mostCommonString; // Return the most common string.
+}
+
+
+
+
+/**
+ * compare_strings
+ *
+ * Performs a binary comparison of the characters of the two strings, returning an integer value
+ * indicating the difference between the first non-matching characters in the strings(0 if they are equal).
+ * When both strings share the same alignment within a word, they are compared a word at a time once aligned,
+ * stopping at the first word that differs or holds a null byte. Aligned loads never cross a page boundary, so reading
+ * a whole word around the terminator is safe. Strings with different alignments are compared a byte at a time.
+ *
+ * @param characterString1 The first character string to compare.
+ * @param characterString2 The second character string to compare.
+ * @return An integer value indicating the difference between the first non-matching characters.
+ */
+int compare_strings(const char *characterString1, const char *characterString2)
+{
+	const unsigned char *s1 = (const unsigned char *)characterString1;
+	const unsigned char *s2 = (const unsigned char *)characterString2;
+	
+	
+	if (((uintptr_t)s1 - (uintptr_t)s2) % sizeof(unsigned long) == 0)
+	{
+		// Compare the unaligned leading bytes, after which both strings are aligned to unsigned long.
+		while ((uintptr_t)s1 % sizeof(unsigned long) != 0)
+		{
+			if (*s1 == '\0' || *s1 != *s2)
+			{
+				return *s1 - *s2;
+			}
+			s1++;
+			s2++;
+		}
+		
+		
+		// Compare whole words while they are equal and contain no null byte(in any of their bytes).
+		const unsigned long lowBits = (unsigned long)-1 / 0xFF; // 0x01 in every byte
+		const unsigned long highBits = lowBits << 7; // 0x80 in every byte
+		const unsigned long *x1 = (const unsigned long *)s1;
+		const unsigned long *x2 = (const unsigned long *)s2;
+		while (*x1 == *x2 && ((*x1 - lowBits) & ~*x1 & highBits) == 0)
+		{
+			x1++;
+			x2++;
+		}
+		s1 = (const unsigned char *)x1;
+		s2 = (const unsigned char *)x2;
+	}
+	
+	
+	// Compare the remaining bytes while they are equal and neither string has reached its null terminator.
+	while (*s1 && *s1 == *s2)
+	{
+		s1++;
+		s2++;
+	}
+	
+	return *s1 - *s2;
+}
+
+
+
+
+
+
+
+
+/**
+ * compare_strings_nocase
+ *
+ * Compares two character strings without regard to ASCII case, folding each byte to lower case as it is compared so
+ * neither string needs to be copied or converted first(e.g., matching a header field against 'months' or 'weekDays').
+ *
+ * @param characterString1 The first character string to compare.
+ * @param characterString2 The second character string to compare.
+ * @return An integer value indicating the difference between the first non-matching characters after folding, 0 if the strings are equal ignoring case.
+ */
+int compare_strings_nocase(const char *characterString1, const char *characterString2)
+{
+	const unsigned char *s1 = (const unsigned char *)characterString1;
+	const unsigned char *s2 = (const unsigned char *)characterString2;
+	
+	
+	// Compare while the folded characters are equal and the first string has not reached its null terminator
+	while (*s1 && ascii_to_lower(*s1) == ascii_to_lower(*s2))
+	{
+		s1++;
+		s2++;
+	}
+	
+	return (int)ascii_to_lower(*s1) - (int)ascii_to_lower(*s2);
+}
+
+
+/**
+ * compare_strings_nocase_n
+ *
+ * Compares two explicit-length strings without regard to ASCII case. Both strings are folded and compared 16 bytes
+ * at a time, and only the first differing block is examined byte by byte. A string that is a (case-insensitive) prefix of
+ * the other compares as smaller, matching the ordering of 'compare_strings_nocase'.
+ *
+ * @param characterString1 The first string to compare.
+ * @param length1 The number of bytes in the first string.
+ * @param characterString2 The second string to compare.
+ * @param length2 The number of bytes in the second string.
+ * @return The difference between the first non-matching characters after folding, or the sign of 'length1 - length2' when one string is a prefix of the other, 0 if the strings are equal ignoring case.
+ */
+int compare_strings_nocase_n(const char *characterString1, size_t length1, const char *characterString2, size_t length2)
+{
+	const unsigned char *s1 = (const unsigned char *)characterString1;
+	const unsigned char *s2 = (const unsigned char *)characterString2;
+	size_t commonLength = length1 < length2 ? length1 : length2;
+	size_t i = 0;
+	
+	
+#if defined(SIMD_SSE2_AVAILABLE) || defined(SIMD_NEON_AVAILABLE)
+	for (; i + 16 <= commonLength; i += 16)
+	{
+		uint32_t equal;
+#if defined(SIMD_SSE2_AVAILABLE)
+		__m128i a = _mm_loadu_si128((const __m128i *)(s1 + i));
+		__m128i b = _mm_loadu_si128((const __m128i *)(s2 + i));
+		const __m128i bias = _mm_set1_epi8((char)(128 - 'A'));
+		const __m128i limit = _mm_set1_epi8((char)(-128 + 26));
+		const __m128i caseBit = _mm_set1_epi8(0x20);
+		a = _mm_or_si128(a, _mm_and_si128(_mm_cmplt_epi8(_mm_add_epi8(a, bias), limit), caseBit));
+		b = _mm_or_si128(b, _mm_and_si128(_mm_cmplt_epi8(_mm_add_epi8(b, bias), limit), caseBit));
+		equal = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+#else
+		uint8x16_t a = vld1q_u8(s1 + i);
+		uint8x16_t b = vld1q_u8(s2 + i);
+		a = vorrq_u8(a, vandq_u8(vcltq_u8(vsubq_u8(a, vdupq_n_u8('A')), vdupq_n_u8(26)), vdupq_n_u8(0x20)));
+		b = vorrq_u8(b, vandq_u8(vcltq_u8(vsubq_u8(b, vdupq_n_u8('A')), vdupq_n_u8(26)), vdupq_n_u8(0x20)));
+		equal = neon_movemask(vceqq_u8(a, b));
+#endif
+		if (equal != 0xFFFF)
+		{
+			size_t k = i + __builtin_ctz(~equal);
+			return (int)ascii_to_lower(s1[k]) - (int)ascii_to_lower(s2[k]);
+		}
+	}
+#endif
+	
+	
+	// Compare the remaining bytes one at a time.
+	for (; i < commonLength; i++)
+	{
+		int diff = (int)ascii_to_lower(s1[i]) - (int)ascii_to_lower(s2[i]);
+		if (diff != 0)
+		{
+			return diff;
+		}
+	}
+	
+	// The common part is equal, the longer string compares greater even when its remaining bytes are null.
+	return (length1 > length2) - (length1 < length2);
+}
+
+
+
+
+
+
+
+
+/**
+ * convert_case_n
+ *
+ * Shared kernel of the case conversion functions, converts 'length' bytes of 'source' into 'destination', which may be
+ * the same buffer. Letters are detected with a single biased signed comparison per vector, so each block costs an
+ * add, a compare, an and and an or(or xor) regardless of its contents, 32 bytes at a time with AVX2 and 16 bytes at a time otherwise.
+ */
+static void convert_case_n(char *destination, const char *source, size_t length, bool toUpperCase)
+{
+	const unsigned char first = toUpperCase ? 'a' : 'A'; // The first letter of the case being converted from.
+	unsigned char *dst = (unsigned char *)destination;
+	const unsigned char *src = (const unsigned char *)source;
+	size_t i = 0;
+	
+	
+#if defined(SIMD_AVX2_AVAILABLE)
+	{
+		const __m256i bias = _mm256_set1_epi8((char)(128 - first));
+		const __m256i limit = _mm256_set1_epi8((char)(-128 + 26));
+		const __m256i caseBit = _mm256_set1_epi8(0x20);
+		for (; i + 32 <= length; i += 32)
+		{
+			__m256i bytes = _mm256_loadu_si256((const __m256i *)(src + i));
+			__m256i isLetter = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(bytes, bias));
+			__m256i flip = _mm256_and_si256(isLetter, caseBit);
+			_mm256_storeu_si256((__m256i *)(dst + i), _mm256_xor_si256(bytes, flip)); // Only letters of the source case have bit 5 flipped.
+		}
+	}
+#endif
+#if defined(SIMD_SSE2_AVAILABLE)
+	{
+		const __m128i bias = _mm_set1_epi8((char)(128 - first));
+		const __m128i limit = _mm_set1_epi8((char)(-128 + 26));
+		const __m128i caseBit = _mm_set1_epi8(0x20);
+		for (; i + 16 <= length; i += 16)
+		{
+			__m128i bytes = _mm_loadu_si128((const __m128i *)(src + i));
+			__m128i isLetter = _mm_cmplt_epi8(_mm_add_epi8(bytes, bias), limit);
+			_mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(bytes, _mm_and_si128(isLetter, caseBit)));
+		}
+	}
+#elif defined(SIMD_NEON_AVAILABLE)
+	{
+		const uint8x16_t firstLetter = vdupq_n_u8(first);
+		const uint8x16_t letterCount = vdupq_n_u8(26);
+		const uint8x16_t caseBit = vdupq_n_u8(0x20);
+		for (; i + 16 <= length; i += 16)
+		{
+			uint8x16_t bytes = vld1q_u8(src + i);
+			uint8x16_t isLetter = vcltq_u8(vsubq_u8(bytes, firstLetter), letterCount);
+			vst1q_u8(dst + i, veorq_u8(bytes, vandq_u8(isLetter, caseBit)));
+		}
+	}
+#endif
+	
+	
+	// Convert the remaining bytes one at a time.
+	for (; i < length; i++)
+	{
+		unsigned char c = src[i];
+		dst[i] = c ^ (((unsigned char)(c - first) < 26) << 5);
+	}
+}
+
+
+/**
+ * convert_to_lower_case
+ *
+ * Copies 'length' bytes from 'source' to 'destination' converting ASCII upper-case letters to lower case. Bytes that are
+ * not upper-case letters(including any non-ASCII bytes) are copied unchanged. 'destination' may be the same buffer as 'source'.
+ *
+ * @param destination The buffer receiving the converted bytes, at least 'length' bytes long.
+ * @param source The bytes to be converted.
+ * @param length The number of bytes to convert.
+ * @return A pointer to the destination buffer.
+ */
+char *convert_to_lower_case(char *destination, const char *source, size_t length)
+{
+	// Check for NULL input and handle error.
+	if (destination == NULL || source == NULL){ perror("\n\nError: destination and/or source was NULL in 'convert_to_lower_case'.\n");      return NULL; }
+	
+	convert_case_n(destination, source, length, false);
+	return destination;
+}
+
+
+/**
+ * convert_to_upper_case
+ *
+ * Copies 'length' bytes from 'source' to 'destination' converting ASCII lower-case letters to upper case. Bytes that are
+ * not lower-case letters(including any non-ASCII bytes) are copied unchanged. 'destination' may be the same buffer as 'source'.
+ *
+ * @param destination The buffer receiving the converted bytes, at least 'length' bytes long.
+ * @param source The bytes to be converted.
+ * @param length The number of bytes to convert.
+ * @return A pointer to the destination buffer.
+ */
+char *convert_to_upper_case(char *destination, const char *source, size_t length)
+{
+	// Check for NULL input and handle error.
+	if (destination == NULL || source == NULL){ perror("\n\nError: destination and/or source was NULL in 'convert_to_upper_case'.\n");      return NULL; }
+	
+	convert_case_n(destination, source, length, true);
+	return destination;
+}
+
+
+/**
+ * convert_string_to_lower_case
+ *
+ * Converts a NULL-terminated string to ASCII lower case in place.
+ *
+ * @param characterString The string to be converted.
+ * @return A pointer to the converted string.
+ */
+char *convert_string_to_lower_case(char *characterString)
+{
+	// Check for NULL input and handle error.
+	if (characterString == NULL){ perror("\n\nError: characterString was NULL in 'convert_string_to_lower_case'.\n");      return NULL; }
+	
+	convert_case_n(characterString, characterString, string_length(characterString), false);
+	return characterString;
+}
+
+
+/**
+ * convert_string_to_upper_case
+ *
+ * Converts a NULL-terminated string to ASCII upper case in place.
+ *
+ * @param characterString The string to be converted.
+ * @return A pointer to the converted string.
+ */
+char *convert_string_to_upper_case(char *characterString)
+{
+	// Check for NULL input and handle error.
+	if (characterString == NULL){ perror("\n\nError: characterString was NULL in 'convert_string_to_upper_case'.\n");      return NULL; }
+	
+	convert_case_n(characterString, characterString, string_length(characterString), true);
+	return characterString;
+}
+
+
+
+
+
+
+
+
+/**
+ * combine_strings
+ *
+ * Combine two strings into a new string. Allocates memory for the new string, intitializes
+ * it with the first input string, and appends the contents of the second input string to the first.
+ * Handles NULL inputs by treating them as empty strings.
+ *
+ * @param characterString1 The first character string.
+ * @param characterString2 The second character string.
+ * @return A pointer to the combined new string.
+ */
+char *combine_strings(const char* characterString1, const char* characterString2)
+{
+	// Check for NULL input and handle error.
+	if (characterString1 == NULL) characterString1 = " ";
+	if (characterString2 == NULL) characterString2 = " ";
+	
+	
+	/* Determine Count of Characters of Both Strings and Allocate Memory Appropriately */
+	int characterCount = string_length(characterString1) + 1 + string_length(characterString2) + 1;
+	char *combinedString = (char*)utilities_malloc(characterCount * sizeof(char));   //Allocate memory based on character count.
+	
+	
+	/* Populate the CombinedString with the contents of the two strings */
+	copy_string(combinedString, characterString1);     // Initialize with the first string.
+	concatenate_string(combinedString, characterString2);   // Append the second string to the first.
+	
+	return combinedString;
+}
+
+
+
+
+/**
+ * combine_string_arrays
+ *
+ * Merges two arrays of strings into a new array. Each element of the new array is
+ * created by concatenating corresponding elements from the two input arrays.
+ * Allocates memory for the new array and individual strings. Handles different sizes
+ * of input arrays and NULL elements.
+ *
+ * @param stringArray1 The first array of strings.
+ * @param stringCountArray1 The number of strings in the first array.
+ * @param stringArray2 The second array of strings.
+ * @param stringCountArray2 The number of strings in the second array.
+ * @return A pointer to the combined new array of strings.
+ */
+char **combine_string_arrays(const char **stringArray1, int stringCountArray1, const char **stringArray2, int stringCountArray2)
+{
+	// Check for NULL input and handle error.
+	if (stringArray1 == NULL){ perror("\n\nError: stringArray1 was NULL in 'combine_string_arrays'.\n");      exit(1); }
+	if (stringArray2 == NULL){ perror("\n\nError: stringArray2 was NULL in 'combine_string_arrays'.\n");      exit(1); }
+	
+	
+	/* Determine the total number of strings and allocate memory appropriately */
+	int maxNumStrings = max(stringCountArray1, stringCountArray2);
+	char **combinedStringArray = (char**)utilities_malloc((maxNumStrings + 1) * sizeof(char*));
+	if (combinedStringArray == NULL){ perror("\n\nError: Unable to allocate memory in 'combine_string_arrays'.\n");      exit(1); }
+	
+	
+	// Combine corresponding strings, the shorter array(and any NULL element) contributing empty strings
+	for (int i = 0; i < maxNumStrings; i++)
+	{
+		const char *str1 = (i < stringCountArray1 && stringArray1[i] != NULL) ? stringArray1[i] : "";
+		const char *str2 = (i < stringCountArray2 && stringArray2[i] != NULL) ? stringArray2[i] : "";
+		combinedStringArray[i] = combine_strings(str1, str2);
+	}
+	
+	// Null-terminate the array
+	combinedStringArray[maxNumStrings] = NULL;
+	return combinedStringArray;
+}
+
+
+
+
+/**
+ * append_string_array_to_string
+ *
+ * Combines a string with each string in an array, creating a new combined string.
+ * Allocates memory for a new string that combines the initial string with each string in the array.
+ *
+ * @param characterString1 The initial string.
+ * @param characterStringArray The array of strings to be combined with the initial string.
+ * @param stringCount The number of strings in the array.
+ * @return A pointer to the newly allocated combined string.
+ */
+char *append_string_array_to_string(const char *characterString1, const char *characterStringArray[], int stringCount, const char *delimiter)
+{
+	// Check for NULL input and handle error.
+	if (characterString1 == NULL || characterStringArray == NULL){ perror("\n\nError: characterString1 and/or characterStringArray was NULL in 'combine_char_ptr_arr'.\n");      return NULL; }
+	
+	
+	size_t characterCount = string_length(characterString1) + 1; // +1 for the null terminator
+	for(int i = 0; i < stringCount && characterStringArray[i] != NULL; i++)
+	{
+		characterCount += string_length(characterStringArray[i]);
+	}
+	
+	
+	char *combinedString = (char*)utilities_malloc(characterCount * sizeof(char)); //initialize with memory to copy first string
+	copy_string(combinedString, characterString1); // Initialize the string
+	
+	
+	for(int i = 0; i < stringCount; i++)
+	{
+		concatenate_string(combinedString, characterStringArray[i]);  //append each string in the string array to the combined string
+		
+		
+		// Insert the delimiter between strings
+		if (i < stringCount - 1 && characterStringArray[i + 1] != NULL) // Last string in the string array is not reached and the next string is not null(avoids interruptor strings)
+		{
+			// Because it is assumed we are in the midst of concatenating strings, the number of delimiters should be less than
+			// or equal to the number of strings in the array, if the number of delimiters is equal to or greater than the number
+			// of strings at any point, then it means that either the delimiter is not present as intended in the string
+			// array(very unlikely at this point) or it means that the delimiting character has been inserted into the string
+			// array at some point in an unintended manner.
+			concatenate_string(combinedString, delimiter);
+		}
+	}
+	
+	return combinedString;
+}
+
+
+
+
 /**
  * concatenate_string_array
  *
- * Concatenates each string from an array of strings into one single string, separated by commas(not strictly commas, but whatever delimiter is passed in, commas by convention).
- * Each element from the passed in character double pointer(used here as an array of arrays of characters) is itself a character pointer(used here as an array of characters),
- * meaning that the (individual characters) from a double pointer char(effectively an array of strings) to create one single string , separated by commas.
+ * Concatenates each string from an array of strings into one single string, separated by commas(not strictly commas, but whatever delimiter is passed in, commas by convention).
+ * Each element from the passed in character double pointer(used here as an array of arrays of characters) is itself a character pointer(used here as an array of characters),
+ * meaning that the (individual characters) from a double pointer char(effectively an array of strings) to create one single string , separated by commas.
+ *
+ * @param stringArray The array of strings to concatenate.
+ * @param stringCount The number of strings in the array.
+ * @return A pointer to the newly allocated concatenated string.
+ */
+char* concatenate_string_array(const char** stringArray, int stringCount, const char *delimiter)
+{
+	// Check for NULL input and handle error.
+	if (stringArray == NULL){ perror("\n\nError: stringArray was NULL in 'concatenate_string_array'.\n");      return 0; }
+	
+	
+	
+	// Determine the length of the concatenated string
+	size_t totalLength = 0;
+	for (int i = 0; i < stringCount && stringArray[i] != NULL; i++)
+	{
+		totalLength += string_length(stringArray[i]) + 1; // +1 for comma or null terminator
+	}
+	
+	// Allocate memory for the concatenated string
+	char* concatenated = (char*)utilities_malloc(totalLength * sizeof(char));// = allocate_memory_char_ptr(totalLength);
+	
+	
+	int emptyStringCount = 0; // Track the number of empty strings
+	int *emptyStringIndices = (int*)utilities_malloc(stringCount * sizeof(int)); // = allocate_memory_int_ptr(stringCount); // Track the indices of empty strings
+	for (int i = 0; i < stringCount; i++)
+	{
+		if((stringArray[i] == NULL) || (compare_strings(stringArray[i], "") == 0) || (string_length(stringArray[i]) == 0) || (stringArray[i] == (void *)0) || (compare_strings(stringArray[i], delimiter) == 0))
+		{
+			emptyStringCount++;
+			emptyStringIndices[i] = 1; // A value of 1 indicates an empty string and a value of 0 indicates a non-empty string
+		}
+		else
+		{
+			emptyStringIndices[i] = 0;
+		}
+	}
+	
+	
+	
+	
+	// Concatenate the fields
+	copy_string(concatenated, ""); // Initialize the string
+	for (int i = 0; i < stringCount && stringArray[i] != NULL; i++)
+	{
+		if(emptyStringIndices[i] == 1) // This string is empty
+		{
+			continue; // Skip this string
+		}
+		concatenate_string(concatenated, stringArray[i]);
+		
+		
+		if (i < stringCount - 1 && stringArray[i + 1] != NULL)// && count_character_occurrences(concatenated, delimiter[0]) < (stringCount - emptyStringCount) ) // Last string in the string array is not reached, the next string is not null(avoids interruptor strings), and the occurences of the delimiter is less than the number of strings
+		{
+			// Because it is assumed we are in the midst of concatenating strings, the number of delimiters in the concatenated string should be less than
+			// or equal to the number of strings in the string array, if the number of delimiters is at any point equal to or greater than the number of strings,
+			// then it means that either the delimiter is not present as intended in the string array(very unlikely at this point) or it means that the delimiting
+			// character has been inserted into the string array at some point in an unintended manner.
+			
+			// If the last element in the string array is the delimiter then it means that either the last string is empty or the delimiter was inserted into the string array at some point in an unintended manner
+			concatenate_string(concatenated, delimiter);
+		}
+	}
+	
+	return concatenated;
+}
+
+
+
+
+
+
+
+
+/**
+ * character_set_init
+ *
+ * Builds a character set from the characters of a NULL-terminated string. Membership is stored as a 256-bit bitmap, so
+ * testing a byte is a single shift and mask regardless of how many characters are in the set, and when the set has
+ * at most 'CHARACTER_SET_SIMD_MEMBERS' members they are also kept as a list for the SIMD scanning functions.
+ *
+ * @param set The character set to be initialized.
+ * @param characters The characters that are members of the set, duplicates are ignored.
+ */
+void character_set_init(CharacterSet *set, const char *characters)
+{
+	// Check for NULL input and handle error.
+	if (set == NULL || characters == NULL){ perror("\n\nError: set and/or characters was NULL in 'character_set_init'.\n");      exit(1); }
+	
+	
+	set_memory_block(set, 0, sizeof(CharacterSet));
+	for (const unsigned char *c = (const unsigned char *)characters; *c; c++)
+	{
+		if (character_set_contains(set, (char)*c))
+		{
+			continue;
+		}
+		
+		set->bits[*c >> 6] |= (uint64_t)1 << (*c & 63);
+		if (set->memberCount < CHARACTER_SET_SIMD_MEMBERS)
+		{
+			set->members[set->memberCount] = *c;
+		}
+		set->memberCount++;
+	}
+}
+
+
+/**
+ * find_first_character_in_set
+ *
+ * Finds the first byte of an explicit-length buffer that is a member of a character set. For sets with at most
+ * 'CHARACTER_SET_SIMD_MEMBERS' members(which covers every delimiter set in practice) the buffer is scanned 16 bytes
+ * per iteration with vector compares, otherwise each byte is tested against the bitmap.
+ *
+ * @param characters The buffer to be scanned.
+ * @param length The number of bytes in the buffer.
+ * @param set The character set to search for.
+ * @return The offset of the first member of the set, or 'length' if the buffer contains none.
+ */
+size_t find_first_character_in_set(const char *characters, size_t length, const CharacterSet *set)
+{
+	const unsigned char *p = (const unsigned char *)characters;
+	size_t i = 0;
+	
+	
+	if (set->memberCount <= CHARACTER_SET_SIMD_MEMBERS)
+	{
+		for (; i + 16 <= length; i += 16)
+		{
+			uint32_t mask = simd_any_equal_mask16(p + i, set->members, set->memberCount);
+			if (mask)
+			{
+				return i + __builtin_ctz(mask);
+			}
+		}
+	}
+	
+	for (; i < length; i++)
+	{
+		if (character_set_contains(set, (char)p[i]))
+		{
+			return i;
+		}
+	}
+	return length;
+}
+
+
+/**
+ * string_tokenizer_init
+ *
+ * Initializes a cursor-based tokenizer over an explicit-length string. All of the tokenizer's state lives in the
+ * 'StringTokenizer' struct, so any number of tokenizers can be active at once, on different threads or nested inside one
+ * another, and the input is never modified.
+ *
+ * @param tokenizer The tokenizer to be initialized.
+ * @param characterString The string to be tokenized, it does not need to be NULL-terminated.
+ * @param length The number of bytes in the string.
+ * @param delimiters The NULL-terminated set of delimiter characters, each character is a delimiter on its own.
+ * @param skipEmptyTokens If true, runs of delimiters are treated as one and leading/trailing delimiters are skipped(the 'strtok' behavior),
+ *        if false every delimiter ends a token, so "a,,b," yields "a", "", "b" and "" (the behavior needed to keep fields aligned).
+ */
+void string_tokenizer_init(StringTokenizer *tokenizer, const char *characterString, size_t length, const char *delimiters, bool skipEmptyTokens)
+{
+	// Check for NULL input and handle error.
+	if (tokenizer == NULL || characterString == NULL || delimiters == NULL){ perror("\n\nError: NULL argument in 'string_tokenizer_init'.\n");      exit(1); }
+	
+	tokenizer->cursor = characterString;
+	tokenizer->end = characterString + length;
+	character_set_init(&tokenizer->delimiters, delimiters);
+	tokenizer->skipEmptyTokens = skipEmptyTokens;
+	tokenizer->finished = false;
+}
+
+
+/**
+ * string_tokenizer_next
+ *
+ * Advances a tokenizer to its next token and returns it as a pointer and length into the original string.
+ * The scan to the end of the token is done with 'find_first_character_in_set', i.e., 16 bytes at a time for small delimiter sets.
+ *
+ * @param tokenizer The tokenizer initialized by 'string_tokenizer_init'.
+ * @param token Receives the next token, which is not NULL-terminated.
+ * @return true if a token was produced, false once the string is exhausted.
+ */
+bool string_tokenizer_next(StringTokenizer *tokenizer, StringView *token)
+{
+	if (tokenizer->finished)
+	{
+		return false;
+	}
+	
+	
+	// Skip leading delimiters when empty tokens are not wanted.
+	if (tokenizer->skipEmptyTokens)
+	{
+		while (tokenizer->cursor < tokenizer->end && character_set_contains(&tokenizer->delimiters, *tokenizer->cursor))
+		{
+			tokenizer->cursor++;
+		}
+		if (tokenizer->cursor == tokenizer->end)
+		{
+			tokenizer->finished = true;
+			return false;
+		}
+	}
+	
+	
+	// Scan to the end of the token.
+	size_t remaining = (size_t)(tokenizer->end - tokenizer->cursor);
+	size_t tokenLength = find_first_character_in_set(tokenizer->cursor, remaining, &tokenizer->delimiters);
+	token->characters = tokenizer->cursor;
+	token->length = tokenLength;
+	
+	if (tokenLength == remaining)
+	{
+		tokenizer->finished = true; // The last token ends at the end of the string.
+	}
+	else
+	{
+		tokenizer->cursor += tokenLength + 1; // Step over the delimiter that ended the token.
+	}
+	return true;
+}
+
+
+/**
+ * tokenize_string
+ *
+ * This function tokenizes a string based on a delimiter character and returns the next token.
+ * It is similar to the standard strtok function: passing the string starts a new tokenization, passing NULL continues
+ * the previous one, runs of delimiters are skipped, and each returned token is NULL-terminated by overwriting the
+ * delimiter that follows it.
+ *
+ * It is a thin shim over 'StringTokenizer', whose state is kept per thread, so concurrent tokenizations on different threads
+ * no longer interfere. A tokenization nested inside another one on the same thread still replaces it, new code should
+ * use 'string_tokenizer_init' and 'string_tokenizer_next' directly, which are fully reentrant and do not modify the input.
+ *
+ * @param s The string to be tokenized, or NULL to continue tokenizing the previous string.
+ * @param delim The delimiter characters used to tokenize the string.
+ * @return A pointer to the next token in the string, or NULL if no more tokens are found.
+ */
+char *tokenize_string(char *s, const char *delim)
+{
+	static _Thread_local StringTokenizer tokenizer = { .finished = true };
+	static _Thread_local const char *tokenizerDelimiters = NULL;
+	
+	
+	// Start a new tokenization, or pick up a change of delimiters between calls(which 'strtok' permits).
+	if (s != NULL)
+	{
+		string_tokenizer_init(&tokenizer, s, string_length(s), delim, true);
+		tokenizerDelimiters = delim;
+	}
+	else if (delim != tokenizerDelimiters && !tokenizer.finished)
+	{
+		character_set_init(&tokenizer.delimiters, delim);
+		tokenizerDelimiters = delim;
+	}
+	
+	
+	StringView token;
+	if (!string_tokenizer_next(&tokenizer, &token))
+	{
+		return NULL;
+	}
+	
+	char *tokenStart = (char *)token.characters;
+	tokenStart[token.length] = '\0'; // Either overwrites the delimiter that ended the token or rewrites the existing terminator.
+	return tokenStart;
+}
+
+
+
+
+/**
+ * split_tokenized_string
+ *
+ * Splits a string into an array of strings based on a given delimiter.
+ *
+ *
+ * @param characterString The string to be split.
+ * @param delimiter The delimiter used to split the string.
+ * @param divisions The maximum number of parts to split the string into.
+ * @return An array of strings, each representing a part of the original string.
+ */
+char** split_tokenized_string(const char* characterString, const char* delimiter, int divisions)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_SPLIT_TOKENIZED_STRING);
+	char** parts = (char**)utilities_malloc(sizeof(char*) * (divisions + 1));
+	if (parts == NULL)
+	{
+		fprintf(stderr, "Memory allocation failed in split_tokenized_string\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	// Tokenize the original string in place, the tokenizer never modifies it so no working copy is needed.
+	StringTokenizer tokenizer;
+	StringView token;
+	string_tokenizer_init(&tokenizer, characterString, string_length(characterString), delimiter, true);
+	int i = 0;
+	while (i < divisions && string_tokenizer_next(&tokenizer, &token))
+	{
+		parts[i] = duplicate_n_string(token.characters, token.length);
+		
+		if (parts[i] == NULL)
+		{
+			fprintf(stderr, "Memory allocation failed in split_tokenized_string\n");
+			exit(EXIT_FAILURE);
+		}
+		i++;
+	}
+	
+	parts[i] = NULL; // Null-terminate the array
+	return parts;
+}
+
+
+/**
+ * split_tokenized_string_arena
+ *
+ * Arena-backed 'split_tokenized_string': the array and every part are allocated from an arena, so the whole result is
+ * released with the arena instead of with one 'free' per part.
+ *
+ * @param arena The arena to allocate the result from.
+ * @param characterString The string to be split.
+ * @param delimiter The delimiter used to split the string.
+ * @param divisions The maximum number of parts to split the string into.
+ * @return A NULL-terminated array of strings, each representing a part of the original string.
+ */
+char **split_tokenized_string_arena(Arena *arena, const char *characterString, const char *delimiter, int divisions)
+{
+	// Check for NULL input and handle error.
+	if (characterString == NULL || delimiter == NULL){ perror("\n\nError: characterString and/or delimiter was NULL in 'split_tokenized_string_arena'.\n");      return NULL; }
+	
+	
+	char **parts = (char **)arena_alloc(arena, sizeof(char *) * (divisions + 1));
+	
+	StringTokenizer tokenizer;
+	StringView token;
+	string_tokenizer_init(&tokenizer, characterString, string_length(characterString), delimiter, true);
+	int i = 0;
+	while (i < divisions && string_tokenizer_next(&tokenizer, &token))
+	{
+		parts[i++] = duplicate_n_string_arena(arena, token.characters, token.length);
+	}
+	
+	parts[i] = NULL; // Null-terminate the array
+	return parts;
+}
+
+
+
+
+/**
+ * count_characters_in_set
+ *
+ * Counts the bytes of an explicit-length buffer that are members of a character set, 16 bytes per iteration(one
+ * vector compare per member and a population count) for small sets, and with the bitmap otherwise.
+ */
+static size_t count_characters_in_set(const char *characters, size_t length, const CharacterSet *set)
+{
+	const unsigned char *p = (const unsigned char *)characters;
+	size_t count = 0;
+	size_t i = 0;
+	
+	if (set->memberCount <= CHARACTER_SET_SIMD_MEMBERS)
+	{
+		for (; i + 16 <= length; i += 16)
+		{
+			count += __builtin_popcount(simd_any_equal_mask16(p + i, set->members, set->memberCount));
+		}
+	}
+	for (; i < length; i++)
+	{
+		count += character_set_contains(set, (char)p[i]);
+	}
+	return count;
+}
+
+
+/**
+ * split_string_fields
+ *
+ * Zero-copy split: records the offset and length of each field of a string into a caller-provided array, without allocating
+ * and without modifying the string. Field boundaries are found with the tokenizer's SIMD delimiter scan.
+ *
+ * The return value is the actual number of fields in the string, so a caller that does not know the field count in advance can
+ * pass a small array, and if the returned count exceeds 'maxFields' retry with an array of the reported size.
+ *
+ * @param characterString The string to be split, it does not need to be NULL-terminated.
+ * @param length The number of bytes in the string.
+ * @param delimiter The NULL-terminated set of delimiter characters.
+ * @param skipEmptyFields If true, runs of delimiters are collapsed('split_tokenized_string' behavior), if false every delimiter ends a field.
+ * @param fields Output array receiving the offset and length of each field, may be NULL if 'maxFields' is 0.
+ * @param maxFields The capacity of the 'fields' array.
+ * @return The number of fields in the string, which may exceed 'maxFields', in which case only the first 'maxFields' were stored.
+ */
+int split_string_fields(const char *characterString, size_t length, const char *delimiter, bool skipEmptyFields, StringField *fields, int maxFields)
+{
+	// Check for NULL input and handle error.
+	if (characterString == NULL || delimiter == NULL){ perror("\n\nError: characterString and/or delimiter was NULL in 'split_string_fields'.\n");      return 0; }
+	
+	
+	StringTokenizer tokenizer;
+	StringView token;
+	string_tokenizer_init(&tokenizer, characterString, length, delimiter, skipEmptyFields);
+	
+	int fieldCount = 0;
+	while (string_tokenizer_next(&tokenizer, &token))
+	{
+		if (fieldCount < maxFields)
+		{
+			fields[fieldCount].offset = (size_t)(token.characters - characterString);
+			fields[fieldCount].length = token.length;
+			fields[fieldCount].flags = 0;
+		}
+		fieldCount++;
+	}
+	return fieldCount;
+}
+
+
+/**
+ * split_string_indexed
+ *
+ * Splits a string into fields with a single allocation. The returned block holds the 'SplitString' header, an array of
+ * (offset, length) pairs for the fields, and one copy of the string's bytes in which the delimiter ending each field
+ * has been replaced by a null terminator, so 'split->characters + split->fields[i].offset' is directly usable as a C string.
+ *
+ * The delimiters are counted first(16 bytes at a time) to size the block exactly, so unlike 'split_tokenized_string' the
+ * number of fields does not have to be known up front, and a row of any width costs one malloc and one free
+ * rather than one per field.
+ *
+ * @param characterString The string to be split.
+ * @param delimiter The NULL-terminated set of delimiter characters.
+ * @param skipEmptyFields If true, runs of delimiters are collapsed('split_tokenized_string' behavior), if false every delimiter ends a field.
+ * @return The split string, to be released with a single call to 'free', or NULL if the input is NULL or memory allocation fails.
+ */
+SplitString *split_string_indexed(const char *characterString, const char *delimiter, bool skipEmptyFields)
+{
+	// Check for NULL input and handle error.
+	if (characterString == NULL || delimiter == NULL){ perror("\n\nError: characterString and/or delimiter was NULL in 'split_string_indexed'.\n");      return NULL; }
+	
+	
+	/// Size the block: every delimiter can end at most one field, plus the final field.
+	size_t length = string_length(characterString);
+	CharacterSet delimiters;
+	character_set_init(&delimiters, delimiter);
+	size_t maxFields = count_characters_in_set(characterString, length, &delimiters) + 1;
+	
+	size_t headerSize = (sizeof(SplitString) + sizeof(StringField) - 1) / sizeof(StringField) * sizeof(StringField); // Keep the field array aligned.
+	size_t blockSize = headerSize + maxFields * sizeof(StringField) + length + 1;
+	unsigned char *block = (unsigned char *)utilities_malloc(blockSize);
+	if (block == NULL)
+	{
+		return NULL;
+	}
+	
+	
+	/// Lay out the header, the field index and the copy of the bytes within the block.
+	SplitString *split = (SplitString *)block;
+	split->fields = (StringField *)(block + headerSize);
+	split->characters = (char *)(block + headerSize + maxFields * sizeof(StringField));
+	copy_memory_block(split->characters, characterString, length + 1);
+	
+	
+	/// Index the fields in the copy and terminate each one in place.
+	split->fieldCount = split_string_fields(split->characters, length, delimiter, skipEmptyFields, split->fields, (int)maxFields);
+	for (int i = 0; i < split->fieldCount; i++)
+	{
+		split->characters[split->fields[i].offset + split->fields[i].length] = '\0';
+	}
+	
+	return split;
+}
+
+
+/**
+ * record_csv_field
+ *
+ * Stores the field spanning [start, end) of a CSV row, excluding the enclosing quotes of a quoted field and flagging
+ * the field if it still contains quote characters(i.e., doubled quotes that need unescaping). Malformed fields, such as a
+ * quote that is opened but never closed, are accepted leniently rather than rejected.
+ */
+static void record_csv_field(const char *row, size_t start, size_t end, StringField *field)
+{
+	field->offset = start;
+	field->length = end - start;
+	field->flags = 0;
+	
+	if (field->length > 0 && row[start] == '"')
+	{
+		field->flags = STRING_FIELD_QUOTED;
+		field->offset++;
+		field->length--;
+		if (field->length > 0 && row[field->offset + field->length - 1] == '"')
+		{
+			field->length--;
+		}
+		if (find_byte_n((const unsigned char *)row + field->offset, field->length, '"') != NULL)
+		{
+			field->flags |= STRING_FIELD_ESCAPED_QUOTES;
+		}
+	}
+}
+
+
+/**
+ * split_csv_fields
+ *
+ * Zero-copy, quote-aware split of one RFC 4180 CSV row: a delimiter inside a double-quoted field does not end the field, and
+ * a doubled quote inside a quoted field is an escaped quote. Each field is recorded as an offset and length(excluding
+ * its enclosing quotes) with 'STRING_FIELD_QUOTED' and 'STRING_FIELD_ESCAPED_QUOTES' flags, see 'csv_unescape_field'.
+ *
+ * The row is processed in 64-byte blocks without a per-byte state machine: the quote and delimiter bytes of a block are
+ * turned into 64-bit masks, the prefix XOR of the quote mask('prefix_xor64', a carry-less multiply) gives the bytes inside
+ * quoted regions, and the delimiters outside of them are the field boundaries. Doubled quotes toggle the mask twice,
+ * so they need no special handling, and whether a quoted region is still open is carried from one block to the next.
+ *
+ * @param row The CSV row, it does not need to be NULL-terminated and should not include the line terminator.
+ * @param length The number of bytes in the row.
+ * @param delimiter The field delimiter, typically ','.
+ * @param fields Output array receiving the fields, may be NULL if 'maxFields' is 0.
+ * @param maxFields The capacity of the 'fields' array.
+ * @return The number of fields in the row, which may exceed 'maxFields', in which case only the first 'maxFields' were stored.
+ */
+int split_csv_fields(const char *row, size_t length, char delimiter, StringField *fields, int maxFields)
+{
+	// Check for NULL input and handle error.
+	if (row == NULL){ perror("\n\nError: row was NULL in 'split_csv_fields'.\n");      return 0; }
+	
+	
+	const unsigned char *bytes = (const unsigned char *)row;
+	unsigned char tail[64];
+	uint64_t insideQuotesCarry = 0; // All ones when the previous block ended inside a quoted region.
+	size_t fieldStart = 0;
+	int fieldCount = 0;
+	
+	for (size_t base = 0; base < length; base += 64)
+	{
+		/// The final partial block is copied into a zero-padded buffer so every block is a full 64 bytes.
+		const unsigned char *block = bytes + base;
+		uint64_t validBytes = ~0ULL;
+		if (length - base < 64)
+		{
+			set_memory_block(tail, 0, sizeof(tail));
+			copy_memory_block(tail, block, length - base);
+			block = tail;
+			validBytes = (1ULL << (length - base)) - 1;
+		}
+		
+		
+		/// Mask off the delimiters that fall inside quoted regions, the rest end fields.
+		uint64_t quotes = simd_equal_mask64(block, '"');
+		uint64_t delimiters = simd_equal_mask64(block, (unsigned char)delimiter) & validBytes;
+		uint64_t insideQuotes = prefix_xor64(quotes) ^ insideQuotesCarry;
+		insideQuotesCarry = (uint64_t)((int64_t)insideQuotes >> 63);
+		delimiters &= ~insideQuotes;
+		
+		while (delimiters)
+		{
+			size_t fieldEnd = base + (size_t)__builtin_ctzll(delimiters);
+			if (fieldCount < maxFields)
+			{
+				record_csv_field(row, fieldStart, fieldEnd, &fields[fieldCount]);
+			}
+			fieldCount++;
+			fieldStart = fieldEnd + 1;
+			delimiters &= delimiters - 1;
+		}
+	}
+	
+	
+	/// The last field runs to the end of the row.
+	if (fieldCount < maxFields)
+	{
+		record_csv_field(row, fieldStart, length, &fields[fieldCount]);
+	}
+	return fieldCount + 1;
+}
+
+
+/**
+ * csv_unescape_field
+ *
+ * Collapses each doubled quote("") of a quoted CSV field to a single quote, in place. Only fields flagged with
+ * 'STRING_FIELD_ESCAPED_QUOTES' need this, so the common case of fields without quotes never touches their bytes.
+ *
+ * @param field The field's characters, excluding its enclosing quotes.
+ * @param length The number of bytes in the field.
+ * @return The new length of the field, the bytes past it are left unchanged.
+ */
+size_t csv_unescape_field(char *field, size_t length)
+{
+	// Check for NULL input and handle error.
+	if (field == NULL){ perror("\n\nError: field was NULL in 'csv_unescape_field'.\n");      return 0; }
+	
+	
+	/// Skip straight to the first quote, nothing before it moves.
+	const unsigned char *firstQuote = find_byte_n((const unsigned char *)field, length, '"');
+	if (firstQuote == NULL)
+	{
+		return length;
+	}
+	
+	size_t writeIndex = (size_t)((const char *)firstQuote - field);
+	size_t readIndex = writeIndex;
+	while (readIndex < length)
+	{
+		char c = field[readIndex++];
+		field[writeIndex++] = c;
+		if (c == '"' && readIndex < length && field[readIndex] == '"')
+		{
+			readIndex++;
+		}
+	}
+	return writeIndex;
+}
+
+
+/**
+ * split_csv_indexed
+ *
+ * Quote-aware counterpart of 'split_string_indexed' for one RFC 4180 CSV row: returns a single allocation holding the
+ * field index and a copy of the row in which every field has had its enclosing quotes removed, its doubled quotes
+ * collapsed, and a null terminator appended.
+ *
+ * @param row The NULL-terminated CSV row, without its line terminator.
+ * @param delimiter The field delimiter, typically ','.
+ * @return The split row, to be released with a single call to 'free', or NULL if the input is NULL or memory allocation fails.
+ */
+SplitString *split_csv_indexed(const char *row, char delimiter)
+{
+	// Check for NULL input and handle error.
+	if (row == NULL){ perror("\n\nError: row was NULL in 'split_csv_indexed'.\n");      return NULL; }
+	
+	
+	/// Size the block with the delimiter count, an upper bound on the field count since quoted delimiters are included.
+	size_t length = string_length(row);
+	char delimiterString[2] = { delimiter, '\0' };
+	CharacterSet delimiters;
+	character_set_init(&delimiters, delimiterString);
+	size_t maxFields = count_characters_in_set(row, length, &delimiters) + 1;
+	
+	size_t headerSize = (sizeof(SplitString) + sizeof(StringField) - 1) / sizeof(StringField) * sizeof(StringField); // Keep the field array aligned.
+	unsigned char *block = (unsigned char *)utilities_malloc(headerSize + maxFields * sizeof(StringField) + length + 1);
+	if (block == NULL)
+	{
+		return NULL;
+	}
+	
+	SplitString *split = (SplitString *)block;
+	split->fields = (StringField *)(block + headerSize);
+	split->characters = (char *)(block + headerSize + maxFields * sizeof(StringField));
+	copy_memory_block(split->characters, row, length + 1);
+	
+	
+	/// Index the fields, unescape only the ones flagged as containing doubled quotes, and terminate each in place.
+	split->fieldCount = split_csv_fields(split->characters, length, delimiter, split->fields, (int)maxFields);
+	for (int i = 0; i < split->fieldCount; i++)
+	{
+		StringField *field = &split->fields[i];
+		if (field->flags & STRING_FIELD_ESCAPED_QUOTES)
+		{
+			field->length = csv_unescape_field(split->characters + field->offset, field->length);
+		}
+		split->characters[field->offset + field->length] = '\0';
+	}
+	
+	return split;
+}
+
+
+
+
+
+
+
+
+/**
+ * compactionShuffleTable
+ *
+ * For each 8-bit keep mask, the indices of the kept bytes of an 8-byte group in increasing order, packed one per byte(low byte first)
+ * and padded with zeros. Used as the shuffle control that moves the kept bytes of a group to its front.
+ */
+static const uint64_t compactionShuffleTable[256] =
+{
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000100ULL,
+	0x0000000000000002ULL, 0x0000000000000200ULL, 0x0000000000000201ULL, 0x0000000000020100ULL,
+	0x0000000000000003ULL, 0x0000000000000300ULL, 0x0000000000000301ULL, 0x0000000000030100ULL,
+	0x0000000000000302ULL, 0x0000000000030200ULL, 0x0000000000030201ULL, 0x0000000003020100ULL,
+	0x0000000000000004ULL, 0x0000000000000400ULL, 0x0000000000000401ULL, 0x0000000000040100ULL,
+	0x0000000000000402ULL, 0x0000000000040200ULL, 0x0000000000040201ULL, 0x0000000004020100ULL,
+	0x0000000000000403ULL, 0x0000000000040300ULL, 0x0000000000040301ULL, 0x0000000004030100ULL,
+	0x0000000000040302ULL, 0x0000000004030200ULL, 0x0000000004030201ULL, 0x0000000403020100ULL,
+	0x0000000000000005ULL, 0x0000000000000500ULL, 0x0000000000000501ULL, 0x0000000000050100ULL,
+	0x0000000000000502ULL, 0x0000000000050200ULL, 0x0000000000050201ULL, 0x0000000005020100ULL,
+	0x0000000000000503ULL, 0x0000000000050300ULL, 0x0000000000050301ULL, 0x0000000005030100ULL,
+	0x0000000000050302ULL, 0x0000000005030200ULL, 0x0000000005030201ULL, 0x0000000503020100ULL,
+	0x0000000000000504ULL, 0x0000000000050400ULL, 0x0000000000050401ULL, 0x0000000005040100ULL,
+	0x0000000000050402ULL, 0x0000000005040200ULL, 0x0000000005040201ULL, 0x0000000504020100ULL,
+	0x0000000000050403ULL, 0x0000000005040300ULL, 0x0000000005040301ULL, 0x0000000504030100ULL,
+	0x0000000005040302ULL, 0x0000000504030200ULL, 0x0000000504030201ULL, 0x0000050403020100ULL,
+	0x0000000000000006ULL, 0x0000000000000600ULL, 0x0000000000000601ULL, 0x0000000000060100ULL,
+	0x0000000000000602ULL, 0x0000000000060200ULL, 0x0000000000060201ULL, 0x0000000006020100ULL,
+	0x0000000000000603ULL, 0x0000000000060300ULL, 0x0000000000060301ULL, 0x0000000006030100ULL,
+	0x0000000000060302ULL, 0x0000000006030200ULL, 0x0000000006030201ULL, 0x0000000603020100ULL,
+	0x0000000000000604ULL, 0x0000000000060400ULL, 0x0000000000060401ULL, 0x0000000006040100ULL,
+	0x0000000000060402ULL, 0x0000000006040200ULL, 0x0000000006040201ULL, 0x0000000604020100ULL,
+	0x0000000000060403ULL, 0x0000000006040300ULL, 0x0000000006040301ULL, 0x0000000604030100ULL,
+	0x0000000006040302ULL, 0x0000000604030200ULL, 0x0000000604030201ULL, 0x0000060403020100ULL,
+	0x0000000000000605ULL, 0x0000000000060500ULL, 0x0000000000060501ULL, 0x0000000006050100ULL,
+	0x0000000000060502ULL, 0x0000000006050200ULL, 0x0000000006050201ULL, 0x0000000605020100ULL,
+	0x0000000000060503ULL, 0x0000000006050300ULL, 0x0000000006050301ULL, 0x0000000605030100ULL,
+	0x0000000006050302ULL, 0x0000000605030200ULL, 0x0000000605030201ULL, 0x0000060503020100ULL,
+	0x0000000000060504ULL, 0x0000000006050400ULL, 0x0000000006050401ULL, 0x0000000605040100ULL,
+	0x0000000006050402ULL, 0x0000000605040200ULL, 0x0000000605040201ULL, 0x0000060504020100ULL,
+	0x0000000006050403ULL, 0x0000000605040300ULL, 0x0000000605040301ULL, 0x0000060504030100ULL,
+	0x0000000605040302ULL, 0x0000060504030200ULL, 0x0000060504030201ULL, 0x0006050403020100ULL,
+	0x0000000000000007ULL, 0x0000000000000700ULL, 0x0000000000000701ULL, 0x0000000000070100ULL,
+	0x0000000000000702ULL, 0x0000000000070200ULL, 0x0000000000070201ULL, 0x0000000007020100ULL,
+	0x0000000000000703ULL, 0x0000000000070300ULL, 0x0000000000070301ULL, 0x0000000007030100ULL,
+	0x0000000000070302ULL, 0x0000000007030200ULL, 0x0000000007030201ULL, 0x0000000703020100ULL,
+	0x0000000000000704ULL, 0x0000000000070400ULL, 0x0000000000070401ULL, 0x0000000007040100ULL,
+	0x0000000000070402ULL, 0x0000000007040200ULL, 0x0000000007040201ULL, 0x0000000704020100ULL,
+	0x0000000000070403ULL, 0x0000000007040300ULL, 0x0000000007040301ULL, 0x0000000704030100ULL,
+	0x0000000007040302ULL, 0x0000000704030200ULL, 0x0000000704030201ULL, 0x0000070403020100ULL,
+	0x0000000000000705ULL, 0x0000000000070500ULL, 0x0000000000070501ULL, 0x0000000007050100ULL,
+	0x0000000000070502ULL, 0x0000000007050200ULL, 0x0000000007050201ULL, 0x0000000705020100ULL,
+	0x0000000000070503ULL, 0x0000000007050300ULL, 0x0000000007050301ULL, 0x0000000705030100ULL,
+	0x0000000007050302ULL, 0x0000000705030200ULL, 0x0000000705030201ULL, 0x0000070503020100ULL,
+	0x0000000000070504ULL, 0x0000000007050400ULL, 0x0000000007050401ULL, 0x0000000705040100ULL,
+	0x0000000007050402ULL, 0x0000000705040200ULL, 0x0000000705040201ULL, 0x0000070504020100ULL,
+	0x0000000007050403ULL, 0x0000000705040300ULL, 0x0000000705040301ULL, 0x0000070504030100ULL,
+	0x0000000705040302ULL, 0x0000070504030200ULL, 0x0000070504030201ULL, 0x0007050403020100ULL,
+	0x0000000000000706ULL, 0x0000000000070600ULL, 0x0000000000070601ULL, 0x0000000007060100ULL,
+	0x0000000000070602ULL, 0x0000000007060200ULL, 0x0000000007060201ULL, 0x0000000706020100ULL,
+	0x0000000000070603ULL, 0x0000000007060300ULL, 0x0000000007060301ULL, 0x0000000706030100ULL,
+	0x0000000007060302ULL, 0x0000000706030200ULL, 0x0000000706030201ULL, 0x0000070603020100ULL,
+	0x0000000000070604ULL, 0x0000000007060400ULL, 0x0000000007060401ULL, 0x0000000706040100ULL,
+	0x0000000007060402ULL, 0x0000000706040200ULL, 0x0000000706040201ULL, 0x0000070604020100ULL,
+	0x0000000007060403ULL, 0x0000000706040300ULL, 0x0000000706040301ULL, 0x0000070604030100ULL,
+	0x0000000706040302ULL, 0x0000070604030200ULL, 0x0000070604030201ULL, 0x0007060403020100ULL,
+	0x0000000000070605ULL, 0x0000000007060500ULL, 0x0000000007060501ULL, 0x0000000706050100ULL,
+	0x0000000007060502ULL, 0x0000000706050200ULL, 0x0000000706050201ULL, 0x0000070605020100ULL,
+	0x0000000007060503ULL, 0x0000000706050300ULL, 0x0000000706050301ULL, 0x0000070605030100ULL,
+	0x0000000706050302ULL, 0x0000070605030200ULL, 0x0000070605030201ULL, 0x0007060503020100ULL,
+	0x0000000007060504ULL, 0x0000000706050400ULL, 0x0000000706050401ULL, 0x0000070605040100ULL,
+	0x0000000706050402ULL, 0x0000070605040200ULL, 0x0000070605040201ULL, 0x0007060504020100ULL,
+	0x0000000706050403ULL, 0x0000070605040300ULL, 0x0000070605040301ULL, 0x0007060504030100ULL,
+	0x0000070605040302ULL, 0x0007060504030200ULL, 0x0007060504030201ULL, 0x0706050403020100ULL
+};
+
+
+/**
+ * compact_block16
+ *
+ * Writes the bytes of a 16-byte block whose bit is set in 'keepMask' to 'destination', in order, and returns how many were written.
+ * Each 8-byte half is packed with a table-driven byte shuffle(SSSE3 'pshufb', NEON 'tbl'), so there is no branch per byte.
+ * Up to 16 bytes are stored, the ones past the returned count are unspecified, and 'destination' may be at or before 'block'.
+ */
+static inline size_t compact_block16(unsigned char *destination, const unsigned char *block, uint32_t keepMask)
+{
+	uint32_t lowMask = keepMask & 0xFF;
+	uint32_t highMask = (keepMask >> 8) & 0xFF;
+	size_t lowCount = (size_t)__builtin_popcount(lowMask);
+	
+#if defined(SIMD_SSSE3_AVAILABLE)
+	__m128i control = _mm_set_epi64x((long long)(compactionShuffleTable[highMask] + 0x0808080808080808ULL), (long long)compactionShuffleTable[lowMask]);
+	__m128i packed = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)block), control);
+	_mm_storel_epi64((__m128i *)destination, packed);
+	_mm_storel_epi64((__m128i *)(destination + lowCount), _mm_unpackhi_epi64(packed, packed));
+#elif defined(SIMD_NEON_AVAILABLE)
+	uint8x16_t control = vcombine_u8(vcreate_u8(compactionShuffleTable[lowMask]), vcreate_u8(compactionShuffleTable[highMask] + 0x0808080808080808ULL));
+	uint8x16_t packed = vqtbl1q_u8(vld1q_u8(block), control);
+	vst1_u8(destination, vget_low_u8(packed));
+	vst1_u8(destination + lowCount, vget_high_u8(packed));
+#else
+	// Kept indices never precede their output position, so packing front to back is safe when compacting in place.
+	uint64_t lowIndices = compactionShuffleTable[lowMask];
+	uint64_t highIndices = compactionShuffleTable[highMask];
+	size_t highCount = (size_t)__builtin_popcount(highMask);
+	for (size_t k = 0; k < lowCount; k++)
+	{
+		destination[k] = block[(lowIndices >> (8 * k)) & 0xFF];
+	}
+	for (size_t k = 0; k < highCount; k++)
+	{
+		destination[lowCount + k] = block[8 + ((highIndices >> (8 * k)) & 0xFF)];
+	}
+#endif
+	
+	return lowCount + (size_t)__builtin_popcount(highMask);
+}
+
+
+/**
+ * remove_characters_in_set
+ *
+ * Copies an explicit-length buffer to 'destination' without the bytes that are members of a character set, i.e., a generic
+ * "remove bytes in class" compaction. For sets of up to 'CHARACTER_SET_SIMD_MEMBERS' members, a keep-mask is built per 16-byte block
+ * and the block is packed with 'compact_block16'(or per 64-byte block with AVX-512 VBMI2 'vpcompressb' when available),
+ * larger sets fall back to a branch-free scalar loop over the set's bitmap.
+ *
+ * @param destination The output buffer, which must have room for 'length' bytes since blocks are stored whole. It may be equal to 'source' to compact in place.
+ * @param source The bytes to be filtered, they do not need to be NULL-terminated.
+ * @param length The number of bytes in 'source'.
+ * @param set The set of characters to be removed.
+ * @return The number of bytes written to 'destination', no null terminator is appended.
+ */
+size_t remove_characters_in_set(char *destination, const char *source, size_t length, const CharacterSet *set)
+{
+	// Check for NULL input and handle error.
+	if (destination == NULL || source == NULL || set == NULL){ perror("\n\nError: NULL argument in 'remove_characters_in_set'.\n");      return 0; }
+	
+	
+	const unsigned char *src = (const unsigned char *)source;
+	unsigned char *dst = (unsigned char *)destination;
+	size_t readIndex = 0;
+	size_t writeIndex = 0;
+	
+	if (set->memberCount <= CHARACTER_SET_SIMD_MEMBERS)
+	{
+#if defined(SIMD_AVX512_VBMI2_AVAILABLE)
+		for (; readIndex + 64 <= length; readIndex += 64)
+		{
+			__m512i bytes = _mm512_loadu_si512((const void *)(src + readIndex));
+			__mmask64 removeMask = 0;
+			for (int k = 0; k < set->memberCount; k++)
+			{
+				removeMask |= _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8((char)set->members[k]));
+			}
+			_mm512_storeu_si512((void *)(dst + writeIndex), _mm512_maskz_compress_epi8(~removeMask, bytes));
+			writeIndex += (size_t)__builtin_popcountll(~removeMask);
+		}
+#endif
+		for (; readIndex + 16 <= length; readIndex += 16)
+		{
+			uint32_t keepMask = ~simd_any_equal_mask16(src + readIndex, set->members, set->memberCount) & 0xFFFF;
+			writeIndex += compact_block16(dst + writeIndex, src + readIndex, keepMask);
+		}
+	}
+	
+	
+	/// Remaining bytes: store unconditionally and advance only past the kept ones.
+	for (; readIndex < length; readIndex++)
+	{
+		unsigned char c = src[readIndex];
+		dst[writeIndex] = c;
+		writeIndex += !character_set_contains(set, (char)c);
+	}
+	return writeIndex;
+}
+
+
+
+
+/**
+ * trim_string_view
+ *
+ * Trims leading and trailing whitespace from an explicit-length string without copying or modifying it.
+ *
+ * @param characters The characters to be trimmed, they do not need to be NULL-terminated.
+ * @param length The number of characters.
+ * @return A view of the trimmed characters within the original string, of length 0 if the string is entirely whitespace.
+ */
+StringView trim_string_view(const char *characters, size_t length)
+{
+	StringView trimmed = { characters, 0 };
+	if (characters == NULL)
+	{
+		return trimmed;
+	}
+	
+	size_t start = 0;
+	while (start < length && char_is_whitespace(characters[start]))
+	{
+		start++;
+	}
+	while (length > start && char_is_whitespace(characters[length - 1]))
+	{
+		length--;
+	}
+	
+	trimmed.characters = characters + start;
+	trimmed.length = length - start;
+	return trimmed;
+}
+
+
+/**
+ * trim_string_whitespaces_in_place
+ *
+ * Trims leading and trailing whitespace from a string by compacting it within its own buffer.
+ *
+ * @param characterString The NULL-terminated string to be trimmed.
+ * @return The new length of the string.
+ */
+size_t trim_string_whitespaces_in_place(char *characterString)
+{
+	if (characterString == NULL)
+	{
+		return 0;
+	}
+	
+	StringView trimmed = trim_string_view(characterString, string_length(characterString));
+	if (trimmed.characters != characterString)
+	{
+		for (size_t i = 0; i < trimmed.length; i++) // Forward copy, the destination never overtakes the source
+		{
+			characterString[i] = trimmed.characters[i];
+		}
+	}
+	characterString[trimmed.length] = '\0';
+	return trimmed.length;
+}
+
+
+/**
+ * trim_string_whitespaces
+ *
+ * Trims leading and trailing whitespace from a string and returns a new string.
+ * This function removes all whitespace characters from the beginning and end
+ * of the provided string. Whitespace is defined as any character for which
+ * the isspace() function returns true (i.e., space, tab, newline).
+ *
+ *
+ * @param untrimmedString A pointer to the string to be trimmed.
+ * @return A pointer to the newly allocated trimmed string, or NULL if the input string is NULL or empty.
+ */
+char *trim_string_whitespaces(char* untrimmedString)
+{
+	// Check for NULL or empty string
+	if (!untrimmedString || !*untrimmedString)
+	{
+		return NULL;
+	}
+	
+	
+	// Find the trimmed content without copying, then copy it exactly once
+	StringView trimmed = trim_string_view(untrimmedString, string_length(untrimmedString));
+	return duplicate_n_string(trimmed.characters, trimmed.length);
+}
+
+
+
+
+/**
+ * whitespaceCharacterSet
+ *
+ * The characters accepted by 'char_is_whitespace', as a character set.
+ */
+static const CharacterSet whitespaceCharacterSet =
+{
+	.bits = { (1ULL << ' ') | (1ULL << '\t') | (1ULL << '\n') | (1ULL << '\v') | (1ULL << '\f') | (1ULL << '\r'), 0, 0, 0 },
+	.members = { ' ', '\t', '\n', '\v', '\f', '\r' },
+	.memberCount = 6
+};
+
+
+/**
+ * prune_string_whitespaces_in_place
+ *
+ * Removes all whitespace characters from a string by compacting it within its own buffer.
+ * The compaction is performed 16 bytes at a time by 'remove_characters_in_set'.
+ *
+ * @param characterString The NULL-terminated string to be pruned.
+ * @return The new length of the string.
+ */
+size_t prune_string_whitespaces_in_place(char *characterString)
+{
+	if (characterString == NULL)
+	{
+		return 0;
+	}
+	
+	size_t prunedLength = remove_characters_in_set(characterString, characterString, string_length(characterString), &whitespaceCharacterSet);
+	characterString[prunedLength] = '\0';
+	return prunedLength;
+}
+
+
+/**
+ * prune_string_whitespaces
+ *
+ * Removes all whitespace characters from a string and returns a new string.
+ * This function removes all whitespace characters (as defined by isspace())
+ * from the provided string.
+ *
+ * @param unprunedString A pointer to the string from which whitespaces are to be removed.
+ * @return A pointer to the newly allocated pruned string, or NULL if the input string is NULL or empty.
+ */
+char *prune_string_whitespaces(char *unprunedString)
+{
+	// Check for NULL or empty string
+	if (!unprunedString || !*unprunedString)
+	{
+		return NULL;
+	}
+	
+	// Copy the string once and prune the copy in place
+	char *prunedString = duplicate_string(unprunedString);
+	if (!prunedString)
+	{
+		return NULL; // Allocation failed
+	}
+	
+	prune_string_whitespaces_in_place(prunedString);
+	return prunedString;
+}
+
+
+
+
+/**
+ * count_repeated_delimiters
+ *
+ * Counts the positions at which a delimiter is immediately followed by another, i.e., the number of '0' characters
+ * that 'prune_repeated_delimiters_from_string' inserts.
+ */
+static size_t count_repeated_delimiters(const char *characterString, size_t length, char delimiter)
+{
+	size_t repeats = 0;
+	for (size_t i = 0; i + 1 < length; i++)
+	{
+		repeats += (characterString[i] == delimiter && characterString[i + 1] == delimiter);
+	}
+	return repeats;
+}
+
+
+/**
+ * prune_repeated_delimiters_in_place
+ *
+ * Inserts a '0' character between consecutive delimiters of a string within its own buffer, see
+ * 'prune_repeated_delimiters_from_string'. The insertions are made in a single backward pass, so every character moves at most once.
+ *
+ * @param characterString The NULL-terminated string to be processed.
+ * @param capacity The size of the buffer holding the string, including room for its null terminator.
+ * @param delimiter The delimiter character used to identify consecutive occurrences.
+ * @return The new length of the string. If this is not less than 'capacity' the buffer was too small and the string was left unchanged.
+ */
+size_t prune_repeated_delimiters_in_place(char *characterString, size_t capacity, const char *delimiter)
+{
+	if (characterString == NULL || delimiter == NULL)
+	{
+		return 0;
+	}
+	
+	size_t length = string_length(characterString);
+	size_t newLength = length + count_repeated_delimiters(characterString, length, *delimiter);
+	if (newLength >= capacity || newLength == length)
+	{
+		return newLength;
+	}
+	
+	
+	// Walk backwards, writing each character to its final position and a '0' after every delimiter that follows another
+	size_t readIndex = length;
+	size_t writeIndex = newLength;
+	characterString[newLength] = '\0';
+	while (readIndex > 0)
+	{
+		readIndex--;
+		characterString[--writeIndex] = characterString[readIndex];
+		if (characterString[readIndex] == *delimiter && readIndex > 0 && characterString[readIndex - 1] == *delimiter)
+		{
+			characterString[--writeIndex] = '0';
+		}
+	}
+	return newLength;
+}
+
+
+/**
+ * prune_repeated_delimiters_from_string
+ *
+ * Inserts a '0' character between consecutive delimiters in a string and returns a new string.
+ * This function is particularly useful for processing CSV data. It ensures that empty fields
+ * (indicated by consecutive delimiters) are explicitly represented with a '0' value, aiding in
+ * correct data alignment during parsing.
+ *
+ *
+ * @param unprunedString A pointer to the string to be processed.
+ * @param delimiter The delimiter character used to identify consecutive occurrences.
+ *        If the string is NULL or empty, the function returns NULL.
+ * @return A pointer to the newly allocated processed string, or NULL if the input string is NULL or empty.
+ */
+char *prune_repeated_delimiters_from_string(char *unprunedString, const char *delimiter)
+{
+	// Check for NULL or empty string
+	if (!unprunedString || !*unprunedString)
+	{
+		return NULL;
+	}
+	
+	
+	/// Allocate memory for the exact length of the new string, i.e., including the additional '0' characters required
+	size_t originalLength = string_length(unprunedString);
+	size_t capacity = originalLength + count_repeated_delimiters(unprunedString, originalLength, *delimiter) + 1;
+	char *prunedString = (char *)utilities_malloc(capacity);
+	if (!prunedString)
+	{
+		return NULL; // Allocation failed
+	}
+	
+	
+	/// Copy the string once and insert the '0' characters in place
+	copy_memory_block(prunedString, unprunedString, originalLength + 1);
+	prune_repeated_delimiters_in_place(prunedString, capacity, delimiter);
+	return prunedString;
+}
+
+
+
+
+/**
+ * ensure_output_capacity
+ *
+ * Grows a heap buffer to hold at least 'required' bytes, at least doubling it so repeated growth stays amortized linear.
+ */
+static void ensure_output_capacity(char **output, size_t *outputCapacity, size_t required)
+{
+	if (required <= *outputCapacity)
+	{
+		return;
+	}
+	
+	size_t newCapacity = (*outputCapacity * 2 > required) ? *outputCapacity * 2 : required;
+	char *grown = (char *)utilities_realloc(*output, newCapacity);
+	if (grown == NULL){ perror("\n\nError: Unable to allocate memory in 'ensure_output_capacity'.\n");      exit(1); }
+	
+	*output = grown;
+	*outputCapacity = newCapacity;
+}
+
+
+/**
+ * parse_date_time_field
+ *
+ * Parses a NULL-terminated field with the formats of 'commonDateTimeFormats', with the same matching and conversion rules as
+ * 'string_is_date_time' and 'convert_to_unix_time' but in a single pass over the formats. Fields that cannot match any
+ * format, i.e., that do not start with a digit or contain no ':', are rejected without calling 'strptime'. A 'formatIndex' >= 0
+ * tries only that format, which is how rows are converted against a 'RowSchema' without detecting their formats again.
+ *
+ * @return The index of the format that matched the whole field, in which case its Unix time(or -1 if it could not be represented) is stored in 'unixTime', or -1 if none matched.
+ */
+static int parse_date_time_field(const char *field, size_t length, int formatIndex, time_t *unixTime)
+{
+	INSTRUMENT_FUNCTION(INSTRUMENT_PARSE_DATE_TIME_FIELD);
+	
+	if (length == 0 || !char_is_digit(field[0]) || find_byte_n((const unsigned char *)field, length, ':') == NULL)
+	{
+		return -1;
+	}
+	
+	int matchedFormat = -1;
+	int firstFormat = (formatIndex >= 0) ? formatIndex : 0;
+	int lastFormat = (formatIndex >= 0) ? formatIndex : 11;
+	*unixTime = -1;
+	for (int i = firstFormat; i <= lastFormat; i++)
+	{
+		struct tm tm;
+		set_memory_block(&tm, 0, sizeof(struct tm));
+		char *parsed = strptime(field, commonDateTimeFormats[i], &tm);
+		if (parsed != NULL && *parsed == '\0')
+		{
+			matchedFormat = i;
+			*unixTime = convert_tm_to_unix_time(&tm);
+			if (*unixTime != -1)
+			{
+				break;
+			}
+		}
+	}
+	return matchedFormat;
+}
+
+
+/**
+ * split_row_fields
+ *
+ * Splits a row on its delimiters(keeping empty fields) into a growable array of fields, returning the field count.
+ */
+static int split_row_fields(const char *row, const char *delimiter, StringField **fields, int *fieldCapacity)
+{
+	size_t length = string_length(row);
+	int fieldCount = split_string_fields(row, length, delimiter, false, *fields, *fieldCapacity);
+	if (fieldCount > *fieldCapacity)
+	{
+		utilities_free(*fields);
+		*fieldCapacity = fieldCount * 2;
+		*fields = (StringField *)utilities_malloc(*fieldCapacity * sizeof(StringField));
+		if (*fields == NULL){ perror("\n\nError: Unable to allocate memory in 'split_row_fields'.\n");      exit(1); }
+		split_string_fields(row, length, delimiter, false, *fields, *fieldCapacity);
+	}
+	return fieldCount;
+}
+
+
+/**
+ * cleaning_pipeline_init
+ *
+ * Initializes an empty cleaning pipeline for rows delimited by the characters of 'delimiter', stages are then added with
+ * 'cleaning_pipeline_add_builtin' and the 'cleaning_pipeline_add_*_stage' functions and run, fused, by 'cleaning_pipeline_run'.
+ *
+ * @param pipeline The pipeline to initialize.
+ * @param delimiter The delimiter characters separating fields, the first of which is the one checked for repetition.
+ */
+void cleaning_pipeline_init(CleaningPipeline *pipeline, const char *delimiter)
+{
+	// Check for NULL input and handle error.
+	if (pipeline == NULL || delimiter == NULL){ perror("\n\nError: pipeline and/or delimiter was NULL in 'cleaning_pipeline_init'.\n");      return; }
+	
+	
+	set_memory_block(pipeline, 0, sizeof(CleaningPipeline));
+	character_set_init(&pipeline->delimiters, delimiter);
+	pipeline->repeatedDelimiter = delimiter[0];
+	pipeline->dateFieldCount = INT_MAX;
+	pipeline->dateTimeFormats = NULL;
+}
+
+
+/**
+ * add_pipeline_stage
+ *
+ * Appends a stage to the list of stages of its kind, in registration order.
+ *
+ * @return false if the pipeline already has 'PIPELINE_MAX_STAGES' stages of that kind.
+ */
+static bool add_pipeline_stage(CleaningPipeline *pipeline, PipelineStage stage)
+{
+	PipelineStage *stages = (stage.kind == PIPELINE_STAGE_PER_BYTE) ? pipeline->byteStages : (stage.kind == PIPELINE_STAGE_PER_FIELD) ? pipeline->fieldStages : pipeline->rowStages;
+	int *stageCount = (stage.kind == PIPELINE_STAGE_PER_BYTE) ? &pipeline->byteStageCount : (stage.kind == PIPELINE_STAGE_PER_FIELD) ? &pipeline->fieldStageCount : &pipeline->rowStageCount;
+	if (*stageCount >= PIPELINE_MAX_STAGES)
+	{
+		return false;
+	}
+	
+	stages[(*stageCount)++] = stage;
+	return true;
+}
+
+
+/**
+ * cleaning_pipeline_add_builtin
+ *
+ * Adds one of the built-in stages, each of which declares its own kind: whitespace pruning is per byte, and field trimming, the '0'
+ * placeholder for the empty field between repeated delimiters, and the date/time to Unix time conversion are per field.
+ *
+ * @param pipeline The pipeline to add the stage to.
+ * @param builtin The built-in stage.
+ * @return false if the pipeline is NULL or already has 'PIPELINE_MAX_STAGES' stages of the stage's kind.
+ */
+bool cleaning_pipeline_add_builtin(CleaningPipeline *pipeline, PipelineBuiltinStage builtin)
+{
+	// Check for NULL input and handle error.
+	if (pipeline == NULL){ perror("\n\nError: pipeline was NULL in 'cleaning_pipeline_add_builtin'.\n");      return false; }
+	
+	
+	PipelineStage stage;
+	set_memory_block(&stage, 0, sizeof(PipelineStage));
+	stage.kind = (builtin == PIPELINE_PRUNE_WHITESPACE) ? PIPELINE_STAGE_PER_BYTE : PIPELINE_STAGE_PER_FIELD;
+	stage.builtin = (int)builtin;
+	if (!add_pipeline_stage(pipeline, stage))
+	{
+		return false;
+	}
+	
+	pipeline->pruneWhitespace |= (builtin == PIPELINE_PRUNE_WHITESPACE);
+	return true;
+}
+
+
+/**
+ * cleaning_pipeline_add_byte_stage
+ *
+ * Adds a per-byte callback, run on every byte of a field(delimiters are not passed to it) as the byte is copied. The callback returns
+ * the byte to write in its place, or -1 to drop it.
+ *
+ * @param pipeline The pipeline to add the stage to.
+ * @param function The callback.
+ * @param context Passed to every call of the callback.
+ * @return false if the pipeline or callback is NULL or the pipeline already has 'PIPELINE_MAX_STAGES' per-byte stages.
+ */
+bool cleaning_pipeline_add_byte_stage(CleaningPipeline *pipeline, PipelineByteFunction function, void *context)
+{
+	// Check for NULL input and handle error.
+	if (pipeline == NULL || function == NULL){ perror("\n\nError: pipeline and/or function was NULL in 'cleaning_pipeline_add_byte_stage'.\n");      return false; }
+	
+	
+	PipelineStage stage;
+	set_memory_block(&stage, 0, sizeof(PipelineStage));
+	stage.kind = PIPELINE_STAGE_PER_BYTE;
+	stage.builtin = -1;
+	stage.byteFunction = function;
+	stage.context = context;
+	return add_pipeline_stage(pipeline, stage);
+}
+
+
+/**
+ * cleaning_pipeline_add_field_stage
+ *
+ * Adds a per-field callback, run on each field as soon as it has been written, while it is still the tail of the output. The callback
+ * rewrites the field in place and returns its new length. Like 'snprintf', if the result would need more than 'capacity' bytes it
+ * returns the length it needs without modifying the field, and it is called again with at least that capacity.
+ *
+ * @param pipeline The pipeline to add the stage to.
+ * @param function The callback.
+ * @param context Passed to every call of the callback.
+ * @return false if the pipeline or callback is NULL or the pipeline already has 'PIPELINE_MAX_STAGES' per-field stages.
+ */
+bool cleaning_pipeline_add_field_stage(CleaningPipeline *pipeline, PipelineFieldFunction function, void *context)
+{
+	// Check for NULL input and handle error.
+	if (pipeline == NULL || function == NULL){ perror("\n\nError: pipeline and/or function was NULL in 'cleaning_pipeline_add_field_stage'.\n");      return false; }
+	
+	
+	PipelineStage stage;
+	set_memory_block(&stage, 0, sizeof(PipelineStage));
+	stage.kind = PIPELINE_STAGE_PER_FIELD;
+	stage.builtin = -1;
+	stage.fieldFunction = function;
+	stage.context = context;
+	return add_pipeline_stage(pipeline, stage);
+}
+
+
+/**
+ * cleaning_pipeline_add_row_stage
+ *
+ * Adds a per-row callback, run on the whole cleaned row once its last field has been closed, with the same in-place and
+ * capacity conventions as a per-field callback.
+ *
+ * @param pipeline The pipeline to add the stage to.
+ * @param function The callback.
+ * @param context Passed to every call of the callback.
+ * @return false if the pipeline or callback is NULL or the pipeline already has 'PIPELINE_MAX_STAGES' per-row stages.
+ */
+bool cleaning_pipeline_add_row_stage(CleaningPipeline *pipeline, PipelineRowFunction function, void *context)
+{
+	// Check for NULL input and handle error.
+	if (pipeline == NULL || function == NULL){ perror("\n\nError: pipeline and/or function was NULL in 'cleaning_pipeline_add_row_stage'.\n");      return false; }
+	
+	
+	PipelineStage stage;
+	set_memory_block(&stage, 0, sizeof(PipelineStage));
+	stage.kind = PIPELINE_STAGE_PER_ROW;
+	stage.builtin = -1;
+	stage.rowFunction = function;
+	stage.context = context;
+	return add_pipeline_stage(pipeline, stage);
+}
+
+
+/**
+ * cleaning_pipeline_set_schema
+ *
+ * Restricts the 'PIPELINE_DATE_TIME_TO_UNIX' stage to the date/time columns of a schema from 'infer_row_schema', each parsed with
+ * its column's format, a NULL schema restoring the default of trying every format on every field.
+ *
+ * @param pipeline The pipeline to configure.
+ * @param schema The schema of the rows, may be NULL.
+ */
+void cleaning_pipeline_set_schema(CleaningPipeline *pipeline, const RowSchema *schema)
+{
+	// Check for NULL input and handle error.
+	if (pipeline == NULL){ perror("\n\nError: pipeline was NULL in 'cleaning_pipeline_set_schema'.\n");      return; }
+	
+	
+	pipeline->dateFieldCount = (schema != NULL) ? schema->dateFieldCount : INT_MAX;
+	pipeline->dateTimeFormats = (schema != NULL) ? schema->dateTimeFormats : NULL;
+}
+
+
+/**
+ * init_default_pipeline
+ *
+ * Builds the pipeline of 'prune_and_trim_problematic_characters_from_string': whitespace pruning(which subsumes trimming), the '0'
+ * placeholder between repeated delimiters and, for the first 'dateFieldCount' fields, date/time to Unix time conversion.
+ */
+static void init_default_pipeline(CleaningPipeline *pipeline, const char *delimiter, int dateFieldCount, const int *dateTimeFormats)
+{
+	cleaning_pipeline_init(pipeline, delimiter);
+	cleaning_pipeline_add_builtin(pipeline, PIPELINE_PRUNE_WHITESPACE);
+	cleaning_pipeline_add_builtin(pipeline, PIPELINE_FILL_REPEATED_DELIMITERS);
+	if (dateFieldCount > 0)
+	{
+		cleaning_pipeline_add_builtin(pipeline, PIPELINE_DATE_TIME_TO_UNIX);
+	}
+	pipeline->dateFieldCount = dateFieldCount;
+	pipeline->dateTimeFormats = dateTimeFormats;
+}
+
+
+/**
+ * run_resizable_stage
+ *
+ * Runs a per-field or per-row stage on the tail of the output starting at 'start', growing the output and calling the stage again
+ * when its result needs more room, while keeping 'reserve' bytes free behind it for the rest of the row.
+ *
+ * @return The new length of the tail.
+ */
+static size_t run_resizable_stage(const PipelineStage *stage, char **output, size_t *outputCapacity, size_t start, size_t length, size_t reserve, int fieldIndex)
+{
+	for (;;)
+	{
+		size_t capacity = *outputCapacity - start - reserve;
+		size_t newLength = (stage->kind == PIPELINE_STAGE_PER_FIELD) ? stage->fieldFunction(*output + start, length, capacity, fieldIndex, stage->context) : stage->rowFunction(*output + start, length, capacity, stage->context);
+		if (newLength <= capacity)
+		{
+			return newLength;
+		}
+		ensure_output_capacity(output, outputCapacity, start + newLength + reserve);
+	}
+}
+
+
+/**
+ * cleaning_pipeline_run
+ *
+ * Fused, single-pass cleaning engine: every stage of the pipeline is applied during one scan of the row, with no intermediate strings,
+ * whatever the number of stages. Per-byte stages are applied to each byte as it is copied, per-field stages to each field as soon as
+ * it has been written(while it is still the tail of the output, so a stage that changes its length never has to move what follows),
+ * and per-row stages to the finished row. Stages of one kind run in the order they were added.
+ *
+ * The input is read 16 bytes at a time where possible: when the only per-byte stage is the built-in whitespace pruning, the bytes of a
+ * block up to its first delimiter are packed to the output by the 'compact_block16' kernel with their whitespace removed, and only the
+ * delimiters are examined individually. Per-byte callbacks need every byte individually, and disable the block copy.
+ *
+ * The output buffer follows the 'getline' convention: '*output' may be NULL with '*outputCapacity' 0, and it is grown with
+ * 'realloc' as needed, so a caller processing many rows can reuse one buffer for all of them.
+ *
+ * @param pipeline The pipeline to run.
+ * @param characterString The string to be cleaned, it does not need to be NULL-terminated.
+ * @param length The number of bytes in the string.
+ * @param output Pointer to the output buffer, which receives the NULL-terminated cleaned string.
+ * @param outputCapacity Pointer to the capacity of the output buffer.
+ * @return The length of the cleaned string.
+ */
+size_t cleaning_pipeline_run(const CleaningPipeline *pipeline, const char *characterString, size_t length, char **output, size_t *outputCapacity)
+{
+	// Check for NULL input and handle error.
+	if (pipeline == NULL || characterString == NULL || output == NULL || outputCapacity == NULL){ perror("\n\nError: NULL argument in 'cleaning_pipeline_run'.\n");      return 0; }
+	
+	
+	/// Every input byte produces at most two output bytes(a '0' and a delimiter), which is the invariant that lets the copy loops run unchecked,
+	/// only the per-field and per-row stages can grow the output beyond that.
+	ensure_output_capacity(output, outputCapacity, 2 * length + PIPELINE_FIELD_HEADROOM + 1);
+	
+	const CharacterSet *delimiters = &pipeline->delimiters;
+	const char repeatedDelimiter = pipeline->repeatedDelimiter;
+	const bool byteCallbacks = (pipeline->byteStageCount > (pipeline->pruneWhitespace ? 1 : 0));
+	
+	
+	/// The bytes that end a run: the whitespace characters when they are pruned and the delimiters, when there are few enough to compare against in a vector.
+	unsigned char specialBytes[CHARACTER_SET_SIMD_MEMBERS] = { ' ', '\t', '\n', '\v', '\f', '\r' };
+	int specialCount = pipeline->pruneWhitespace ? 6 : 0;
+	bool useSimd = !byteCallbacks && (delimiters->memberCount <= CHARACTER_SET_SIMD_MEMBERS - specialCount);
+	for (int i = 0; useSimd && i < delimiters->memberCount; i++)
+	{
+		specialBytes[specialCount++] = delimiters->members[i];
+	}
+	
+	
+	const unsigned char *source = (const unsigned char *)characterString;
+	size_t readIndex = 0;
+	size_t writeIndex = 0;
+	size_t fieldStart = 0;
+	int fieldIndex = 0;
+	char previousDelimiter = '\0';
+	bool atEnd = false;
+	
+	while (!atEnd)
+	{
+		/// Copy the bytes up to the next delimiter, dropping the whitespace among them with the block compaction kernel.
+		if (useSimd)
+		{
+			while (readIndex + 16 <= length)
+			{
+				const unsigned char *block = source + readIndex;
+				uint32_t specialMask = simd_any_equal_mask16(block, specialBytes, specialCount);
+				uint32_t delimiterMask = specialMask ? simd_any_equal_mask16(block, delimiters->members, delimiters->memberCount) : 0;
+				size_t span = delimiterMask ? (size_t)__builtin_ctz(delimiterMask) : 16;
+				writeIndex += compact_block16((unsigned char *)*output + writeIndex, block, ~specialMask & ((1u << span) - 1));
+				readIndex += span;
+				if (delimiterMask)
+				{
+					break;
+				}
+			}
+		}
+		
+		
+		/// Handle the next byte, the end of the input closes the last field.
+		char c = '\0';
+		atEnd = (readIndex >= length);
+		if (!atEnd)
+		{
+			c = characterString[readIndex++];
+			if (!character_set_contains(delimiters, c))
+			{
+				if (!byteCallbacks)
+				{
+					if (!pipeline->pruneWhitespace || !char_is_whitespace(c))
+					{
+						(*output)[writeIndex++] = c;
+					}
+					continue;
+				}
+				
+				int transformed = (unsigned char)c;
+				for (int s = 0; s < pipeline->byteStageCount && transformed >= 0; s++)
+				{
+					const PipelineStage *stage = &pipeline->byteStages[s];
+					if (stage->builtin == PIPELINE_PRUNE_WHITESPACE)
+					{
+						transformed = char_is_whitespace((char)transformed) ? -1 : transformed;
+					}
+					else
+					{
+						transformed = stage->byteFunction((unsigned char)transformed, stage->context);
+					}
+				}
+				if (transformed >= 0)
+				{
+					(*output)[writeIndex++] = (char)transformed;
+				}
+				continue;
+			}
+		}
+		
+		
+		/// Close the current field by running the per-field stages on it.
+		size_t reserve = 2 * (length - readIndex) + 2; // Room for the rest of the input at two bytes per byte, this field's delimiter and the terminator.
+		for (int s = 0; s < pipeline->fieldStageCount; s++)
+		{
+			const PipelineStage *stage = &pipeline->fieldStages[s];
+			size_t fieldLength = writeIndex - fieldStart;
+			char *field = *output + fieldStart;
+			switch (stage->builtin)
+			{
+				case PIPELINE_TRIM_FIELDS:
+				{
+					StringView trimmed = trim_string_view(field, fieldLength);
+					for (size_t i = 0; i < trimmed.length; i++) // Forward copy, the destination never overtakes the source
+					{
+						field[i] = trimmed.characters[i];
+					}
+					writeIndex = fieldStart + trimmed.length;
+					break;
+				}
+				case PIPELINE_FILL_REPEATED_DELIMITERS:
+					// An empty field directly between two repeated delimiters gets a '0' placeholder.
+					if (fieldLength == 0 && fieldIndex > 0 && !atEnd && c == repeatedDelimiter && previousDelimiter == repeatedDelimiter)
+					{
+						(*output)[writeIndex++] = '0';
+					}
+					break;
+				case PIPELINE_DATE_TIME_TO_UNIX:
+					/// With a schema only the date/time columns are parsed, with their format, falling back to every format for a value formatted unlike the sample.
+					if (fieldIndex < pipeline->dateFieldCount && (pipeline->dateTimeFormats == NULL || pipeline->dateTimeFormats[fieldIndex] >= 0))
+					{
+						time_t unixTime;
+						int formatIndex = (pipeline->dateTimeFormats != NULL) ? pipeline->dateTimeFormats[fieldIndex] : -1;
+						field[fieldLength] = '\0'; // Terminate the field in place for 'strptime'.
+						if (parse_date_time_field(field, fieldLength, formatIndex, &unixTime) >= 0 ||
+							(formatIndex >= 0 && parse_date_time_field(field, fieldLength, -1, &unixTime) >= 0))
+						{
+							// The Unix time may be longer than the field.
+							ensure_output_capacity(output, outputCapacity, fieldStart + NUMBER_FORMAT_BUFFER_SIZE + reserve);
+							writeIndex = fieldStart + format_int64((int64_t)unixTime, *output + fieldStart);
+						}
+					}
+					break;
+				default:
+					writeIndex = fieldStart + run_resizable_stage(stage, output, outputCapacity, fieldStart, fieldLength, reserve, fieldIndex);
+					break;
+			}
+		}
+		fieldIndex++;
+		
+		if (!atEnd)
+		{
+			ensure_output_capacity(output, outputCapacity, writeIndex + reserve);
+			(*output)[writeIndex++] = c;
+			fieldStart = writeIndex;
+			previousDelimiter = c;
+		}
+	}
+	
+	
+	/// Run the per-row stages on the finished row.
+	for (int s = 0; s < pipeline->rowStageCount; s++)
+	{
+		writeIndex = run_resizable_stage(&pipeline->rowStages[s], output, outputCapacity, 0, writeIndex, 1, -1);
+	}
+	
+	(*output)[writeIndex] = '\0';
+	return writeIndex;
+}
+
+
+/**
+ * clean_delimited_fields
+ *
+ * Runs the pipeline of 'prune_and_trim_problematic_characters_from_string' on a row, converting date/times in the first 'dateFieldCount' fields,
+ * with the formats of 'dateTimeFormats'(per field index into 'commonDateTimeFormats' or -1 for fields that are not date/times) or, if NULL, with every format.
+ */
+static size_t clean_delimited_fields(const char *characterString, size_t length, const char *delimiter, int dateFieldCount, const int *dateTimeFormats, char **output, size_t *outputCapacity)
+{
+	CleaningPipeline pipeline;
+	init_default_pipeline(&pipeline, delimiter, dateFieldCount, dateTimeFormats);
+	return cleaning_pipeline_run(&pipeline, characterString, length, output, outputCapacity);
+}
+
+
+/**
+ * clean_delimited_string
  *
- * @param stringArray The array of strings to concatenate.
- * @param stringCount The number of strings in the array.
- * @return A pointer to the newly allocated concatenated string.
+ * Cleans a row with 'clean_delimited_fields', checking the first 'dateFieldCount' fields for date/times with every format.
+ *
+ * @param characterString The string to be cleaned, it does not need to be NULL-terminated.
+ * @param length The number of bytes in the string.
+ * @param delimiter The delimiter characters separating fields, the first of which is the one checked for repetition.
+ * @param dateFieldCount Only the first 'dateFieldCount' fields are checked for date/times.
+ * @param output Pointer to the output buffer, which receives the NULL-terminated cleaned string.
+ * @param outputCapacity Pointer to the capacity of the output buffer.
+ * @return The length of the cleaned string.
  */
-char* concatenate_string_array(const char** stringArray, int stringCount, const char *delimiter)
+size_t clean_delimited_string(const char *characterString, size_t length, const char *delimiter, int dateFieldCount, char **output, size_t *outputCapacity)
 {
 	// Check for NULL input and handle error.
-	if (stringArray == NULL){ perror("\n\nError: stringArray was NULL in 'concatenate_string_array'.\n");      return 0; }
+	if (characterString == NULL || delimiter == NULL || output == NULL || outputCapacity == NULL){ perror("\n\nError: NULL argument in 'clean_delimited_string'.\n");      return 0; }
+	
+	
+	return clean_delimited_fields(characterString, length, delimiter, dateFieldCount, NULL, output, outputCapacity);
+}
+
+
+/**
+ * clean_delimited_string_with_schema
+ *
+ * Cleans a row with 'clean_delimited_fields' against a schema from 'infer_row_schema': only the fields of the schema's date/time
+ * columns are parsed, each with the format detected for its column, so no row is examined for date/times again.
+ *
+ * @param characterString The string to be cleaned, it does not need to be NULL-terminated.
+ * @param length The number of bytes in the string.
+ * @param delimiter The delimiter characters separating fields, the first of which is the one checked for repetition.
+ * @param schema The schema of the rows, NULL checks no field for date/times.
+ * @param output Pointer to the output buffer, which receives the NULL-terminated cleaned string.
+ * @param outputCapacity Pointer to the capacity of the output buffer.
+ * @return The length of the cleaned string.
+ */
+size_t clean_delimited_string_with_schema(const char *characterString, size_t length, const char *delimiter, const RowSchema *schema, char **output, size_t *outputCapacity)
+{
+	// Check for NULL input and handle error.
+	if (characterString == NULL || delimiter == NULL || output == NULL || outputCapacity == NULL){ perror("\n\nError: NULL argument in 'clean_delimited_string_with_schema'.\n");      return 0; }
+	
+	
+	if (schema == NULL)
+	{
+		return clean_delimited_fields(characterString, length, delimiter, 0, NULL, output, outputCapacity);
+	}
+	return clean_delimited_fields(characterString, length, delimiter, schema->dateFieldCount, schema->dateTimeFormats, output, outputCapacity);
+}
+
+
+/**
+ * infer_row_schema
+ *
+ * Determines once, from a sample of rows, the number of fields and which fields are date/times and in which format, so that every
+ * row can then be cleaned with 'clean_delimited_string_with_schema' without being examined for date/times again. The cost of the
+ * detection is therefore proportional to the sample rather than to the input.
+ *
+ * Each sampled row is cleaned exactly as it will be when processed(so the fields are those the engine sees), and a field is a
+ * date/time column if any of its sampled values matches one of 'commonDateTimeFormats', the format of the first match being the
+ * column's format. Fields beyond those of the sample are never date/times.
+ *
+ * @param stringArray Pointer to the array of rows, NULL and empty rows are skipped.
+ * @param stringCount Number of rows in the array.
+ * @param delimiter Pointer to the delimiter characters used in the rows.
+ * @param sampleCount Maximum number of rows to examine, a value <= 0 uses 'ROW_SCHEMA_SAMPLE_ROWS'.
+ * @return The schema, to be released with 'row_schema_destroy', or NULL if the array or delimiter is NULL.
+ */
+RowSchema *infer_row_schema(char **stringArray, int stringCount, const char *delimiter, int sampleCount)
+{
+	// Check for NULL input and handle error.
+	if (stringArray == NULL || delimiter == NULL){ perror("\n\nError: stringArray and/or delimiter was NULL in 'infer_row_schema'.\n");      return NULL; }
 	
 	
+	RowSchema *schema = (RowSchema *)utilities_malloc(sizeof(RowSchema));
+	if (schema == NULL){ perror("\n\nError: Unable to allocate memory in 'infer_row_schema'.\n");      exit(1); }
+	schema->fieldCount = 0;
+	schema->dateFieldCount = 0;
+	schema->dateTimeFormats = NULL;
 	
-	// Determine the length of the concatenated string
-	size_t totalLength = 0;
-	for (int i = 0; i < stringCount && stringArray[i] != NULL; i++)
+	if (sampleCount <= 0)
 	{
-		totalLength += string_length(stringArray[i]) + 1; // +1 for comma or null terminator
+		sampleCount = ROW_SCHEMA_SAMPLE_ROWS;
 	}
 	
-	// Allocate memory for the concatenated string
-	char* concatenated = (char*)malloc(totalLength * sizeof(char));// = allocate_memory_char_ptr(totalLength);
+	char *scratch = NULL;
+	size_t scratchCapacity = 0;
+	int fieldCapacity = 16;
+	StringField *fields = (StringField *)utilities_malloc(fieldCapacity * sizeof(StringField));
+	if (fields == NULL){ perror("\n\nError: Unable to allocate memory in 'infer_row_schema'.\n");      exit(1); }
 	
 	
-	int emptyStringCount = 0; // Track the number of empty strings
-	int *emptyStringIndices = (int*)malloc(stringCount * sizeof(int)); // = allocate_memory_int_ptr(stringCount); // Track the indices of empty strings
-	for (int i = 0; i < stringCount; i++)
+	for (int i = 0, sampled = 0; i < stringCount && sampled < sampleCount; i++)
 	{
-		if((stringArray[i] == NULL) || (compare_strings(stringArray[i], "") == 0) || (string_length(stringArray[i]) == 0) || (stringArray[i] == (void *)0) || (compare_strings(stringArray[i], delimiter) == 0))
+		if (stringArray[i] == NULL || stringArray[i][0] == '\0')
 		{
-			emptyStringCount++;
-			emptyStringIndices[i] = 1; // A value of 1 indicates an empty string and a value of 0 indicates a non-empty string
+			continue;
 		}
-		else
+		sampled++;
+		
+		/// Split the row as the engine will see it, then try the formats on the fields of the columns not yet known to be date/times.
+		clean_delimited_fields(stringArray[i], string_length(stringArray[i]), delimiter, 0, NULL, &scratch, &scratchCapacity);
+		int fieldCount = split_row_fields(scratch, delimiter, &fields, &fieldCapacity);
+		if (fieldCount > schema->fieldCount)
 		{
-			emptyStringIndices[i] = 0;
+			schema->dateTimeFormats = (int *)utilities_realloc(schema->dateTimeFormats, fieldCount * sizeof(int));
+			if (schema->dateTimeFormats == NULL){ perror("\n\nError: Unable to allocate memory in 'infer_row_schema'.\n");      exit(1); }
+			for (int j = schema->fieldCount; j < fieldCount; j++)
+			{
+				schema->dateTimeFormats[j] = -1;
+			}
+			schema->fieldCount = fieldCount;
+		}
+		
+		for (int j = 0; j < fieldCount; j++)
+		{
+			if (schema->dateTimeFormats[j] >= 0)
+			{
+				continue;
+			}
+			
+			time_t unixTime;
+			char *field = scratch + fields[j].offset;
+			char terminator = field[fields[j].length];
+			field[fields[j].length] = '\0';
+			schema->dateTimeFormats[j] = parse_date_time_field(field, fields[j].length, -1, &unixTime);
+			field[fields[j].length] = terminator;
+			if (schema->dateTimeFormats[j] >= 0 && j >= schema->dateFieldCount)
+			{
+				schema->dateFieldCount = j + 1;
+			}
+		}
+	}
+	
+	utilities_free(scratch);
+	utilities_free(fields);
+	return schema;
+}
+
+
+/**
+ * row_schema_destroy
+ *
+ * Frees a schema created by 'infer_row_schema'.
+ *
+ * @param schema The schema to destroy, may be NULL.
+ */
+void row_schema_destroy(RowSchema *schema)
+{
+	if (schema == NULL)
+	{
+		return;
+	}
+	
+	utilities_free(schema->dateTimeFormats);
+	utilities_free(schema);
+}
+
+
+
+
+/**
+ * prune_and_trim_problematic_characters_from_string
+ *
+ * Processes a string by trimming whitespace, pruning whitespace, handling repeated delimiters, and replacing date/time fields with Unix time.
+ * The function first trims leading and trailing whitespaces, then removes all internal whitespaces,
+ * handles repeated delimiters by inserting '0' characters, and finally replaces any date/time fields with their Unix time equivalents.
+ * All four steps are performed in a single pass by 'clean_delimited_string'.
+ *
+ * @param originalString Pointer to the original string to be processed.
+ * @param delimiter Pointer to the delimiter character used in the string.
+ * @param fieldCount Number of fields expected in the string.
+ * @return Pointer to the newly created string after processing, or NULL in case of an error or if the original string is NULL or empty.
+ */
+char *prune_and_trim_problematic_characters_from_string(char *originalString, const char *delimiter, const int fieldCount)
+{
+	// Check for NULL or empty string
+	if (!originalString || !*originalString)
+	{
+		return NULL;
+	}
+	
+	
+	char *cleanedString = NULL;
+	size_t capacity = 0;
+	size_t cleanedLength = clean_delimited_string(originalString, string_length(originalString), delimiter, fieldCount, &cleanedString, &capacity);
+	
+	
+	// The engine sizes its buffer for the worst case, give the excess back since the result is usually kept
+	char *fitString = utilities_realloc(cleanedString, cleanedLength + 1);
+	if (fitString)
+	{
+		cleanedString = fitString;
+	}
+	
+	return cleanedString;
+}
+
+
+
+
+
+
+
+
+/**
+ * replace_date_time_with_unix
+ *
+ * This function performs the task of replacing date/time fields in a given string with their Unix time
+ * representations. It identifies date/time fields based on predefined formats and performs the
+ * conversion when a field is a date/time string.
+ *
+ * The function begins by calling the string_is_date_time function to get an array indicating which fields are date/time fields.
+ * It then counts the number of fields that are identified as date/time fields.
+ * The function then estimates the size of the output string based on the number of date/time fields and the length of the input string.
+ * It allocates memory for the output string based on the estimated size.
+ * The function then duplicates the input string to avoid modifying it directly, as strtok modifies the string it processes.
+ * It then initializes the output string to an empty string and tokenizes the copied string using the delimiter character.
+ * The function then iterates over each token(field) in the string, checking if the current field is a date/time field.
+ * If it is, it converts the date/time field to Unix time, prepares a string to hold the Unix time, and appends the Unix time string to the output.
+ * If the field is not a date/time field, it appends it directly to the output.
+ * The function then appends the delimiter for the next field and increments the index.
+ * After iterating over all the fields, the function frees the memory allocated for the copy of the input string and the dateTimeIndicators array.
+ * It then null-terminates the new string and reallocates the output to fit the actual length.
+ * Finally, it returns the dynamically allocated output string.
+ *
+ *
+ * @param characterString Pointer to the string to be interpreted.
+ * @param delimiter The delimiter character used to identify consecutive occurrences.
+ * @param fieldCount The number of fields found in the string.
+ * @return A pointer to the newly allocated string with the date/time fields replaced with Unix time representations.
+ */
+char* replace_date_time_with_unix(char* characterString, const char *delimiter, const int fieldCount)
+{
+	// Call the string_is_date_time function to get an array indicating which fields are date/time fields.
+	int *dateTimeIndicators = string_is_date_time(characterString, delimiter, fieldCount);
+	
+	// Count the number of fields that are identified as date/time fields.
+	int dateTimeCount = 0;
+	for(int i = 0; i < fieldCount; i++)
+	{
+		if(dateTimeIndicators[i] == 1)
+		{
+			dateTimeCount++;
 		}
 	}
 	
+	if(dateTimeCount == 0)
+	{
+		//perror("\n\nError: No date/time fields found in the string in 'replace_date_time_with_unix'.");
+		utilities_free(dateTimeIndicators);
+		return NULL;
+	}
+	
+	
+	// The max Unix timestamp is theoretically up to 9,223,372,036,854,775,807, far in the future and has 19 digits, so max length would be 20 characters(19 plus null terminator)
+	size_t estimatedOutputSize = string_length(characterString) + dateTimeCount * 20;
 	
 	
 	
-	// Concatenate the fields
-	copy_string(concatenated, ""); // Initialize the string
-	for (int i = 0; i < stringCount && stringArray[i] != NULL; i++)
+	// Allocate memory for the output string based on the estimated size.
+	char *output = (char *)utilities_malloc(estimatedOutputSize);
+	
+	output[0] = '\0'; // Initialize the output string to an empty string
+	
+	// Tokenize the string using the delimiter character, the tokenizer leaves the input untouched so no duplicate is needed.
+	StringTokenizer tokenizer;
+	StringView token, nextToken;
+	string_tokenizer_init(&tokenizer, characterString, string_length(characterString), delimiter, true);
+	bool hasToken = string_tokenizer_next(&tokenizer, &token);
+	int index = 0; // Initialize an index to track the current field
+	
+	// Iterate over each token(field) in the string.
+	while (hasToken)
 	{
-		if(emptyStringIndices[i] == 1) // This string is empty
+		// Check if the current field is a date/time field.
+		if (index < fieldCount && dateTimeIndicators[index] == 1)
 		{
-			continue; // Skip this string
+			// Convert the date/time field to Unix time.
+			char fieldBuffer[DATE_TIME_FIELD_BUFFER_SIZE];
+			char *heapCopy;
+			time_t unixTime = convert_to_unix_time(terminate_field(token, fieldBuffer, sizeof(fieldBuffer), &heapCopy));
+			utilities_free(heapCopy);
+			
+			// Prepare a string to hold the Unix time.
+			char unixTimeString[NUMBER_FORMAT_BUFFER_SIZE];
+			format_int64((int64_t)unixTime, unixTimeString);
+			
+			// Append the Unix time string to the output.
+			concatenate_n_string(output, unixTimeString, estimatedOutputSize - string_length(output) - 1);
+		}
+		else
+		{
+			// If the field is not a date/time field, append it directly to the output.
+			concatenate_n_string(output, token.characters, token.length);
 		}
-		concatenate_string(concatenated, stringArray[i]);
 		
 		
-		if (i < stringCount - 1 && stringArray[i + 1] != NULL)// && count_character_occurrences(concatenated, delimiter[0]) < (stringCount - emptyStringCount) ) // Last string in the string array is not reached, the next string is not null(avoids interruptor strings), and the occurences of the delimiter is less than the number of strings
+		// Append delimiter for next field.
+		hasToken = string_tokenizer_next(&tokenizer, &nextToken);
+		if (hasToken && nextToken.length > 0 && index < fieldCount - 1)
 		{
-			// Because it is assumed we are in the midst of concatenating strings, the number of delimiters in the concatenated string should be less than
-			// or equal to the number of strings in the string array, if the number of delimiters is at any point equal to or greater than the number of strings,
-			// then it means that either the delimiter is not present as intended in the string array(very unlikely at this point) or it means that the delimiting
-			// character has been inserted into the string array at some point in an unintended manner.
-			
-			// If the last element in the string array is the delimiter then it means that either the last string is empty or the delimiter was inserted into the string array at some point in an unintended manner
-			concatenate_string(concatenated, delimiter);
+			concatenate_string(output, delimiter);
 		}
+		token = nextToken;
+		
+		// Increment the index
+		index++;
+	}
+	
+	// Free the memory allocated for the dateTimeIndicators array.
+	utilities_free(dateTimeIndicators);
+	
+	
+	
+	concatenate_string(output, "\0"); // Null-terminate the new string
+	
+	
+	
+	// Reallocate output to fit actual length.
+	// Included here because the estimated size has to be able to account for the maximum possible size of the
+	// outputted string, and since the outputted string usually changes minimnally in length from the inputtted string, it means that the estimate
+	// often greatly exceeds the actual needed size, hence it's good practice to reallocate here.
+	char *fitoutput = utilities_realloc(output, string_length(output) + 1);
+	if (fitoutput)
+	{
+		output = fitoutput;
 	}
 	
-	return concatenated;
+	
+	// Return the dynamically allocated output string.
+	return output;
 }
 
 
 
 
+#define PREPROCESS_ROWS_PER_CLAIM 256 // Rows claimed by a worker at a time, large enough to amortize the atomic and keep its writes on its own cache lines.
 
 
+/**
+ * PreprocessTask
+ *
+ * Shared state for the workers of 'preprocess_string_array_parallel'. Workers claim consecutive blocks of rows through an atomic
+ * cursor and store each result at the row's own index, so the output order never depends on the scheduling.
+ */
+typedef struct PreprocessTask
+{
+	char **stringArray;
+	char **processedStringArray;
+	int stringCount;
+	const RowSchema *schema;
+	const char *delimiter;
+	int nextRow; // Accessed atomically.
+} PreprocessTask;
 
 
 /**
- * tokenize_string
- *
- * This function tokenizes a string based on a delimiter character and returns the next token.
- * It is similar to the standard strtok function but is reentrant and thread-safe.
+ * preprocess_string_array_worker
  *
- * @param s The string to be tokenized.
- * @param delim The delimiter character used to tokenize the string.
- * @return A pointer to the next token in the string, or NULL if no more tokens are found.
+ * Thread entry point(also run directly by the serial version), cleans the claimed rows with 'clean_delimited_string' into a scratch
+ * buffer owned by the worker and stores an exact-size copy of each. All other state is on the worker's stack or thread-local.
  */
-char *tokenize_string(char *s, const char *delim)
+static void *preprocess_string_array_worker(void *argument)
 {
-	// Register variables for optimization
-	register char *spanp;
-	register int c, sc;
-	char *tok;
-	static char *last;
-	
-	// If s is NULL, use the saved pointer last
-	if (s == NULL && (s = last) == NULL)
-		return (NULL);
+	PreprocessTask *task = (PreprocessTask *)argument;
+	char *scratch = NULL;
+	size_t scratchCapacity = 0;
 	
-	// Skip leading delimiters
-cont:
-	c = *s++;
-	for (spanp = (char *)delim; (sc = *spanp++) != 0;)
-	{
-		if (c == sc)
-			goto cont;
-	}
-	
-	// If the end of the string is reached, return NULL
-	if (c == 0)
-	{
-		last = NULL;
-		return (NULL);
-	}
-	tok = s - 1;
-	
-	// Scan the token
 	for (;;)
 	{
-		c = *s++;
-		spanp = (char *)delim;
-		do
+		int firstRow = __atomic_fetch_add(&task->nextRow, PREPROCESS_ROWS_PER_CLAIM, __ATOMIC_RELAXED);
+		if (firstRow >= task->stringCount)
+		{
+			break;
+		}
+		
+		int lastRow = (task->stringCount - firstRow > PREPROCESS_ROWS_PER_CLAIM) ? firstRow + PREPROCESS_ROWS_PER_CLAIM : task->stringCount;
+		for (int i = firstRow; i < lastRow; i++)
 		{
-			if ((sc = *spanp++) == c)
+			const char *row = task->stringArray[i];
+			if (row == NULL || *row == '\0')
 			{
-				if (c == 0)
-					s = NULL;
-				else
-					s[-1] = 0;
-				last = s;
-				return (tok);
+				task->processedStringArray[i] = NULL;
+				continue;
 			}
-		} while (sc != 0);
+			
+			size_t cleanedLength = clean_delimited_string_with_schema(row, string_length(row), task->delimiter, task->schema, &scratch, &scratchCapacity);
+			task->processedStringArray[i] = duplicate_n_string(scratch, cleanedLength);
+			if (task->processedStringArray[i] == NULL){ perror("\n\nError: Memory allocation failed in 'preprocess_string_array_worker'.\n");      exit(1); }
+		}
 	}
-	// NOTREACHED
+	
+	utilities_free(scratch);
+	return NULL;
 }
 
 
-
-
 /**
- * split_tokenized_string
- *
- * Splits a string into an array of strings based on a given delimiter.
+ * preprocess_string_array
  *
+ * Processes an array of strings by trimming whitespace, pruning whitespace, handling repeated delimiters, and replacing date/time fields with Unix time.
+ * The function first trims leading and trailing whitespaces, then removes all internal whitespaces,
+ * handles repeated delimiters by inserting '0' characters, and finally replaces any date/time fields with their Unix time equivalents.
+ * Which fields are date/times, and in which format, is detected once from the first 'ROW_SCHEMA_SAMPLE_ROWS' rows by 'infer_row_schema',
+ * and every row is then converted against that schema.
  *
- * @param characterString The string to be split.
- * @param delimiter The delimiter used to split the string.
- * @param divisions The maximum number of parts to split the string into.
- * @return An array of strings, each representing a part of the original string.
+ * @param stringArray Pointer to the array of strings to be processed.
+ * @param stringCount Number of strings in the array.
+ * @param delimiter Pointer to the delimiter character used in the strings.
+ * @return Pointer to the newly created array of processed strings, or NULL in case of an error or if the original string array is NULL.
  */
-char** split_tokenized_string(const char* characterString, const char* delimiter, int divisions)
+char **preprocess_string_array(char **stringArray, int stringCount, const char *delimiter)
 {
-	char** parts = (char**)malloc(sizeof(char*) * (divisions + 1));
-	if (parts == NULL)
-	{
-		fprintf(stderr, "Memory allocation failed in split_tokenized_string\n");
-		exit(EXIT_FAILURE);
-	}
+	INSTRUMENT_FUNCTION(INSTRUMENT_PREPROCESS_STRING_ARRAY);
+	// Check for NULL input and handle error.
+	if (stringArray == NULL){ perror("\n\nError: stringArray was NULL in 'preprocess_string_array'.\n");      return 0; }
 	
-	char* strCopy = duplicate_string(characterString); // Duplicate the string to avoid modifying the original
-	if (strCopy == NULL)
+	
+	// Allocate memory for the new array
+	char **processedStringArray = (char **)utilities_malloc((stringCount + 1) * sizeof(char *));
+	if (processedStringArray == NULL)
 	{
-		fprintf(stderr, "Memory allocation failed in split_tokenized_string\n");
+		perror("\n\nError: Memory allocation failed in 'preprocess_string_array'.\n");
 		exit(EXIT_FAILURE);
 	}
 	
 	
-	//printf("\n\n\n\n characterString: %s \ndivisions: %d \ndelimiter: %s", characterString, divisions, delimiter);
-	char* token = tokenize_string(strCopy, delimiter);
-	int i = 0;
-	while (token != NULL && i < divisions)
-	{
-		parts[i] = duplicate_string(token);
-		
-		if (parts[i] == NULL)
-		{
-			fprintf(stderr, "Memory allocation failed in split_tokenized_string\n");
-			exit(EXIT_FAILURE);
-		}
-		
-		token = tokenize_string(NULL, delimiter);
-		i++;
-	}
-	//print_string_array(parts, i, "split_tokenized_string parts");
+	// Detect the date/time columns once from the leading rows, then process each string in the array on the calling thread, reusing one scratch buffer for every row
+	RowSchema *schema = infer_row_schema(stringArray, stringCount, delimiter, ROW_SCHEMA_SAMPLE_ROWS);
+	PreprocessTask task = { stringArray, processedStringArray, stringCount, schema, delimiter, 0 };
+	preprocess_string_array_worker(&task);
+	row_schema_destroy(schema);
 	
-	parts[i] = NULL; // Null-terminate the array
-	free(strCopy);
-	return parts;
+	// Null-terminate the array
+	processedStringArray[stringCount] = NULL;
+	return processedStringArray;
 }
 
 
 
-
-
-
-
-
 /**
- * trim_string_whitespaces
- *
- * Trims leading and trailing whitespace from a string and returns a new string.
- * This function removes all whitespace characters from the beginning and end
- * of the provided string. Whitespace is defined as any character for which
- * the isspace() function returns true (i.e., space, tab, newline).
+ * preprocess_string_array_parallel
  *
+ * Multi-threaded variant of 'preprocess_string_array' producing an identical result. The rows are independent, so worker
+ * threads claim blocks of rows from a shared cursor and each stores its results at the rows' own indices, giving the same output
+ * order as the serial version regardless of scheduling. Each worker reuses its own scratch buffer and the tokenizer and
+ * date/time conversion state are per thread('convert_tm_to_unix_time' avoids the process-wide lock taken by 'mktime'), so the
+ * workers share nothing but the input and output arrays.
  *
- * @param untrimmedString A pointer to the string to be trimmed.
- * @return A pointer to the newly allocated trimmed string, or NULL if the input string is NULL or empty.
+ * @param stringArray Pointer to the array of strings to be processed.
+ * @param stringCount Number of strings in the array.
+ * @param delimiter Pointer to the delimiter character used in the strings.
+ * @param numThreads The number of worker threads to use, a value <= 0 uses one thread per online processor.
+ * @return Pointer to the newly created array of processed strings, or NULL if the original string array is NULL.
  */
-char *trim_string_whitespaces(char* untrimmedString)
+char **preprocess_string_array_parallel(char **stringArray, int stringCount, const char *delimiter, int numThreads)
 {
-	// Check for NULL or empty string
-	if (!untrimmedString || !*untrimmedString)
-	{
-		return NULL;
-	}
+	INSTRUMENT_FUNCTION(INSTRUMENT_PREPROCESS_STRING_ARRAY_PARALLEL);
+	// Check for NULL input and handle error.
+	if (stringArray == NULL){ perror("\n\nError: stringArray was NULL in 'preprocess_string_array_parallel'.\n");      return NULL; }
 	
 	
-	// Traversing the string to find the first and last non-whitespace character
-	const char *startPtr, *endPtr;
-	for (startPtr = untrimmedString; *startPtr && char_is_whitespace((unsigned char)*startPtr); startPtr++);
+	char **processedStringArray = (char **)utilities_malloc((stringCount + 1) * sizeof(char *));
+	if (processedStringArray == NULL)
+	{
+		perror("\n\nError: Memory allocation failed in 'preprocess_string_array_parallel'.\n");
+		exit(EXIT_FAILURE);
+	}
 	
 	
+	/// No more threads than there are blocks of rows to claim, a single thread runs on the calling thread.
+	int numClaims = (stringCount + PREPROCESS_ROWS_PER_CLAIM - 1) / PREPROCESS_ROWS_PER_CLAIM;
+	numThreads = resolve_thread_count(numThreads);
+	if (numThreads > numClaims)
+	{
+		numThreads = numClaims > 0 ? numClaims : 1;
+	}
 	
-	// Handle the case where the entire string is whitespace
-	if (!*startPtr)
+	RowSchema *schema = infer_row_schema(stringArray, stringCount, delimiter, ROW_SCHEMA_SAMPLE_ROWS);
+	PreprocessTask task = { stringArray, processedStringArray, stringCount, schema, delimiter, 0 };
+	if (numThreads == 1)
+	{
+		preprocess_string_array_worker(&task);
+	}
+	else
 	{
-		char *emptyStr = (char *)malloc(1);
-		if (emptyStr)
+		pthread_t *threads = (pthread_t *)utilities_malloc(numThreads * sizeof(pthread_t));
+		if (threads == NULL){ perror("\n\nError: Unable to allocate memory in 'preprocess_string_array_parallel'.\n");      exit(1); }
+		
+		for (int t = 0; t < numThreads; t++)
+		{
+			if (pthread_create(&threads[t], NULL, preprocess_string_array_worker, &task) != 0)
+			{
+				perror("\n\nError: Unable to create thread in 'preprocess_string_array_parallel'.\n");
+				exit(1);
+			}
+		}
+		for (int t = 0; t < numThreads; t++)
 		{
-			*emptyStr = '\0';
+			pthread_join(threads[t], NULL);
 		}
-		return emptyStr;
+		utilities_free(threads);
 	}
 	
+	row_schema_destroy(schema);
+	processedStringArray[stringCount] = NULL;
+	return processedStringArray;
+}
+
+
+/**
+ * preprocess_string_array_arena
+ *
+ * Arena-backed 'preprocess_string_array' producing the same strings: the array and every processed row are allocated from an
+ * arena, contiguously and in row order, so a batch of any size is released by a single 'arena_reset' or 'arena_destroy'
+ * and downstream scans over the rows walk memory sequentially.
+ *
+ * @param arena The arena to allocate the result from.
+ * @param stringArray Pointer to the array of strings to be processed.
+ * @param stringCount Number of strings in the array.
+ * @param delimiter Pointer to the delimiter character used in the strings.
+ * @return Pointer to the NULL-terminated array of processed strings, or NULL if the original string array is NULL.
+ */
+char **preprocess_string_array_arena(Arena *arena, char **stringArray, int stringCount, const char *delimiter)
+{
+	// Check for NULL input and handle error.
+	if (stringArray == NULL){ perror("\n\nError: stringArray was NULL in 'preprocess_string_array_arena'.\n");      return NULL; }
 	
 	
-	// Find the last non-whitespace character
-	for (endPtr = untrimmedString + string_length(untrimmedString) - 1; endPtr > startPtr && char_is_whitespace((unsigned char)*endPtr); endPtr--);
-	
-	
-	
-	// Calculate the length of the trimmed string
-	size_t trimmedLength = endPtr - startPtr + 1;
-	
+	char **processedStringArray = (char **)arena_alloc(arena, (stringCount + 1) * sizeof(char *));
+	RowSchema *schema = infer_row_schema(stringArray, stringCount, delimiter, ROW_SCHEMA_SAMPLE_ROWS);
+	char *scratch = NULL;
+	size_t scratchCapacity = 0;
 	
-	// Allocate memory for the new string
-	char *trimmedString = (char *)malloc(trimmedLength + 1); // +1 for the null terminator
-	if (!trimmedString)
+	for (int i = 0; i < stringCount; i++)
 	{
-		return NULL; // Allocation failed
+		const char *row = stringArray[i];
+		if (row == NULL || *row == '\0')
+		{
+			processedStringArray[i] = NULL;
+			continue;
+		}
+		
+		size_t cleanedLength = clean_delimited_string_with_schema(row, string_length(row), delimiter, schema, &scratch, &scratchCapacity);
+		processedStringArray[i] = duplicate_n_string_arena(arena, scratch, cleanedLength);
 	}
 	
-	
-	// Copy the trimmed content
-	copy_n_string(trimmedString, startPtr, trimmedLength);
-	trimmedString[trimmedLength] = '\0'; // Null-terminate the new string
-	return trimmedString;
+	row_schema_destroy(schema);
+	utilities_free(scratch);
+	processedStringArray[stringCount] = NULL;
+	return processedStringArray;
 }
 
 
 
 
 /**
- * prune_string_whitespaces
- *
- * Removes all whitespace characters from a string and returns a new string.
- * This function removes all whitespace characters (as defined by isspace())
- * from the provided string.
+ * stream_sample_is_buffered
  *
- * @param unprunedString A pointer to the string from which whitespaces are to be removed.
- * @return A pointer to the newly allocated pruned string, or NULL if the input string is NULL or empty.
+ * Checks whether the start of a stream holds 'STREAM_DELIMITER_SAMPLE_ROWS' complete rows, so that the sample taken from it
+ * does not depend on the chunk size.
  */
-char *prune_string_whitespaces(char *unprunedString)
+static bool stream_sample_is_buffered(const char *buffer, size_t length)
 {
-	// Check for NULL or empty string
-	if (!unprunedString || !*unprunedString)
-	{
-		return NULL;
-	}
-	
-	// Allocate memory for the new string
-	char *prunedString = (char *)malloc(string_length(unprunedString) + 1);
-	if (!prunedString)
-	{
-		return NULL; // Allocation failed
-	}
-	
-	const char *readPtr = unprunedString;
-	char *writePtr = prunedString;
-	
-	// Iterate over the input string and copy non-whitespace characters
-	while (*readPtr)
+	size_t rowStart = 0;
+	for (int rows = 0; rows < STREAM_DELIMITER_SAMPLE_ROWS; rows++)
 	{
-		if (!char_is_whitespace((unsigned char)*readPtr))
+		const unsigned char *newline = find_byte_n((const unsigned char *)buffer + rowStart, length - rowStart, '\n');
+		if (newline == NULL)
 		{
-			*writePtr++ = *readPtr;
+			return false;
 		}
-		readPtr++;
+		rowStart = (size_t)((const char *)newline - buffer) + 1;
 	}
-	
-	// Null-terminate the new string
-	*writePtr = '\0';
-	
-	
-	// Reallocate prunedString to fit the actual pruned length
-	char *fitString = realloc(prunedString, string_length(prunedString) + 1);
-	if (fitString)
+	return true;
+}
+
+
+/**
+ * collect_stream_sample
+ *
+ * Copies up to 'STREAM_DELIMITER_SAMPLE_ROWS' complete rows from the start of a stream(the final row without a terminator
+ * only at the end of the input), for the detection of the delimiter and the schema.
+ *
+ * @return The number of rows stored in 'sampleRows', each to be freed by the caller.
+ */
+static int collect_stream_sample(const char *buffer, size_t length, bool endOfInput, char *sampleRows[STREAM_DELIMITER_SAMPLE_ROWS])
+{
+	int sampleCount = 0;
+	size_t rowStart = 0;
+	while (sampleCount < STREAM_DELIMITER_SAMPLE_ROWS && rowStart < length)
 	{
-		prunedString = fitString;
+		const unsigned char *newline = find_byte_n((const unsigned char *)buffer + rowStart, length - rowStart, '\n');
+		if (newline == NULL && !endOfInput)
+		{
+			break;
+		}
+		size_t rowEnd = newline ? (size_t)((const char *)newline - buffer) : length;
+		sampleRows[sampleCount++] = duplicate_n_string(buffer + rowStart, rowEnd - rowStart);
+		rowStart = rowEnd + 1;
 	}
-	
-	return prunedString;
+	return sampleCount;
 }
 
 
+/**
+ * detect_stream_delimiter
+ *
+ * Runs 'identify_delimiter' on the sample rows of a stream.
+ *
+ * @return true if a delimiter was identified and stored in 'delimiter'.
+ */
+static bool detect_stream_delimiter(char **sampleRows, int sampleCount, char delimiter[2])
+{
+	char *identified = identify_delimiter(sampleRows, sampleCount);
+	delimiter[0] = identified[0];
+	delimiter[1] = '\0';
+	if (identified[0] != '\0')
+	{
+		utilities_free(identified); // 'identify_delimiter' only allocates when it finds a delimiter
+	}
+	return delimiter[0] != '\0';
+}
 
 
 /**
- * prune_repeated_delimiters_from_string
+ * preprocess_file_stream
  *
- * Inserts a '0' character between consecutive delimiters in a string and returns a new string.
- * This function is particularly useful for processing CSV data. It ensures that empty fields
- * (indicated by consecutive delimiters) are explicitly represented with a '0' value, aiding in
- * correct data alignment during parsing.
+ * Streaming counterpart of 'preprocess_string_array' for inputs too large to hold in memory as a string array. The input is read in
+ * chunks of 'chunkSize' bytes and split into rows at each '\n'. A row that straddles the end of a chunk is carried to the start of the buffer
+ * and completed by the next read. Each row is cleaned with 'clean_delimited_string'(whitespace removal, repeated delimiter handling and
+ * date/time to Unix time conversion) and written, followed by '\n', through a 'BufferedWriter' of 'chunkSize' bytes.
+ * The date/time columns are detected once, by 'infer_row_schema' on the first 'STREAM_DELIMITER_SAMPLE_ROWS' rows, which are all read
+ * before any row is processed so that the output does not depend on the chunk size.
  *
+ * Peak memory is bounded by the chunk size: one input and one output buffer of 'chunkSize' bytes, plus a scratch buffer of twice the
+ * longest row. A single row longer than the chunk, or sample rows that do not fit in the first chunk, grow the input buffer to fit them.
  *
- * @param unprunedString A pointer to the string to be processed.
- * @param delimiter The delimiter character used to identify consecutive occurrences.
- *        If the string is NULL or empty, the function returns NULL.
- * @return A pointer to the newly allocated processed string, or NULL if the input string is NULL or empty.
+ * @param input The stream to read rows from.
+ * @param output The stream to write the processed rows to, one per input row(empty rows are written as empty lines).
+ * @param delimiter The delimiter characters separating fields, or NULL to detect it with 'identify_delimiter' from the first rows.
+ * @param chunkSize The size of the input and output buffers in bytes, 0 selects 'STREAM_DEFAULT_CHUNK_SIZE'.
+ * @return The number of rows written, or -1 if reading or writing failed or no delimiter could be detected.
  */
-char *prune_repeated_delimiters_from_string(char *unprunedString, const char *delimiter)
+long preprocess_file_stream(FILE *input, FILE *output, const char *delimiter, size_t chunkSize)
 {
-	// Check for NULL or empty string
-	if (!unprunedString || !*unprunedString)
-	{
-		return NULL;
-	}
-	
-	
-	/// Allocate Memory for the New Pruned String
-	size_t originalLength = string_length(unprunedString) + 1;
-	size_t newLength = originalLength; // Initial estimate of new length
+	// Check for NULL input and handle error.
+	if (input == NULL || output == NULL){ perror("\n\nError: input and/or output was NULL in 'preprocess_file_stream'.\n");      return -1; }
 	
 	
-	// First pass: count consecutive delimiters to estimate the new length, i.e., the number of additional '0' characters required
-	for (size_t i = 0; i < originalLength; i++)
+	if (chunkSize == 0)
 	{
-		if (unprunedString[i] == *delimiter && unprunedString[i + 1] == *delimiter)
-		{
-			newLength++;
-		}
+		chunkSize = STREAM_DEFAULT_CHUNK_SIZE;
 	}
-	
-	
-	
-	// Allocate memory for the new string
-	char *prunedString = (char *)malloc((newLength) * sizeof(char));
-	const char *readPtr = unprunedString; // Pointer for reading the input string
-	char *writePtr = prunedString; // Pointer for writing to the new string
-	bool previousCharWasDelimiter = false; // Track if the previous character was a delimiter
-	
-	
-	// Iterate over the input string and process delimiters
-	while (*readPtr)
+	size_t inputCapacity = chunkSize;
+	char *inputBuffer = (char *)utilities_malloc(inputCapacity);
+	if (inputBuffer == NULL){ perror("\n\nError: Unable to allocate memory in 'preprocess_file_stream'.\n");      exit(1); }
+	BufferedWriter *writer = writer_create_file(output, chunkSize);
+	
+	char *scratch = NULL;
+	size_t scratchCapacity = 0;
+	size_t buffered = 0; // Bytes in the input buffer, starting with the carried partial row.
+	char detectedDelimiter[2] = { '\0', '\0' };
+	RowSchema *schema = NULL;
+	bool endOfInput = false;
+	bool failed = false;
+	long rowCount = 0;
+	
+	while (!endOfInput && !failed)
 	{
-		if (readPtr == delimiter)
+		/// Refill the input buffer behind the carried partial row, growing it only when a single row fills it entirely.
+		if (buffered == inputCapacity)
+		{
+			char *grown = (char *)utilities_realloc(inputBuffer, inputCapacity * 2);
+			if (grown == NULL){ perror("\n\nError: Unable to allocate memory in 'preprocess_file_stream'.\n");      exit(1); }
+			inputBuffer = grown;
+			inputCapacity *= 2;
+		}
+		
+		size_t requested = inputCapacity - buffered;
+		size_t bytesRead = fread(inputBuffer + buffered, 1, requested, input);
+		buffered += bytesRead;
+		if (bytesRead < requested)
+		{
+			if (ferror(input))
+			{
+				failed = true;
+				break;
+			}
+			endOfInput = true;
+		}
+		
+		
+		/// Detect the delimiter(unless given) and the date/time columns once the first rows of the input are buffered.
+		if (schema == NULL)
 		{
-			if (!previousCharWasDelimiter) //Will occur when
+			if (!endOfInput && !stream_sample_is_buffered(inputBuffer, buffered))
+			{
+				continue; // The buffer is full, the next pass grows it.
+			}
+			char *sampleRows[STREAM_DELIMITER_SAMPLE_ROWS];
+			int sampleCount = collect_stream_sample(inputBuffer, buffered, endOfInput, sampleRows);
+			if (sampleCount == 0)
+			{
+				break; // Empty input, there are no rows to process.
+			}
+			if (delimiter == NULL && detect_stream_delimiter(sampleRows, sampleCount, detectedDelimiter))
+			{
+				delimiter = detectedDelimiter;
+			}
+			if (delimiter != NULL)
+			{
+				schema = infer_row_schema(sampleRows, sampleCount, delimiter, sampleCount);
+			}
+			for (int i = 0; i < sampleCount; i++)
+			{
+				utilities_free(sampleRows[i]);
+			}
+			if (delimiter == NULL)
 			{
-				*writePtr++ = *readPtr; // Copy the first occurrence of the delimiter
+				failed = true;
+				break;
 			}
-			else // if we reach here it means that the delimiter was true on the last iteration and it is also true this iteration
+		}
+		
+		
+		/// Process every complete row, and at the end of the input the final row without a terminator.
+		size_t rowStart = 0;
+		while (rowStart < buffered)
+		{
+			const unsigned char *newline = find_byte_n((const unsigned char *)inputBuffer + rowStart, buffered - rowStart, '\n');
+			if (newline == NULL && !endOfInput)
 			{
-				// Here is where the consecutive delimiters occur
-				// Need to insert '0' between consecutive delimiters, memory was already allocated, so no concerns
-				*writePtr++ = '0';
-				*writePtr++ = *readPtr;
+				break;
 			}
+			size_t rowEnd = newline ? (size_t)((const char *)newline - inputBuffer) : buffered;
 			
+			size_t cleanedLength = clean_delimited_string_with_schema(inputBuffer + rowStart, rowEnd - rowStart, delimiter, schema, &scratch, &scratchCapacity);
+			scratch[cleanedLength++] = '\n'; // Replaces the terminator, the engine always leaves room for it.
+			failed |= !writer_write(writer, scratch, cleanedLength);
 			
-			previousCharWasDelimiter = true;
+			rowCount++;
+			rowStart = rowEnd + 1;
 		}
-		else
+		
+		
+		/// Carry the partial row to the front of the buffer.
+		if (rowStart < buffered)
 		{
-			*writePtr++ = *readPtr; // Copy non-delimiter character
-			previousCharWasDelimiter = false;
+			size_t carried = buffered - rowStart;
+			for (size_t i = 0; i < carried; i++) // Forward copy, the destination never overtakes the source
+			{
+				inputBuffer[i] = inputBuffer[rowStart + i];
+			}
+			buffered = carried;
 		}
-		readPtr++;
-	}
-	
-	
-	// Null-terminate the new string
-	*writePtr = '\0';
-	
+		else
+		{
+			buffered = 0;
+		}
+	}
 	
 	
-	// Reallocate the pruned string to fit the actual length
-	char *fitString = realloc(prunedString, string_length(prunedString) + 1);
-	if (fitString)
-	{
-		prunedString = fitString;
-	}
+	failed |= !writer_destroy(writer);
 	
-	return prunedString;
+	utilities_free(inputBuffer);
+	utilities_free(scratch);
+	row_schema_destroy(schema);
+	return failed ? -1 : rowCount;
 }
 
 
 
 
 /**
- * prune_and_trim_problematic_characters_from_string
+ * classify_field_value
  *
- * Processes a string by trimming whitespace, pruning whitespace, handling repeated delimiters, and replacing date/time fields with Unix time.
- * The function first trims leading and trailing whitespaces, then removes all internal whitespaces,
- * handles repeated delimiters by inserting '0' characters, and finally replaces any date/time fields with their Unix time equivalents.
+ * Determines how a trimmed field can be typed, storing its value when it is a date/time or a number. The field is parsed as a date/time
+ * first, trying the format 'dateTimeFormat' detected for its column(if >= 0) before every other format, and otherwise as a number.
  *
- * @param originalString Pointer to the original string to be processed.
- * @param delimiter Pointer to the delimiter character used in the string.
- * @param fieldCount Number of fields expected in the string.
- * @return Pointer to the newly created string after processing, or NULL in case of an error or if the original string is NULL or empty.
+ * @return COLUMN_TYPE_TIMESTAMP or COLUMN_TYPE_NUMERIC if the whole field parses as one, COLUMN_TYPE_TEXT otherwise.
  */
-char *prune_and_trim_problematic_characters_from_string(char *originalString, const char *delimiter, const int fieldCount)
+static ColumnType classify_field_value(StringView field, int dateTimeFormat, double *number, int64_t *timestamp)
 {
-	// Check for NULL or empty string
-	if (!originalString || !*originalString)
-	{
-		return NULL;
-	}
-	
-	
-	
-	// Step 1: Trim whitespace from the beginning and end of the string.
-	char *trimmedString = trim_string_whitespaces(originalString);
-	if (!trimmedString)
-	{
-		perror("\n\nError: Step 1: Trim whitespace from string failure in 'prune_and_trim_problematic_characters_from_string'.\n");
-		return originalString; // If the whitespace trimming fails then the original string is returned
-	}
-	
-	
-	
-	// Step 2: Prune all internal whitespace characters from the string.
-	char *prunedWhitespaceString = prune_string_whitespaces(trimmedString);
-	if (!prunedWhitespaceString)
-	{
-		perror("\n\nError: Step 2: Prune whitespace from string failure in 'prune_and_trim_problematic_characters_from_string'.\n");
-		return trimmedString; // If the whitespace pruning fails then the last successful string format is returned
-	}
-	else
-	{
-		free(trimmedString); // Free the memory allocated by trim_string_whitespaces and proceed to the next step
-	}
-	
-	
-	
-	// Step 3: Process repeated delimiters by inserting '0' characters.
-	char *prunedDelimiterString = prune_repeated_delimiters_from_string(prunedWhitespaceString, delimiter);
-	if (!prunedDelimiterString)
+	char c = field.characters[0];
+	if (!char_is_digit(c) && c != '-' && c != '+' && c != '.')
 	{
-		perror("\n\nError: Step 3: Prune repeated delimiters from string failure in 'prune_and_trim_problematic_characters_from_string'.\n");
-		return prunedWhitespaceString; // If the delimiter replacement fails then the last successful string format is returned
+		return COLUMN_TYPE_TEXT;
 	}
-	else
-	{
-		free(prunedWhitespaceString); // Proceed only if step 3 was successful and the previous string was replaced
-	}
-	
 	
+	char fieldBuffer[DATE_TIME_FIELD_BUFFER_SIZE];
+	char *heapCopy;
+	const char *terminated = terminate_field(field, fieldBuffer, sizeof(fieldBuffer), &heapCopy);
+	ColumnType type = COLUMN_TYPE_TEXT;
 	
-	// Step 4: Detect Date/Time Fields in string and Replace them with Unix Time
-	char *unixTimeString = replace_date_time_with_unix(prunedDelimiterString, delimiter, fieldCount);
-	if (!unixTimeString)
+	time_t unixTime;
+	char *end;
+	if ((dateTimeFormat >= 0 && parse_date_time_field(terminated, field.length, dateTimeFormat, &unixTime) >= 0) ||
+		parse_date_time_field(terminated, field.length, -1, &unixTime) >= 0)
 	{
-		//perror("\n\nError: Step 4: Replace date/time fields with Unix time failure in 'prune_and_trim_problematic_characters_from_string'.\n");
-		return prunedDelimiterString; // If the date/time replacement fails then the last successful string format is returned
+		*timestamp = (int64_t)unixTime;
+		type = COLUMN_TYPE_TIMESTAMP;
 	}
 	else
 	{
-		free(prunedDelimiterString); // Only proceed if step 4 was successful and the previous string was replaced
+		*number = strtod(terminated, &end);
+		if (*end == '\0')
+		{
+			type = COLUMN_TYPE_NUMERIC;
+		}
 	}
 	
-	
-	
-	return unixTimeString; // Return the final processed string if all 4 steps were successful
+	utilities_free(heapCopy);
+	return type;
 }
 
 
-
-
-
-
-
-
 /**
- * replace_date_time_with_unix
- *
- * This function performs the task of replacing date/time fields in a given string with their Unix time
- * representations. It identifies date/time fields based on predefined formats and performs the
- * conversion when a field is a date/time string.
+ * preprocess_string_array_columns
  *
- * The function begins by calling the string_is_date_time function to get an array indicating which fields are date/time fields.
- * It then counts the number of fields that are identified as date/time fields.
- * The function then estimates the size of the output string based on the number of date/time fields and the length of the input string.
- * It allocates memory for the output string based on the estimated size.
- * The function then duplicates the input string to avoid modifying it directly, as strtok modifies the string it processes.
- * It then initializes the output string to an empty string and tokenizes the copied string using the delimiter character.
- * The function then iterates over each token(field) in the string, checking if the current field is a date/time field.
- * If it is, it converts the date/time field to Unix time, prepares a string to hold the Unix time, and appends the Unix time string to the output.
- * If the field is not a date/time field, it appends it directly to the output.
- * The function then appends the delimiter for the next field and increments the index.
- * After iterating over all the fields, the function frees the memory allocated for the copy of the input string and the dateTimeIndicators array.
- * It then null-terminates the new string and reallocates the output to fit the actual length.
- * Finally, it returns the dynamically allocated output string.
+ * Typed, column-major alternative to 'preprocess_string_array': rather than rewriting each row as text, the fields are parsed once
+ * and stored per column, as a 'double' array for numeric columns(ready for 'radix_sort_doubles', 'min_element' and 'max_element'),
+ * an 'int64_t' array of Unix times for date/time columns, and offsets into one byte buffer for text columns, each with a validity
+ * bitmap marking the rows that have a value. Downstream code therefore never parses or formats the values again.
  *
+ * Rows are split on the delimiter with empty fields kept, and every field is trimmed of surrounding whitespace. An empty or missing
+ * field is a null(its validity bit is clear, numeric nulls are also NaN). The first pass over the rows determines the number of columns
+ * and the type of each: a date/time column has only date/times, a numeric column only numbers, and the rest are text. The formats detected
+ * from the leading rows by 'infer_row_schema' are only a hint, tried first on each value of their column. The second pass fills the columns.
  *
- * @param characterString Pointer to the string to be interpreted.
- * @param delimiter The delimiter character used to identify consecutive occurrences.
- * @param fieldCount The number of fields found in the string.
- * @return A pointer to the newly allocated string with the date/time fields replaced with Unix time representations.
+ * @param stringArray Pointer to the array of rows to be processed, NULL rows are rows of nulls.
+ * @param stringCount Number of rows in the array.
+ * @param delimiter Pointer to the delimiter characters used in the rows.
+ * @return The column table, to be released with 'column_table_destroy', or NULL if the array or delimiter is NULL.
  */
-char* replace_date_time_with_unix(char* characterString, const char *delimiter, const int fieldCount)
+ColumnTable *preprocess_string_array_columns(char **stringArray, int stringCount, const char *delimiter)
 {
-	// Call the string_is_date_time function to get an array indicating which fields are date/time fields.
-	int *dateTimeIndicators = string_is_date_time(characterString, delimiter, fieldCount);
-	
-	// Count the number of fields that are identified as date/time fields.
-	int dateTimeCount = 0;
-	for(int i = 0; i < fieldCount; i++)
-	{
-		if(dateTimeIndicators[i] == 1)
-		{
-			dateTimeCount++;
-		}
-	}
-	
-	if(dateTimeCount == 0)
-	{
-		//perror("\n\nError: No date/time fields found in the string in 'replace_date_time_with_unix'.");
-		return NULL;
-	}
-	
-	
-	// The max Unix timestamp is theoretically up to 9,223,372,036,854,775,807, far in the future and has 19 digits, so max length would be 20 characters(19 plus null terminator)
-	size_t estimatedOutputSize = string_length(characterString) + dateTimeCount * 20;
-	
-	
-	
-	// Allocate memory for the output string based on the estimated size.
-	char *output = (char *)malloc(estimatedOutputSize);
-	
-	// Duplicate the input string to avoid modifying it directly, as strtok modifies the string it processes.
-	char* copyOfString = duplicate_string(characterString);
+	// Check for NULL input and handle error.
+	if (stringArray == NULL || delimiter == NULL){ perror("\n\nError: stringArray and/or delimiter was NULL in 'preprocess_string_array_columns'.\n");      return NULL; }
 	
 	
+	int fieldCapacity = 16;
+	StringField *fields = (StringField *)utilities_malloc(fieldCapacity * sizeof(StringField));
+	bool *columnHasValue = NULL, *columnIsNumeric = NULL, *columnIsTimestamp = NULL;
+	int columnCount = 0;
+	if (fields == NULL){ perror("\n\nError: Unable to allocate memory in 'preprocess_string_array_columns'.\n");      exit(1); }
 	
+	RowSchema *schema = infer_row_schema(stringArray, stringCount, delimiter, ROW_SCHEMA_SAMPLE_ROWS);
 	
-	output[0] = '\0'; // Initialize the output string to an empty string
-	char* token = tokenize_string(copyOfString, delimiter);  // Tokenize the copied string using the delimiter character.
-	int index = 0; // Initialize an index to track the current field
 	
-	// Iterate over each token(field) in the string.
-	while (token != NULL)
+	/// Pass 1: Determine the number of columns and the type of each.
+	for (int i = 0; i < stringCount; i++)
 	{
-		// Check if the current field is a date/time field.
-		if (dateTimeIndicators[index] == 1)
+		if (stringArray[i] == NULL)
 		{
-			// Convert the date/time field to Unix time.
-			time_t unixTime = convert_to_unix_time(token);
-			
-			// Prepare a string to hold the Unix time.
-			char unixTimeString[20];
-			snprintf(unixTimeString, sizeof(unixTimeString), "%ld", unixTime);
-			
-			// Append the Unix time string to the output.
-			concatenate_n_string(output, unixTimeString, estimatedOutputSize - string_length(output) - 1);
+			continue;
 		}
-		else
+		
+		int fieldCount = split_row_fields(stringArray[i], delimiter, &fields, &fieldCapacity);
+		if (fieldCount > columnCount)
 		{
-			// If the field is not a date/time field, append it directly to the output.
-			concatenate_n_string(output, token, string_length(token) + 1);
+			columnHasValue = (bool *)utilities_realloc(columnHasValue, fieldCount * sizeof(bool));
+			columnIsNumeric = (bool *)utilities_realloc(columnIsNumeric, fieldCount * sizeof(bool));
+			columnIsTimestamp = (bool *)utilities_realloc(columnIsTimestamp, fieldCount * sizeof(bool));
+			if (columnHasValue == NULL || columnIsNumeric == NULL || columnIsTimestamp == NULL){ perror("\n\nError: Unable to allocate memory in 'preprocess_string_array_columns'.\n");      exit(1); }
+			for (int j = columnCount; j < fieldCount; j++)
+			{
+				columnHasValue[j] = false;
+				columnIsNumeric[j] = true;
+				columnIsTimestamp[j] = true;
+			}
+			columnCount = fieldCount;
 		}
 		
-		
-		// Append delimiter for next field.
-		token = tokenize_string(NULL, delimiter);
-		if (token != NULL && string_length(token) > 0 && index < fieldCount - 1)
+		for (int j = 0; j < fieldCount; j++)
 		{
-			concatenate_string(output, delimiter);
+			StringView value = trim_string_view(stringArray[i] + fields[j].offset, fields[j].length);
+			columnHasValue[j] |= (value.length > 0);
+			if (value.length == 0 || (!columnIsNumeric[j] && !columnIsTimestamp[j]))
+			{
+				continue;
+			}
+			
+			double number;
+			int64_t timestamp;
+			int dateTimeFormat = (j < schema->dateFieldCount) ? schema->dateTimeFormats[j] : -1;
+			ColumnType type = classify_field_value(value, dateTimeFormat, &number, &timestamp);
+			columnIsNumeric[j] &= (type == COLUMN_TYPE_NUMERIC);
+			columnIsTimestamp[j] &= (type == COLUMN_TYPE_TIMESTAMP);
 		}
-		
-		// Increment the index
-		index++;
 	}
 	
-	// Free the memory allocated for the copy of the input string and the dateTimeIndicators array.
-	free(copyOfString);
-	free(dateTimeIndicators);
-	
 	
+	/// Allocate the columns.
+	ColumnTable *table = (ColumnTable *)utilities_malloc(sizeof(ColumnTable));
+	if (table == NULL){ perror("\n\nError: Unable to allocate memory in 'preprocess_string_array_columns'.\n");      exit(1); }
+	table->columnCount = columnCount;
+	table->rowCount = (size_t)(stringCount > 0 ? stringCount : 0);
+	table->columns = (Column *)utilities_calloc(columnCount > 0 ? columnCount : 1, sizeof(Column));
+	size_t *textCapacities = (size_t *)utilities_calloc(columnCount > 0 ? columnCount : 1, sizeof(size_t));
+	if (table->columns == NULL || textCapacities == NULL){ perror("\n\nError: Unable to allocate memory in 'preprocess_string_array_columns'.\n");      exit(1); }
 	
-	concatenate_string(output, "\0"); // Null-terminate the new string
-	
+	size_t rowCount = table->rowCount;
+	for (int j = 0; j < columnCount; j++)
+	{
+		Column *column = &table->columns[j];
+		column->type = !columnHasValue[j] ? COLUMN_TYPE_TEXT : columnIsTimestamp[j] ? COLUMN_TYPE_TIMESTAMP : columnIsNumeric[j] ? COLUMN_TYPE_NUMERIC : COLUMN_TYPE_TEXT;
+		column->validity = (uint64_t *)utilities_calloc((rowCount + 63) / 64 + 1, sizeof(uint64_t));
+		bool allocated = (column->validity != NULL);
+		
+		if (column->type == COLUMN_TYPE_NUMERIC)
+		{
+			column->numbers = (double *)utilities_malloc((rowCount + 1) * sizeof(double));
+			allocated &= (column->numbers != NULL);
+		}
+		else if (column->type == COLUMN_TYPE_TIMESTAMP)
+		{
+			column->timestamps = (int64_t *)utilities_calloc(rowCount + 1, sizeof(int64_t));
+			allocated &= (column->timestamps != NULL);
+		}
+		else
+		{
+			column->textOffsets = (size_t *)utilities_calloc(rowCount + 1, sizeof(size_t));
+			allocated &= (column->textOffsets != NULL);
+		}
+		if (!allocated){ perror("\n\nError: Unable to allocate memory in 'preprocess_string_array_columns'.\n");      exit(1); }
+	}
 	
 	
-	// Reallocate output to fit actual length.
-	// Included here because the estimated size has to be able to account for the maximum possible size of the
-	// outputted string, and since the outputted string usually changes minimnally in length from the inputtted string, it means that the estimate
-	// often greatly exceeds the actual needed size, hence it's good practice to reallocate here.
-	char *fitoutput = realloc(output, string_length(output) + 1);
-	if (fitoutput)
+	/// Pass 2: Fill the columns.
+	for (size_t i = 0; i < rowCount; i++)
 	{
-		output = fitoutput;
+		int fieldCount = (stringArray[i] != NULL) ? split_row_fields(stringArray[i], delimiter, &fields, &fieldCapacity) : 0;
+		for (int j = 0; j < columnCount; j++)
+		{
+			Column *column = &table->columns[j];
+			StringView value = { "", 0 };
+			if (j < fieldCount)
+			{
+				value = trim_string_view(stringArray[i] + fields[j].offset, fields[j].length);
+			}
+			bool valid = (value.length > 0);
+			
+			if (column->type == COLUMN_TYPE_TEXT)
+			{
+				size_t textLength = column->textOffsets[i];
+				ensure_output_capacity(&column->textBytes, &textCapacities[j], textLength + value.length + 1);
+				copy_memory_block(column->textBytes + textLength, value.characters, value.length);
+				column->textOffsets[i + 1] = textLength + value.length;
+			}
+			else if (valid)
+			{
+				double number = NAN;
+				int64_t timestamp = 0;
+				int dateTimeFormat = (j < schema->dateFieldCount) ? schema->dateTimeFormats[j] : -1;
+				valid = (classify_field_value(value, dateTimeFormat, &number, &timestamp) == column->type);
+				if (column->type == COLUMN_TYPE_NUMERIC)
+				{
+					column->numbers[i] = number;
+				}
+				else
+				{
+					column->timestamps[i] = timestamp;
+				}
+			}
+			else if (column->type == COLUMN_TYPE_NUMERIC)
+			{
+				column->numbers[i] = NAN;
+			}
+			
+			if (valid)
+			{
+				column->validity[i >> 6] |= 1ULL << (i & 63);
+			}
+		}
 	}
 	
 	
-	// Return the dynamically allocated output string.
-	return output;
+	utilities_free(fields);
+	utilities_free(columnHasValue);
+	utilities_free(columnIsNumeric);
+	utilities_free(columnIsTimestamp);
+	utilities_free(textCapacities);
+	row_schema_destroy(schema);
+	return table;
 }
 
 
-
-
 /**
- * preprocess_string_array
+ * column_table_destroy
  *
- * Processes an array of strings by trimming whitespace, pruning whitespace, handling repeated delimiters, and replacing date/time fields with Unix time.
- * The function first trims leading and trailing whitespaces, then removes all internal whitespaces,
- * handles repeated delimiters by inserting '0' characters, and finally replaces any date/time fields with their Unix time equivalents.
+ * Frees a column table and all of its columns.
  *
- * @param stringArray Pointer to the array of strings to be processed.
- * @param stringCount Number of strings in the array.
- * @param delimiter Pointer to the delimiter character used in the strings.
- * @return Pointer to the newly created array of processed strings, or NULL in case of an error or if the original string array is NULL.
+ * @param table The table to destroy, may be NULL.
  */
-char **preprocess_string_array(char **stringArray, int stringCount, const char *delimiter)
+void column_table_destroy(ColumnTable *table)
 {
-	// Check for NULL input and handle error.
-	if (stringArray == NULL){ perror("\n\nError: stringArray was NULL in 'preprocess_string_array'.\n");      return 0; }
-	
-	
-	// Allocate memory for the new array
-	char **processedStringArray = (char **)malloc((stringCount + 1) * sizeof(char *));
-	if (processedStringArray == NULL)
+	if (table == NULL)
 	{
-		perror("\n\nError: Memory allocation failed in 'preprocess_string_array'.\n");
-		exit(EXIT_FAILURE);
+		return;
 	}
 	
-	
-	// Process each string in the array
-	for (int i = 0; i < stringCount; i++)
+	for (int j = 0; j < table->columnCount; j++)
 	{
-		processedStringArray[i] = prune_and_trim_problematic_characters_from_string(stringArray[i], delimiter, stringCount);
+		utilities_free(table->columns[j].numbers);
+		utilities_free(table->columns[j].timestamps);
+		utilities_free(table->columns[j].textOffsets);
+		utilities_free(table->columns[j].textBytes);
+		utilities_free(table->columns[j].validity);
 	}
-	
-	// Null-terminate the array
-	processedStringArray[stringCount] = NULL;
-	return processedStringArray;
+	utilities_free(table->columns);
+	utilities_free(table);
 }
 
 
@@ -1923,8 +4940,11 @@ void print_string_array(char** stringArray, int stringCount, char*label)
 	// Check for NULL input and handle error.
 	if(stringArray == NULL){ perror("\n\nError printing array of strings in 'print_string_array'.");      exit(1); }
 	printf("\n\n%s: \n", label);
-	for(int i = 0; i < stringCount; i++)
-	{ printf("\n%s", stringArray[i]); } printf("\n\n");
+	BufferedWriter *writer = writer_create_file(stdout, 0);
+	writer_write_string(writer, "\n");
+	print_string_array_to_writer(writer, stringArray, stringCount, "\n");
+	writer_write_string(writer, "\n\n");
+	writer_destroy(writer);
 }
 
 
@@ -1934,8 +4954,7 @@ void print_string_array(char** stringArray, int stringCount, char*label)
  * This function prints the contents of an array of arrays of strings. It is assumed that all sub-arrays have the same dimension.
  * The output is formatted with a label and each string is printed on a new line.
  * The function first checks for NULL input to prevent errors. It then prints a label for the array.
- * It then iterates over the main array and for each sub-array, it calculates the length of the label, allocates memory for it,
- * and then prints the sub-array using the 'print_string_array' function.
+ * It then iterates over the main array and prints each sub-array using the 'print_string_array' function.
  *
  * @param stringArrayArray The 2D array of strings to be printed.
  * @param stringArraysCount The number of sub-arrays in the main array.
@@ -1951,10 +4970,6 @@ void print_string_array_array(char*** stringArrayArray, int stringArraysCount, i
 	// Iterate over the main array.
 	for (int i = 0; i < stringArraysCount; i++)
 	{
-		// For each sub-array, calculate the length of the label and allocate memory for it.
-		int subArrayLabelCharacterCount = string_length(label);
-		char* subArrayLabel = (char*)malloc((string_length(label) + 1) * sizeof(char));// = allocate_memory_char_ptr(strlen(label) + 1);
-
 		// Print each sub-array.
 		print_string_array(stringArrayArray[i], stringSubArraysCount, "stringArrayArray[i]");
 	}
@@ -1964,7 +4979,7 @@ void print_string_array_array(char*** stringArrayArray, int stringArraysCount, i
 
 /**
  * print_array
- * Prints the elements of a double array with a label.
+ * Prints the elements of a double array with a label, each with the shortest digits that read back as the same value.
  *
  * @param n Number of elements in the array.
  * @param data Array of doubles to be printed.
@@ -1975,9 +4990,11 @@ void print_array(int n, double *data, char*label)
 	// Check for NULL input and handle error.
 	if (data == NULL){ perror("\n\nError: data was NULL in 'print_array'.\n");      exit(1); }
 	printf("\n\n\n\n\n\n\n\n%s: \n", label);
-	// Loop through the characters print
-	for(int i = 0; i < n; i++)
-	{ printf("%.17g ", data[i]); } printf("\n\n\n");
+	// Write the elements through one buffered writer rather than a 'printf' per element
+	BufferedWriter *writer = writer_create_file(stdout, 0);
+	print_array_to_writer(writer, data, n, " ", -1);
+	writer_write_string(writer, n > 0 ? " \n\n\n" : "\n\n\n");
+	writer_destroy(writer);
 }
 
 
@@ -1985,7 +5002,7 @@ void print_array(int n, double *data, char*label)
  * print_array_array
  *
  * This function prints the contents of a 2D array with each element
- * displayed to 17 decimal places. The output is formatted with a label and
+ * displayed with the shortest digits that read back as the same value. The output is formatted with a label and
  * surrounded by a visual border for clarity.
  *
  * @param data A pointer to a pointer of doubles representing a 2D array.
@@ -2001,15 +5018,13 @@ void print_array_array(double **data, int rows, int columns, char*label)
 	printf("\n\n\n\n\n\n\nprint_array_array %s =========================================================================================", label);
 	printf("\n\n%s: \n", label);
 	
+	BufferedWriter *writer = writer_create_file(stdout, 0);
 	for (int i = 0; i < rows; i++)
 	{
-		
-		for (int j = 0; j < columns; j++)
-		{
-			printf("%.17g ", data[i][j]);
-		}
-		printf("\n"); // Newline after each row
+		print_array_to_writer(writer, data[i], columns, " ", -1);
+		writer_write_string(writer, columns > 0 ? " \n" : "\n"); // Newline after each row
 	}
+	writer_destroy(writer);
 	printf("\n\n=========================================================================================\n\n");
 }
 
@@ -2028,12 +5043,120 @@ void print_char_ptr_array(const char *charPtrArr[],  int stringCount, char* labe
 	
 	
 	printf("\n\n%s: \n", label);
-	// Loop through the elements array and print
+	BufferedWriter *writer = writer_create_file(stdout, 0);
+	print_char_ptr_array_to_writer(writer, charPtrArr, stringCount, "");
+	writer_write_string(writer, "\n\n\n");
+	writer_destroy(writer);
+}
+
+
+
+/**
+ * print_string_array_to_writer
+ *
+ * Writes the strings of an array to a buffered writer, separated by 'separator'. NULL strings are written as "(null)" like 'printf' does.
+ *
+ * @param writer The writer to write to.
+ * @param stringArray Array of strings to be written.
+ * @param stringCount Number of strings in the array.
+ * @param separator Written between consecutive strings.
+ * @return false if writing failed.
+ */
+bool print_string_array_to_writer(BufferedWriter *writer, char **stringArray, int stringCount, const char *separator)
+{
+	// Check for NULL input and handle error.
+	if (writer == NULL || stringArray == NULL || separator == NULL){ perror("\n\nError: NULL argument in 'print_string_array_to_writer'.\n");      return false; }
+	
+	
+	bool succeeded = true;
+	size_t separatorLength = string_length(separator);
 	for (int i = 0; i < stringCount; i++)
 	{
-		printf("%s", charPtrArr[i]);
+		if (i > 0)
+		{
+			writer_write(writer, separator, separatorLength);
+		}
+		succeeded = writer_write_string(writer, stringArray[i] != NULL ? stringArray[i] : "(null)");
+	}
+	return succeeded; // Writer failures are sticky, so the last result covers every earlier write.
+}
+
+
+/**
+ * print_char_ptr_array_to_writer
+ *
+ * Writes the strings of an array of constant strings to a buffered writer, separated by 'separator'.
+ *
+ * @param writer The writer to write to.
+ * @param charPtrArr Array of strings to be written.
+ * @param stringCount Number of strings in the array.
+ * @param separator Written between consecutive strings.
+ * @return false if writing failed.
+ */
+bool print_char_ptr_array_to_writer(BufferedWriter *writer, const char *charPtrArr[], int stringCount, const char *separator)
+{
+	return print_string_array_to_writer(writer, (char **)charPtrArr, stringCount, separator);
+}
+
+
+/**
+ * print_array_to_writer
+ *
+ * Writes the elements of a double array to a buffered writer, separated by 'separator', each formatted directly into the writer's buffer.
+ *
+ * @param writer The writer to write to.
+ * @param data Array of doubles to be written.
+ * @param n Number of elements in the array.
+ * @param separator Written between consecutive elements.
+ * @param precision The number of significant digits(at most 17), a value < 0 writes the shortest digits that read back as the same value.
+ * @return false if writing failed.
+ */
+bool print_array_to_writer(BufferedWriter *writer, const double *data, int n, const char *separator, int precision)
+{
+	// Check for NULL input and handle error.
+	if (writer == NULL || data == NULL || separator == NULL){ perror("\n\nError: NULL argument in 'print_array_to_writer'.\n");      return false; }
+	
+	
+	bool succeeded = true;
+	size_t separatorLength = string_length(separator);
+	for (int i = 0; i < n; i++)
+	{
+		if (i > 0)
+		{
+			writer_write(writer, separator, separatorLength);
+		}
+		succeeded = writer_write_double(writer, data[i], precision);
+	}
+	return succeeded;
+}
+
+
+/**
+ * print_array_array_to_writer
+ *
+ * Writes a 2D array of doubles to a buffered writer, one row per line with the elements of a row separated by 'separator'.
+ *
+ * @param writer The writer to write to.
+ * @param data A pointer to a pointer of doubles representing a 2D array.
+ * @param rows The number of rows in the 2D array.
+ * @param columns The number of columns in each row.
+ * @param separator Written between consecutive elements of a row.
+ * @param precision The number of significant digits, a value < 0 writes the shortest round-trip digits.
+ * @return false if writing failed.
+ */
+bool print_array_array_to_writer(BufferedWriter *writer, double **data, int rows, int columns, const char *separator, int precision)
+{
+	// Check for NULL input and handle error.
+	if (writer == NULL || data == NULL || separator == NULL){ perror("\n\nError: NULL argument in 'print_array_array_to_writer'.\n");      return false; }
+	
+	
+	bool succeeded = true;
+	for (int i = 0; i < rows; i++)
+	{
+		print_array_to_writer(writer, data[i], columns, separator, precision);
+		succeeded = writer_write(writer, "\n", 1);
 	}
-	printf("\n\n\n");
+	return succeeded;
 }
 
 
@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <limits.h>
 #include "AuxiliaryUtilities.h"
 
 
@@ -31,6 +32,8 @@ bool char_is_punctuation(char c); // Checks if a character is punctuation.
 bool char_is_underscore(char c); // Checks if a character is an underscore.
 bool char_is_sign(char c); // Checks if a character is a sign (+, -, etc.).
 bool char_is_delimiter(char c); // Checks if a character is a delimiter (non-alphanumeric and non-space)
+char char_to_lower_case(char c); // Converts an ASCII upper-case letter to lower case.
+char char_to_upper_case(char c); // Converts an ASCII lower-case letter to upper case.
 /// \}
 
 
@@ -44,6 +47,21 @@ bool string_is_numeric(const char *characterString); // Checks if a string repre
 bool string_is_hyphen_else_is_minus_sign(char *characterString); // Differentiates between hyphens and minus signs.
 int *string_is_date_time(const char *characterString, const char *delimiter, const int fieldCount); // Analyzes a string for date/time formats.
 bool string_array_contains_date_time(char **stringArray, int stringCount, const char *delimiter);
+
+/**
+ * 'RowSchema' struct: the layout of the rows of a delimited data set, detected once from a sample by 'infer_row_schema' so
+ * the rows can be processed without examining each for date/times again.
+ */
+typedef struct RowSchema
+{
+	int fieldCount; // The largest number of fields in a sampled row.
+	int dateFieldCount; // One past the last date/time field, the fields from here on are never date/times.
+	int *dateTimeFormats; // Per field, the index into 'commonDateTimeFormats' of its date/time format, or -1 if it is not a date/time.
+} RowSchema;
+
+#define ROW_SCHEMA_SAMPLE_ROWS 64 // Default number of leading rows examined by 'infer_row_schema'.
+RowSchema *infer_row_schema(char **stringArray, int stringCount, const char *delimiter, int sampleCount); // Detects the field count and the date/time columns(and their formats) once from a sample of rows.
+void row_schema_destroy(RowSchema *schema); // Frees a schema created by 'infer_row_schema'.
 /// \}
 
 
@@ -68,9 +86,43 @@ const char *determine_string_representation_type(const char* token); // Determin
 
 
 
+
+// ------------- Helper Functions for Searching Strings -------------
+/// \{
+/**
+ * 'PatternMatch' struct: a single match reported by 'multi_pattern_matcher_find_all', the byte offset at which
+ * the match starts in the searched text and the index of the matched pattern in the array the matcher was compiled from.
+ */
+typedef struct PatternMatch
+{
+	size_t offset;
+	int patternIndex;
+} PatternMatch;
+
+typedef struct MultiPatternMatcher MultiPatternMatcher; // Opaque, compiled multi-pattern(Aho-Corasick) matcher.
+
+
+char *find_substring(const char *characterString, const char *substring); // Finds the first occurrence of a substring in a string.
+char *find_substring_n(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength); // Finds the first occurrence of a needle in an explicit-length haystack using a SIMD prefilter with a Two-Way fallback.
+char *find_substring_nocase(const char *characterString, const char *substring); // Finds the first case-insensitive occurrence of a substring in a string.
+char *find_substring_nocase_n(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength); // Finds the first case-insensitive occurrence of a needle in an explicit-length haystack, folding case on the fly.
+
+MultiPatternMatcher *multi_pattern_matcher_create(const char **patterns, int patternCount); // Compiles a set of patterns into a multi-pattern matcher once for reuse across many strings.
+int multi_pattern_matcher_find_all(const MultiPatternMatcher *matcher, const char *text, size_t textLength, PatternMatch *matches, int maxMatches); // Finds the offsets of all occurrences of all patterns in a string.
+void multi_pattern_matcher_destroy(MultiPatternMatcher *matcher); // Releases a compiled multi-pattern matcher.
+/// \}
+
+
+
+
+
+
 // ------------- Helper Functions for Copying, Duplicating, and Concatenating Strings -------------
 /// \{
 char *duplicate_string(const char *characterString); // Duplicates a character string.
+char *duplicate_n_string(const char *characterString, size_t n); // Duplicates up to n characters of a character string into a new NULL-terminated string.
+char *duplicate_string_arena(Arena *arena, const char *characterString); // Duplicates a character string into an arena.
+char *duplicate_n_string_arena(Arena *arena, const char *characterString, size_t n); // Duplicates up to n characters of a character string into an arena.
 char *copy_string(char *destination, const char *source); // Copies a character string.
 char *copy_n_string(char *destination, const char *source, size_t n); // Copies up to n characters from the string pointed to by 'source' and to 'destination', where any n greater than the length of 'source' is padded with null characters.
 char *concatenate_string(char *destination, const char *source); // Concatenates two character strings.
@@ -86,6 +138,21 @@ char *concatenate_n_string(char *destination, const char *source, size_t n); //
 /// \{
 char *determine_most_common_string(char **stringArray, int stringCount); // Determines the most common string in an array of strings.
 int compare_strings(const char *characterString1, const char *characterString2); // Compares two character strings for equality.
+int compare_strings_nocase(const char *characterString1, const char *characterString2); // Compares two character strings without regard to ASCII case.
+int compare_strings_nocase_n(const char *characterString1, size_t length1, const char *characterString2, size_t length2); // Compares two explicit-length strings without regard to ASCII case, 16 bytes at a time.
+/// \}
+
+
+
+
+
+
+// ------------- Helper Functions for Converting the Case of Strings -------------
+/// \{
+char *convert_to_lower_case(char *destination, const char *source, size_t length); // Copies a buffer converting ASCII letters to lower case, destination may equal source.
+char *convert_to_upper_case(char *destination, const char *source, size_t length); // Copies a buffer converting ASCII letters to upper case, destination may equal source.
+char *convert_string_to_lower_case(char *characterString); // Converts a string to ASCII lower case in place.
+char *convert_string_to_upper_case(char *characterString); // Converts a string to ASCII upper case in place.
 /// \}
 
 
@@ -108,8 +175,84 @@ char *concatenate_string_array(const char** stringArray, int stringCount, const
 
 // ------------- Helper Functions for Tokenizing/Splitting strings in c -------------
 /// \{
-char *tokenize_string(char *s, const char *delim); // Tokenizes a character string based on a delimiter.
+#define CHARACTER_SET_SIMD_MEMBERS 8 // Character sets with at most this many members are scanned with SIMD compares.
+
+/**
+ * 'CharacterSet' struct: a set of byte values(e.g., delimiters) stored as a 256-bit membership bitmap, plus the list of
+ * members when there are few enough of them to be scanned for with SIMD compares.
+ */
+typedef struct CharacterSet
+{
+	uint64_t bits[4]; // Bit (c & 63) of bits[c >> 6] is set when byte c is a member.
+	unsigned char members[CHARACTER_SET_SIMD_MEMBERS]; // The members, valid when 'memberCount' <= CHARACTER_SET_SIMD_MEMBERS.
+	int memberCount; // The number of distinct members.
+} CharacterSet;
+
+/**
+ * 'StringView' struct: a non-owning reference to a run of characters, a pointer and a length, that is not necessarily NULL-terminated.
+ */
+typedef struct StringView
+{
+	const char *characters;
+	size_t length;
+} StringView;
+
+/**
+ * 'StringTokenizer' struct: the complete state of a reentrant tokenization, a cursor into the string, its end, and the precomputed delimiter set.
+ */
+typedef struct StringTokenizer
+{
+	const char *cursor; // The next unread character.
+	const char *end; // One past the last character of the string.
+	CharacterSet delimiters;
+	bool skipEmptyTokens; // Collapse runs of delimiters('strtok' behavior) instead of producing empty tokens.
+	bool finished;
+} StringTokenizer;
+
+
+static inline bool character_set_contains(const CharacterSet *set, char c) // Checks if a character is a member of a character set.
+{
+	unsigned char u = (unsigned char)c;
+	return (set->bits[u >> 6] >> (u & 63)) & 1;
+}
+
+void character_set_init(CharacterSet *set, const char *characters); // Builds a character set from the characters of a string.
+size_t find_first_character_in_set(const char *characters, size_t length, const CharacterSet *set); // Returns the offset of the first member of a character set in a buffer(SIMD for small sets), or 'length'.
+void string_tokenizer_init(StringTokenizer *tokenizer, const char *characterString, size_t length, const char *delimiters, bool skipEmptyTokens); // Initializes a reentrant tokenizer that never modifies its input.
+bool string_tokenizer_next(StringTokenizer *tokenizer, StringView *token); // Returns the next token as a pointer and length into the original string.
+char *tokenize_string(char *s, const char *delim); // Tokenizes a character string based on a delimiter('strtok' style shim over 'StringTokenizer', state is per thread).
 char **split_tokenized_string(const char* characterString, const char* delimiter, int divisions); // Splits a tokenized string into an array of strings based on a given delimiter, i.e., assigns each tokenized field to an element in an array.
+char **split_tokenized_string_arena(Arena *arena, const char *characterString, const char *delimiter, int divisions); // Arena-backed 'split_tokenized_string', released with the arena.
+
+/**
+ * 'StringField' struct: the position of one field within a split string, as a byte offset and length.
+ */
+#define STRING_FIELD_QUOTED 0x1u // The field was enclosed in double quotes, which are excluded from its offset and length.
+#define STRING_FIELD_ESCAPED_QUOTES 0x2u // The field contains doubled quotes, see 'csv_unescape_field'.
+
+typedef struct StringField
+{
+	size_t offset;
+	size_t length;
+	unsigned int flags; // 'STRING_FIELD_*' flags, only set by the CSV splitters.
+} StringField;
+
+/**
+ * 'SplitString' struct: the result of 'split_string_indexed', a single allocation holding a copy of the string's bytes
+ * (with each field NULL-terminated) and the offset/length index of its fields.
+ */
+typedef struct SplitString
+{
+	char *characters; // The copied bytes, field i is the C string 'characters + fields[i].offset'.
+	StringField *fields; // The 'fieldCount' fields.
+	int fieldCount;
+} SplitString;
+
+int split_string_fields(const char *characterString, size_t length, const char *delimiter, bool skipEmptyFields, StringField *fields, int maxFields); // Zero-copy split into caller-provided (offset, length) pairs, returns the actual field count.
+SplitString *split_string_indexed(const char *characterString, const char *delimiter, bool skipEmptyFields); // Splits a string with one allocation holding the bytes and an (offset, length) field index, released with a single 'free'.
+int split_csv_fields(const char *row, size_t length, char delimiter, StringField *fields, int maxFields); // Zero-copy, quote-aware split of an RFC 4180 CSV row using 64-byte quote masks, returns the actual field count.
+size_t csv_unescape_field(char *field, size_t length); // Collapses doubled quotes of a quoted CSV field in place, returns the new length.
+SplitString *split_csv_indexed(const char *row, char delimiter); // Quote-aware 'split_string_indexed': one allocation holding the unquoted, unescaped, NULL-terminated fields.
 /// \}
 
 
@@ -119,9 +262,79 @@ char **split_tokenized_string(const char* characterString, const char* delimiter
 
 // ------------- Helper Functions for Trimming and Pruning Strings -------------
 /// \{
+size_t remove_characters_in_set(char *destination, const char *source, size_t length, const CharacterSet *set); // Removes the members of a character set from a buffer(SIMD keep-mask compaction, may be in place), returns the new length.
+StringView trim_string_view(const char *characters, size_t length); // Trims leading and trailing whitespace without copying, returns a view into the original string.
+size_t trim_string_whitespaces_in_place(char *characterString); // Trims whitespace from a string within its own buffer, returns the new length.
 char *trim_string_whitespaces(char* untrimmedString); // Trims whitespace from a string.
+size_t prune_string_whitespaces_in_place(char *characterString); // Removes all whitespaces from a string within its own buffer, returns the new length.
 char *prune_string_whitespaces(char *unprunedString); // Removes all whitespaces from a string.
+size_t prune_repeated_delimiters_in_place(char *characterString, size_t capacity, const char *delimiter); // Handles repeated delimiters within a buffer of 'capacity' bytes, returns the new length.
 char *prune_repeated_delimiters_from_string(char *unprunedString, const char *delimiter);  // Handles repeated delimiters.
+size_t clean_delimited_string(const char *characterString, size_t length, const char *delimiter, int dateFieldCount, char **output, size_t *outputCapacity); // Single-pass whitespace removal, repeated delimiter handling and date/time conversion into a reusable, growable buffer.
+size_t clean_delimited_string_with_schema(const char *characterString, size_t length, const char *delimiter, const RowSchema *schema, char **output, size_t *outputCapacity); // 'clean_delimited_string' converting only the schema's date/time columns, each with its detected format.
+
+/**
+ * 'CleaningPipeline' struct and its stages: a composable row cleaning pipeline run in one fused pass by 'cleaning_pipeline_run'. Each stage
+ * is either built in or a callback and declares its kind, per byte(applied as each byte is copied), per field(applied to each field in
+ * place as soon as it is closed) or per row(applied to the finished row), so adding a step never adds a pass over the row.
+ */
+typedef enum PipelineStageKind
+{
+	PIPELINE_STAGE_PER_BYTE,
+	PIPELINE_STAGE_PER_FIELD,
+	PIPELINE_STAGE_PER_ROW
+} PipelineStageKind;
+
+typedef enum PipelineBuiltinStage
+{
+	PIPELINE_PRUNE_WHITESPACE, // Per byte: removes every whitespace character.
+	PIPELINE_TRIM_FIELDS, // Per field: removes the leading and trailing whitespace of each field.
+	PIPELINE_FILL_REPEATED_DELIMITERS, // Per field: writes '0' into the empty field between two repeated delimiters.
+	PIPELINE_DATE_TIME_TO_UNIX // Per field: replaces a date/time field with its Unix time.
+} PipelineBuiltinStage;
+
+typedef int (*PipelineByteFunction)(unsigned char c, void *context); // Returns the byte to write in place of 'c', or -1 to drop it.
+typedef size_t (*PipelineFieldFunction)(char *field, size_t length, size_t capacity, int fieldIndex, void *context); // Rewrites a field in place, returns its new length(or, like 'snprintf', the length needed if over 'capacity').
+typedef size_t (*PipelineRowFunction)(char *row, size_t length, size_t capacity, void *context); // Rewrites a row in place, returns its new length(or, like 'snprintf', the length needed if over 'capacity').
+
+typedef struct PipelineStage
+{
+	PipelineStageKind kind;
+	int builtin; // A 'PipelineBuiltinStage', or -1 for a callback.
+	union
+	{
+		PipelineByteFunction byteFunction;
+		PipelineFieldFunction fieldFunction;
+		PipelineRowFunction rowFunction;
+	};
+	void *context;
+} PipelineStage;
+
+#define PIPELINE_MAX_STAGES 16 // Maximum number of stages of each kind.
+#define PIPELINE_FIELD_HEADROOM 32 // Output bytes reserved beyond the input's worst case so most growing field stages never reallocate.
+
+typedef struct CleaningPipeline
+{
+	CharacterSet delimiters;
+	char repeatedDelimiter; // The delimiter checked for repetition by 'PIPELINE_FILL_REPEATED_DELIMITERS'.
+	bool pruneWhitespace; // Set by 'PIPELINE_PRUNE_WHITESPACE', which is fused into the SIMD block copy.
+	int dateFieldCount; // 'PIPELINE_DATE_TIME_TO_UNIX' only checks the first 'dateFieldCount' fields.
+	const int *dateTimeFormats; // Per field format for 'PIPELINE_DATE_TIME_TO_UNIX'(see 'RowSchema'), or NULL to try every format.
+	PipelineStage byteStages[PIPELINE_MAX_STAGES];
+	PipelineStage fieldStages[PIPELINE_MAX_STAGES];
+	PipelineStage rowStages[PIPELINE_MAX_STAGES];
+	int byteStageCount;
+	int fieldStageCount;
+	int rowStageCount;
+} CleaningPipeline;
+
+void cleaning_pipeline_init(CleaningPipeline *pipeline, const char *delimiter); // Initializes an empty pipeline for rows delimited by the characters of 'delimiter'.
+bool cleaning_pipeline_add_builtin(CleaningPipeline *pipeline, PipelineBuiltinStage builtin); // Adds a built-in stage(trim, prune, repeated delimiter placeholder, date/time to Unix time).
+bool cleaning_pipeline_add_byte_stage(CleaningPipeline *pipeline, PipelineByteFunction function, void *context); // Adds a per-byte callback.
+bool cleaning_pipeline_add_field_stage(CleaningPipeline *pipeline, PipelineFieldFunction function, void *context); // Adds a per-field callback.
+bool cleaning_pipeline_add_row_stage(CleaningPipeline *pipeline, PipelineRowFunction function, void *context); // Adds a per-row callback.
+void cleaning_pipeline_set_schema(CleaningPipeline *pipeline, const RowSchema *schema); // Restricts the date/time stage to a schema's date/time columns and formats.
+size_t cleaning_pipeline_run(const CleaningPipeline *pipeline, const char *characterString, size_t length, char **output, size_t *outputCapacity); // Cleans a row with every stage of a pipeline in one fused pass into a reusable, growable buffer.
 char *prune_and_trim_problematic_characters_from_string(char *originalString, const char *delimiter, const int fieldCount);  // Prunes and trims problematic characters.
 /// \}
 
@@ -135,6 +348,55 @@ char *prune_and_trim_problematic_characters_from_string(char *originalString, co
 char *replace_date_time_with_unix(char* characterString, const char *delimiter, const int fieldCount); // Replaces date/time with Unix time.
 
 char **preprocess_string_array(char **stringArray, int stringCount, const char *delimiter); // Preprocesses an array of strings, trimming and pruning whitespaces, repeated delimiters, and standardizing some variable parameters like date/time strings which have no standard formatting and are standardized by replacing them with unix representation .
+char **preprocess_string_array_parallel(char **stringArray, int stringCount, const char *delimiter, int numThreads); // Multi-threaded 'preprocess_string_array' with identical output order, a 'numThreads' <= 0 uses one thread per online processor.
+char **preprocess_string_array_arena(Arena *arena, char **stringArray, int stringCount, const char *delimiter); // Arena-backed 'preprocess_string_array', the whole batch is released with the arena.
+
+#define STREAM_DEFAULT_CHUNK_SIZE ((size_t)1 << 20) // Default size of the input and output buffers of 'preprocess_file_stream'.
+#define STREAM_DELIMITER_SAMPLE_ROWS 64 // Number of leading rows used to detect the delimiter and the date/time columns of a stream.
+long preprocess_file_stream(FILE *input, FILE *output, const char *delimiter, size_t chunkSize); // Preprocesses a stream row by row in fixed-size chunks with bounded memory, returns the number of rows written or -1.
+
+/**
+ * 'ColumnType' enum and 'Column' / 'ColumnTable' structs: the column-major, typed result of 'preprocess_string_array_columns'.
+ * Each column stores its values in the array matching its type, and bit i of 'validity' is set when row i has a value.
+ */
+typedef enum ColumnType
+{
+	COLUMN_TYPE_TEXT,
+	COLUMN_TYPE_NUMERIC,
+	COLUMN_TYPE_TIMESTAMP
+} ColumnType;
+
+typedef struct Column
+{
+	ColumnType type;
+	double *numbers; // COLUMN_TYPE_NUMERIC: one value per row, NaN for nulls.
+	int64_t *timestamps; // COLUMN_TYPE_TIMESTAMP: one Unix time per row, 0 for nulls.
+	size_t *textOffsets; // COLUMN_TYPE_TEXT: row i is 'textBytes[textOffsets[i]]' to 'textBytes[textOffsets[i + 1]]'(rowCount + 1 offsets).
+	char *textBytes; // COLUMN_TYPE_TEXT: the values of all rows back to back, without terminators.
+	uint64_t *validity; // Bit i is set when row i has a value.
+} Column;
+
+typedef struct ColumnTable
+{
+	int columnCount;
+	size_t rowCount;
+	Column *columns;
+} ColumnTable;
+
+
+static inline bool column_value_is_valid(const Column *column, size_t row) // Checks the validity bit of a row of a column.
+{
+	return (column->validity[row >> 6] >> (row & 63)) & 1;
+}
+
+static inline StringView column_text_value(const Column *column, size_t row) // Returns the value of a row of a text column as a view.
+{
+	StringView value = { column->textBytes + column->textOffsets[row], column->textOffsets[row + 1] - column->textOffsets[row] };
+	return value;
+}
+
+ColumnTable *preprocess_string_array_columns(char **stringArray, int stringCount, const char *delimiter); // Parses an array of rows once into typed column-major buffers(double, int64_t Unix time, text) with validity bitmaps.
+void column_table_destroy(ColumnTable *table); // Frees a column table and all of its columns.
 /// \}
 
 
@@ -150,6 +412,11 @@ void print_string_array_array(char*** stringArrayArray, int stringArraysCount, i
 void print_array(int n, double *data, char* label); // Prints an array of doubles.
 void print_array_array(double **data, int rows, int columns, char* label); // Prints a 2D array of doubles.
 void print_char_ptr_array(const char *charPtrArr[], int stringCount, char* label); // Prints an array of char pointers.
+
+bool print_string_array_to_writer(BufferedWriter *writer, char **stringArray, int stringCount, const char *separator); // Writes an array of strings to a buffered writer with a custom separator.
+bool print_char_ptr_array_to_writer(BufferedWriter *writer, const char *charPtrArr[], int stringCount, const char *separator); // Writes an array of char pointers to a buffered writer with a custom separator.
+bool print_array_to_writer(BufferedWriter *writer, const double *data, int n, const char *separator, int precision); // Writes an array of doubles to a buffered writer with a custom separator and precision.
+bool print_array_array_to_writer(BufferedWriter *writer, double **data, int rows, int columns, const char *separator, int precision); // Writes a 2D array of doubles to a buffered writer, one row per line.
 /// \}
 
 
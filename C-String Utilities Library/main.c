@@ -1,15 +1,27 @@
 //  main.c
 //  C-String Utilities Library
 /**
- * In the main function below are two examples that demonstrate some potential
+ * Run without arguments, the program runs the two examples below that demonstrate some potential
  * uses of the 'AuxiliaryUtilities' and 'StringUtilities' libraries.
  *
  * 		Example 1: 'extern const char *weekDays[7]' String Literal Manipulation
  * 		Example 2: Date/Time Operations, String Manipulation, and String Array Preprocessing
+ *
+ * Run with arguments, it is a command-line driver for the streaming preprocessor, 'preprocess_file_stream':
+ *
+ * 		main <input file | -> [output file | -] [-d delimiter] [-c chunk size in bytes]
+ *
+ * where '-' selects standard input/output, the output defaults to standard output, and the delimiter is detected when not given.
+ *
+ * Built with '-DUTILITIES_INSTRUMENTATION', the examples end with a report of the library's instrumentation counters on standard error.
+ *
+ * Run as 'main --benchmark-allocator', it compares the throughput of 'malloc' and the pooled allocator with 1 to 32 threads.
+ * Run as 'main --benchmark-sort [count]', it times 'qsort', 'merge_sort' and the radix sorts on 'count'(10 million) random doubles.
  */
 
 
 #include <stdio.h>
+#include <string.h>
 #include "AuxiliaryUtilities.h"
 #include "StringUtilities.h"
 
@@ -18,7 +30,12 @@
 
 
 
-int main(int argc, const char * argv[])
+/**
+ * run_examples
+ *
+ * Runs the examples, i.e., the program's behavior when it is given no arguments.
+ */
+static void run_examples(void)
 {
 // ------------- Example 1, weekDays String Literal Manipulation -------------
 /// \{
@@ -111,3 +128,306 @@ int main(int argc, const char * argv[])
 
 
 
+/**
+ * run_stream_preprocessor
+ *
+ * Parses the command-line arguments and preprocesses the input file to the output file with 'preprocess_file_stream'.
+ *
+ * @return The program's exit status.
+ */
+static int run_stream_preprocessor(int argc, const char * argv[])
+{
+	const char *inputPath = NULL;
+	const char *outputPath = "-";
+	const char *delimiter = NULL;
+	size_t chunkSize = 0;
+	int positionalCount = 0;
+	
+	
+	/// Parse the arguments.
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+		{
+			delimiter = argv[++i];
+		}
+		else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+		{
+			chunkSize = (size_t)strtoull(argv[++i], NULL, 10);
+		}
+		else if (positionalCount == 0)
+		{
+			inputPath = argv[i];
+			positionalCount++;
+		}
+		else if (positionalCount == 1)
+		{
+			outputPath = argv[i];
+			positionalCount++;
+		}
+		else
+		{
+			inputPath = NULL; // Too many arguments
+			break;
+		}
+	}
+	if (inputPath == NULL)
+	{
+		fprintf(stderr, "Usage: %s <input file | -> [output file | -] [-d delimiter] [-c chunk size in bytes]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	
+	
+	/// Open the files and run the streaming preprocessor.
+	FILE *input = (strcmp(inputPath, "-") == 0) ? stdin : fopen(inputPath, "rb");
+	if (input == NULL)
+	{
+		perror(inputPath);
+		return EXIT_FAILURE;
+	}
+	FILE *output = (strcmp(outputPath, "-") == 0) ? stdout : fopen(outputPath, "wb");
+	if (output == NULL)
+	{
+		perror(outputPath);
+		return EXIT_FAILURE;
+	}
+	
+	long rowCount = preprocess_file_stream(input, output, delimiter, chunkSize);
+	
+	if (input != stdin)
+	{
+		fclose(input);
+	}
+	if (output != stdout && fclose(output) != 0)
+	{
+		rowCount = -1;
+	}
+	
+	if (rowCount < 0)
+	{
+		fprintf(stderr, "Error: preprocessing '%s' failed.\n", inputPath);
+		return EXIT_FAILURE;
+	}
+	fprintf(stderr, "Preprocessed %ld rows.\n", rowCount);
+	return EXIT_SUCCESS;
+}
+
+
+
+
+
+
+/**
+ * Allocator benchmark
+ *
+ * Every thread keeps a ring of 'ALLOCATOR_BENCHMARK_LIVE_BLOCKS' live blocks of 4 to 64 bytes, replacing the oldest on each step,
+ * so each step is one free and one allocation of a small string, the library's typical allocation.
+ */
+#define ALLOCATOR_BENCHMARK_STEPS 2000000
+#define ALLOCATOR_BENCHMARK_LIVE_BLOCKS 1024
+
+typedef struct AllocatorBenchmarkTask
+{
+	const UtilitiesAllocator *allocator; // NULL for 'malloc' and 'free'.
+	unsigned seed;
+} AllocatorBenchmarkTask;
+
+
+/**
+ * allocator_benchmark_worker
+ *
+ * Runs one thread's allocation steps with the task's allocator.
+ */
+static void *allocator_benchmark_worker(void *argument)
+{
+	AllocatorBenchmarkTask *task = (AllocatorBenchmarkTask *)argument;
+	const UtilitiesAllocator *allocator = task->allocator;
+	void *ring[ALLOCATOR_BENCHMARK_LIVE_BLOCKS] = { NULL };
+	unsigned state = task->seed;
+	
+	for (long step = 0; step < ALLOCATOR_BENCHMARK_STEPS; step++)
+	{
+		state = state * 1103515245u + 12345u;
+		size_t size = 4 + ((state >> 16) % 61);
+		size_t slot = (size_t)step % ALLOCATOR_BENCHMARK_LIVE_BLOCKS;
+		
+		if (allocator == NULL)
+		{
+			free(ring[slot]);
+			ring[slot] = malloc(size);
+		}
+		else
+		{
+			allocator->deallocate(ring[slot], allocator->context);
+			ring[slot] = allocator->allocate(size, allocator->context);
+		}
+		if (ring[slot] != NULL)
+		{
+			((char *)ring[slot])[0] = (char)step; // Touch the block.
+		}
+	}
+	
+	for (size_t slot = 0; slot < ALLOCATOR_BENCHMARK_LIVE_BLOCKS; slot++)
+	{
+		if (allocator == NULL)
+		{
+			free(ring[slot]);
+		}
+		else
+		{
+			allocator->deallocate(ring[slot], allocator->context);
+		}
+	}
+	return NULL;
+}
+
+
+/**
+ * run_allocator_benchmark
+ *
+ * Measures the alloc/free throughput of 'malloc' and of the pooled allocator with 1 to 32 threads.
+ *
+ * @return The program's exit status.
+ */
+static int run_allocator_benchmark(void)
+{
+	const int threadCounts[6] = { 1, 2, 4, 8, 16, 32 };
+	const UtilitiesAllocator *allocators[2] = { NULL, utilities_pooled_allocator() };
+	const char *allocatorNames[2] = { "malloc", "pooled" };
+	
+	printf("%8s %12s %12s\n", "threads", allocatorNames[0], allocatorNames[1]);
+	for (int t = 0; t < 6; t++)
+	{
+		int numThreads = threadCounts[t];
+		double throughput[2];
+		
+		for (int a = 0; a < 2; a++)
+		{
+			pthread_t threads[32];
+			AllocatorBenchmarkTask tasks[32];
+			struct timespec start, end;
+			
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			for (int i = 0; i < numThreads; i++)
+			{
+				tasks[i].allocator = allocators[a];
+				tasks[i].seed = (unsigned)(i + 1);
+				pthread_create(&threads[i], NULL, allocator_benchmark_worker, &tasks[i]);
+			}
+			for (int i = 0; i < numThreads; i++)
+			{
+				pthread_join(threads[i], NULL);
+			}
+			clock_gettime(CLOCK_MONOTONIC, &end);
+			
+			double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+			throughput[a] = (double)numThreads * ALLOCATOR_BENCHMARK_STEPS / seconds * 1e-6;
+		}
+		printf("%8d %12.1f %12.1f\n", numThreads, throughput[0], throughput[1]);
+	}
+	printf("(millions of alloc/free pairs per second)\n");
+	return EXIT_SUCCESS;
+}
+
+
+
+
+
+
+/**
+ * compare_doubles
+ *
+ * 'qsort' comparison of two doubles.
+ */
+static int compare_doubles(const void *a, const void *b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+
+/**
+ * run_sort_benchmark
+ *
+ * Times 'qsort', 'merge_sort' and the radix sorts(the parallel one on every processor) on the same random doubles(mixed signs and
+ * magnitudes) and checks each result.
+ *
+ * @param numElements The number of doubles to sort.
+ * @return The program's exit status.
+ */
+static int run_sort_benchmark(int numElements)
+{
+	double *original = (double *)malloc((size_t)numElements * sizeof(double));
+	double *data = (double *)malloc((size_t)numElements * sizeof(double));
+	if (original == NULL || data == NULL){ perror("\n\nError: Unable to allocate memory in 'run_sort_benchmark'.\n");      return EXIT_FAILURE; }
+	
+	uint64_t state = 88172645463325252ull;
+	for (int i = 0; i < numElements; i++)
+	{
+		state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+		original[i] = ((double)(int64_t)state) * 1e-12 / (double)(1 + (state & 0xFFFF));
+	}
+	
+	const char *names[5] = { "qsort", "merge_sort", "radix_sort_doubles", "radix_sort_doubles_11bit", "radix_sort_doubles_parallel" };
+	printf("%d doubles\n", numElements);
+	for (int algorithm = 0; algorithm < 5; algorithm++)
+	{
+		copy_memory_block(data, original, (size_t)numElements * sizeof(double));
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		switch (algorithm)
+		{
+			case 0: qsort(data, (size_t)numElements, sizeof(double), compare_doubles); break;
+			case 1: merge_sort(data, numElements); break;
+			case 2: radix_sort_doubles(data, numElements); break;
+			case 3: radix_sort_doubles_11bit(data, numElements); break;
+			default: radix_sort_doubles_parallel(data, numElements, 0); break;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		
+		bool sorted = true;
+		for (int i = 1; i < numElements && sorted; i++)
+		{
+			sorted = (data[i - 1] <= data[i]);
+		}
+		double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+		printf("%-28s %10.3f ms %s\n", names[algorithm], seconds * 1e3, sorted ? "" : "(NOT SORTED)");
+	}
+	
+	free(original);
+	free(data);
+	return EXIT_SUCCESS;
+}
+
+
+
+
+
+
+int main(int argc, const char * argv[])
+{
+	if (argc >= 2 && argc <= 3 && strcmp(argv[1], "--benchmark-sort") == 0)
+	{
+		return run_sort_benchmark((argc == 3) ? atoi(argv[2]) : 10000000);
+	}
+	if (argc == 2 && strcmp(argv[1], "--benchmark-allocator") == 0)
+	{
+		return run_allocator_benchmark();
+	}
+	if (argc > 1)
+	{
+		return run_stream_preprocessor(argc, argv);
+	}
+	
+	run_examples();
+	
+#ifdef UTILITIES_INSTRUMENTATION
+	InstrumentationSnapshot snapshot;
+	instrumentation_snapshot(&snapshot);
+	BufferedWriter *report = writer_create_file(stderr, 0);
+	instrumentation_write_text(&snapshot, report);
+	writer_destroy(report);
+#endif
+	return 0;
+}
@@ -0,0 +1,178 @@
+//  test_date_time.c
+//  C-String Utilities Library tests
+/**
+ * Date/time parsing and conversion: every format of 'commonDateTimeFormats' round-trips through 'convert_to_unix_time',
+ * 'convert_tm_to_unix_time' agrees with 'mktime', and the serial, parallel and streaming preprocessors convert the date/time
+ * fields of the same rows identically, whatever the thread count or chunk size. Run with TZ=UTC.
+ */
+
+#include "test_utilities.h"
+#include <time.h>
+
+
+
+
+/**
+ * test_formats_round_trip
+ *
+ * Formats random times with each of the common formats and checks that they convert back to the same Unix time.
+ */
+static void test_formats_round_trip(void)
+{
+	uint64_t state = 1;
+	for (int i = 0; i < 2000; i++)
+	{
+		time_t unixTime = (time_t)(test_random(&state) % 4102444800ULL); // 1970 to 2100
+		struct tm utc;
+		gmtime_r(&unixTime, &utc);
+
+		for (int format = 0; format < 12; format++)
+		{
+			char formatted[64];
+			strftime(formatted, sizeof(formatted), commonDateTimeFormats[format], &utc);
+			time_t expected = strstr(commonDateTimeFormats[format], "%S") != NULL ? unixTime : unixTime - utc.tm_sec;
+			time_t converted = convert_to_unix_time(formatted);
+			CHECK_MESSAGE(converted == expected, "'%s' with '%s' gave %lld, expected %lld", formatted, commonDateTimeFormats[format],
+						  (long long)converted, (long long)expected);
+		}
+	}
+
+	CHECK(convert_to_unix_time("2024-01-02 10:00:00") == 1704189600);
+	CHECK(convert_to_unix_time("01/02/2024 10:00:00 AM") == 1704189600);
+	CHECK(convert_to_unix_time("02-01-2024 10:00") == 1704189600);
+}
+
+
+/**
+ * test_tm_conversion_matches_mktime
+ *
+ * Checks the arithmetic conversion against 'mktime' on random broken-down times, including out of range fields.
+ */
+static void test_tm_conversion_matches_mktime(void)
+{
+	uint64_t state = 2;
+	for (int i = 0; i < 20000; i++)
+	{
+		uint64_t r = test_random(&state);
+		struct tm tm;
+		memset(&tm, 0, sizeof(tm));
+		tm.tm_year = 70 + (int)(r % 130);
+		tm.tm_mon = (int)((r >> 8) % 12);
+		tm.tm_mday = 1 + (int)((r >> 16) % 28);
+		tm.tm_hour = (int)((r >> 24) % 24);
+		tm.tm_min = (int)((r >> 32) % 60);
+		tm.tm_sec = (int)((r >> 40) % 60);
+		if (i % 100 == 0)
+		{
+			tm.tm_mday += 40; // Out of range, normalized by 'mktime'.
+		}
+
+		struct tm copy = tm;
+		time_t expected = mktime(&copy);
+		CHECK_MESSAGE(convert_tm_to_unix_time(&tm) == expected, "%04d-%02d-%02d %02d:%02d:%02d", tm.tm_year + 1900, tm.tm_mon + 1,
+					  tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+	}
+}
+
+
+/**
+ * test_date_time_detection
+ *
+ * Checks which fields of a row are recognized as date/times.
+ */
+static void test_date_time_detection(void)
+{
+	int *results = string_is_date_time("7,2024-01-02 10:00:00,text,2024/01/02 10:00", ",", 4);
+	CHECK(results[0] == 0 && results[1] == 1 && results[2] == 0 && results[3] == 1);
+	utilities_free(results);
+
+	CHECK(convert_to_unix_time("not a date") == -1);
+}
+
+
+/**
+ * test_preprocessors_agree
+ *
+ * Preprocesses a header and rows with a date/time column serially, in parallel and as a stream with several chunk sizes. The
+ * date/times must be converted in every case, including chunks too small to hold the rows the column types are detected from.
+ */
+static void test_preprocessors_agree(void)
+{
+	enum { ROW_COUNT = 201 };
+	char *rows[ROW_COUNT];
+	char *streamText = (char *)malloc(ROW_COUNT * 64);
+	size_t streamLength = 0;
+	for (int i = 0; i < ROW_COUNT; i++)
+	{
+		char row[64];
+		if (i == 0)
+		{
+			snprintf(row, sizeof(row), "id,date,name");
+		}
+		else
+		{
+			snprintf(row, sizeof(row), "%d, 2015-10-28 02:16:%02d ,n%d", i, i % 60, i);
+		}
+		rows[i] = strdup(row);
+		streamLength += (size_t)sprintf(streamText + streamLength, "%s\n", row);
+	}
+
+	char **serial = preprocess_string_array(rows, ROW_COUNT, ",");
+	CHECK(strcmp(serial[0], "id,date,name") == 0);
+	CHECK(strcmp(serial[1], "1,1445998561,n1") == 0);
+	CHECK(strcmp(serial[200], "200,1445998580,n200") == 0);
+
+	int threadCounts[] = { 1, 2, 7 };
+	for (int t = 0; t < 3; t++)
+	{
+		char **parallel = preprocess_string_array_parallel(rows, ROW_COUNT, ",", threadCounts[t]);
+		for (int i = 0; i < ROW_COUNT; i++)
+		{
+			CHECK_MESSAGE(strcmp(parallel[i], serial[i]) == 0, "row %d with %d threads", i, threadCounts[t]);
+			utilities_free(parallel[i]);
+		}
+		utilities_free(parallel);
+	}
+
+	size_t chunkSizes[] = { 5, 17, 64, 0 };
+	for (int c = 0; c < 4; c++)
+	{
+		FILE *input = fmemopen(streamText, streamLength, "r");
+		char *outputText = NULL;
+		size_t outputLength = 0;
+		FILE *output = open_memstream(&outputText, &outputLength);
+		CHECK(preprocess_file_stream(input, output, NULL, chunkSizes[c]) == ROW_COUNT);
+		fclose(input);
+		fclose(output);
+
+		char *line = outputText;
+		for (int i = 0; i < ROW_COUNT && line != NULL; i++)
+		{
+			char *newline = strchr(line, '\n');
+			CHECK_MESSAGE(newline != NULL && (size_t)(newline - line) == strlen(serial[i]) && strncmp(line, serial[i], strlen(serial[i])) == 0,
+						  "row %d with chunk size %zu", i, chunkSizes[c]);
+			line = (newline != NULL) ? newline + 1 : NULL;
+		}
+		free(outputText);
+	}
+
+	for (int i = 0; i < ROW_COUNT; i++)
+	{
+		utilities_free(serial[i]);
+		free(rows[i]);
+	}
+	utilities_free(serial);
+	free(streamText);
+}
+
+
+
+
+int main(void)
+{
+	test_formats_round_trip();
+	test_tm_conversion_matches_mktime();
+	test_date_time_detection();
+	test_preprocessors_agree();
+	return TEST_RESULT();
+}
@@ -0,0 +1,141 @@
+//  test_describe.c
+//  C-String Utilities Library tests
+/**
+ * Descriptive statistics: 'describe', 'describe_parallel' and 'minmax_element' agree with a two-pass long double reference on
+ * arrays with NaNs and a large common offset, whatever the thread count, and follow the documented rules for empty arrays, all-NaN
+ * arrays and infinities. Build with and without -mavx2 to cover both passes.
+ */
+
+#include "test_utilities.h"
+
+
+
+
+/**
+ * close_to
+ *
+ * Returns true if 'value' is within a relative 'tolerance' of 'reference', or both are NaN.
+ */
+static bool close_to(double value, long double reference, double tolerance)
+{
+	if (isnan(value) || isnan(reference))
+	{
+		return isnan(value) && isnan(reference);
+	}
+	return fabsl((long double)value - reference) <= tolerance * fabsl(reference) + 1e-300;
+}
+
+
+/**
+ * check_against_reference
+ *
+ * Describes an array serially and with several thread counts, and compares the results with a two-pass long double computation.
+ */
+static void check_against_reference(const double *data, size_t n)
+{
+	size_t count = 0;
+	long double sum = 0.0L, squares = 0.0L;
+	double minimum = NAN, maximum = NAN;
+	for (size_t i = 0; i < n; i++)
+	{
+		if (!isnan(data[i]))
+		{
+			minimum = (count == 0 || data[i] < minimum) ? data[i] : minimum;
+			maximum = (count == 0 || data[i] > maximum) ? data[i] : maximum;
+			sum += data[i];
+			count++;
+		}
+	}
+	long double mean = (count > 0) ? sum / count : NAN;
+	for (size_t i = 0; i < n; i++)
+	{
+		if (!isnan(data[i]))
+		{
+			squares += (data[i] - mean) * (data[i] - mean);
+		}
+	}
+	long double variance = (count > 0) ? squares / count : NAN;
+	long double sampleVariance = (count > 1) ? squares / (count - 1) : NAN;
+
+	double minmaxMinimum, minmaxMaximum;
+	minmax_element(data, n, &minmaxMinimum, &minmaxMaximum);
+	CHECK_MESSAGE(close_to(minmaxMinimum, minimum, 0.0) && close_to(minmaxMaximum, maximum, 0.0), "minmax_element, n = %zu", n);
+
+	int threadCounts[] = { 0, 1, 2, 7 }; // 0 stands for the serial 'describe'.
+	for (int t = 0; t < 4; t++)
+	{
+		DescriptiveStatistics statistics = (t == 0) ? describe(data, n) : describe_parallel(data, n, threadCounts[t]);
+		CHECK_MESSAGE(statistics.count == count && statistics.nanCount == n - count, "counts, n = %zu, %d threads", n, threadCounts[t]);
+		CHECK_MESSAGE(close_to(statistics.minimum, minimum, 0.0) && close_to(statistics.maximum, maximum, 0.0),
+					  "minimum and maximum, n = %zu, %d threads", n, threadCounts[t]);
+		CHECK_MESSAGE(close_to(statistics.sum, sum, 1e-15), "sum %.17g vs %.17Lg, n = %zu, %d threads", statistics.sum, sum, n, threadCounts[t]);
+		/// The mean is Welford's running mean rather than the compensated sum over the count, so it is held to a looser bound.
+		CHECK_MESSAGE(close_to(statistics.mean, mean, 1e-13), "mean %.17g vs %.17Lg, n = %zu, %d threads", statistics.mean, mean, n, threadCounts[t]);
+		CHECK_MESSAGE(close_to(statistics.variance, variance, 1e-9) && close_to(statistics.sampleVariance, sampleVariance, 1e-9),
+					  "variance %.17g vs %.17Lg, n = %zu, %d threads", statistics.variance, variance, n, threadCounts[t]);
+	}
+}
+
+
+/**
+ * test_random_arrays
+ *
+ * Describes arrays of values around a large offset, where a one-pass sum of squares would lose the variance, with one value in
+ * twenty a NaN.
+ */
+static void test_random_arrays(void)
+{
+	const size_t sizes[] = { 1, 2, 3, 7, 1000, DESCRIBE_PARALLEL_THRESHOLD * 2 + 5 };
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		size_t n = sizes[s];
+		double *data = (double *)malloc(n * sizeof(double));
+		uint64_t state = 60 + s;
+		for (size_t i = 0; i < n; i++)
+		{
+			uint64_t r = test_random(&state);
+			data[i] = (r % 20 == 0) ? NAN : 1e6 + (double)(int64_t)(r >> 11) / 9007199254740992.0;
+		}
+		check_against_reference(data, n);
+		free(data);
+	}
+}
+
+
+/**
+ * test_special_arrays
+ *
+ * Checks the empty and all-NaN arrays and the handling of infinities.
+ */
+static void test_special_arrays(void)
+{
+	DescriptiveStatistics statistics = describe(NULL, 0);
+	CHECK(statistics.count == 0 && statistics.nanCount == 0 && isnan(statistics.mean) && isnan(statistics.minimum));
+
+	const double allNan[] = { NAN, NAN, NAN };
+	statistics = describe(allNan, 3);
+	CHECK(statistics.count == 0 && statistics.nanCount == 3 && isnan(statistics.mean) && isnan(statistics.variance));
+
+	const double oneInfinity[] = { 1.0, INFINITY, NAN, 2.0 };
+	statistics = describe(oneInfinity, 4);
+	CHECK(statistics.count == 3 && statistics.sum == INFINITY && statistics.mean == INFINITY && statistics.maximum == INFINITY);
+	CHECK(isnan(statistics.variance));
+
+	const double bothInfinities[] = { -INFINITY, 1.0, INFINITY };
+	statistics = describe(bothInfinities, 3);
+	CHECK(isnan(statistics.sum) && isnan(statistics.mean) && statistics.minimum == -INFINITY && statistics.maximum == INFINITY);
+
+	const double single[] = { 4.0 };
+	statistics = describe(single, 1);
+	CHECK(statistics.mean == 4.0 && statistics.variance == 0.0 && isnan(statistics.sampleVariance));
+}
+
+
+
+
+int main(void)
+{
+	test_random_arrays();
+	test_special_arrays();
+	return TEST_RESULT();
+}
@@ -0,0 +1,241 @@
+//  test_key_value_sort.c
+//  C-String Utilities Library tests
+/**
+ * Key-value sorts and argsort: the keys come out in order and equal keys keep the original order of their payloads, as with a
+ * 'qsort' that breaks ties by position. The gather functions reorder other columns by an argsort permutation, and empty inputs are
+ * accepted.
+ */
+
+#include "test_utilities.h"
+
+
+
+
+/// A key and its original position, sorted by 'qsort' to give the expected stable order.
+typedef struct IndexedKey
+{
+	uint64_t key;
+	uint32_t index;
+} IndexedKey;
+
+
+/**
+ * compare_indexed_keys
+ *
+ * 'qsort' comparator of sortable keys that breaks ties by original position, making the order stable.
+ */
+static int compare_indexed_keys(const void *a, const void *b)
+{
+	const IndexedKey *x = (const IndexedKey *)a, *y = (const IndexedKey *)b;
+	if (x->key != y->key)
+	{
+		return (x->key < y->key) ? -1 : 1;
+	}
+	return (x->index > y->index) - (x->index < y->index);
+}
+
+
+/**
+ * random_keys
+ *
+ * Fills matching arrays of double and int64_t keys, from a range of 'distinctKeys' values to force ties, or from every bit pattern
+ * if 'distinctKeys' is 0. The doubles include zeros of both signs, infinities and NaNs.
+ */
+static void random_keys(double *doubleKeys, int64_t *integerKeys, size_t count, uint64_t distinctKeys, uint64_t seed)
+{
+	const double specials[] = { 0.0, -0.0, INFINITY, -INFINITY, NAN, -NAN };
+	uint64_t state = seed;
+	for (size_t i = 0; i < count; i++)
+	{
+		uint64_t r = test_random(&state);
+		if (distinctKeys == 0)
+		{
+			memcpy(&doubleKeys[i], &r, sizeof(double));
+			integerKeys[i] = (int64_t)r;
+		}
+		else
+		{
+			int64_t small = (int64_t)(r % distinctKeys) - (int64_t)(distinctKeys / 2);
+			doubleKeys[i] = (r >> 60 == 0) ? specials[(r >> 32) % 6] : (double)small * 0.25;
+			integerKeys[i] = small;
+		}
+	}
+}
+
+
+/**
+ * expected_order
+ *
+ * Returns the stable sorted order of the keys, given as their sortable 64-bit keys.
+ */
+static IndexedKey *expected_order(const uint64_t *sortableKeys, size_t count)
+{
+	IndexedKey *order = (IndexedKey *)malloc((count + 1) * sizeof(IndexedKey));
+	for (size_t i = 0; i < count; i++)
+	{
+		order[i].key = sortableKeys[i];
+		order[i].index = (uint32_t)i;
+	}
+	qsort(order, count, sizeof(IndexedKey), compare_indexed_keys);
+	return order;
+}
+
+
+/**
+ * test_sorts_case
+ *
+ * Runs the four key-value sorts and both argsorts on one set of keys, with the original positions as payloads.
+ */
+static void test_sorts_case(size_t count, uint64_t distinctKeys, uint64_t seed)
+{
+	double *doubleKeys = (double *)malloc((count + 1) * sizeof(double));
+	int64_t *integerKeys = (int64_t *)malloc((count + 1) * sizeof(int64_t));
+	uint64_t *sortable = (uint64_t *)calloc(count + 1, sizeof(uint64_t));
+	random_keys(doubleKeys, integerKeys, count, distinctKeys, seed);
+
+	/// Double keys.
+	for (size_t i = 0; i < count; i++)
+	{
+		sortable[i] = double_to_sortable_key(doubleKeys[i]);
+	}
+	IndexedKey *expected = expected_order(sortable, count);
+
+	double *keys = (double *)malloc((count + 1) * sizeof(double));
+	uint32_t *payloads32 = (uint32_t *)malloc((count + 1) * sizeof(uint32_t));
+	uint64_t *payloads64 = (uint64_t *)malloc((count + 1) * sizeof(uint64_t));
+	memcpy(keys, doubleKeys, count * sizeof(double));
+	for (size_t i = 0; i < count; i++)
+	{
+		payloads32[i] = (uint32_t)i;
+	}
+	radix_sort_key_value_double_u32(keys, payloads32, count);
+	for (size_t i = 0; i < count; i++)
+	{
+		CHECK_MESSAGE(double_to_sortable_key(keys[i]) == expected[i].key && payloads32[i] == expected[i].index,
+					  "double keys, 32-bit payloads, %zu of %zu", i, count);
+	}
+
+	memcpy(keys, doubleKeys, count * sizeof(double));
+	for (size_t i = 0; i < count; i++)
+	{
+		payloads64[i] = ((uint64_t)i << 32) | 0xABCDu;
+	}
+	radix_sort_key_value_double_u64(keys, payloads64, count);
+	for (size_t i = 0; i < count; i++)
+	{
+		CHECK_MESSAGE(double_to_sortable_key(keys[i]) == expected[i].key && payloads64[i] == (((uint64_t)expected[i].index << 32) | 0xABCDu),
+					  "double keys, 64-bit payloads, %zu of %zu", i, count);
+	}
+
+	uint32_t *permutation = argsort_doubles(doubleKeys, count);
+	CHECK((permutation == NULL) == (count == 0));
+	for (size_t i = 0; i < count; i++)
+	{
+		CHECK_MESSAGE(permutation[i] == expected[i].index, "argsort_doubles, %zu of %zu", i, count);
+	}
+	gather_doubles(keys, doubleKeys, permutation, count);
+	for (size_t i = 0; i < count; i++)
+	{
+		CHECK_MESSAGE(memcmp(&keys[i], &doubleKeys[expected[i].index], sizeof(double)) == 0, "gather_doubles, %zu of %zu", i, count);
+	}
+	utilities_free(permutation);
+	free(expected);
+
+	/// Integer keys.
+	for (size_t i = 0; i < count; i++)
+	{
+		sortable[i] = (uint64_t)integerKeys[i] ^ (1ULL << 63);
+	}
+	expected = expected_order(sortable, count);
+
+	int64_t *integers = (int64_t *)malloc((count + 1) * sizeof(int64_t));
+	memcpy(integers, integerKeys, count * sizeof(int64_t));
+	for (size_t i = 0; i < count; i++)
+	{
+		payloads32[i] = (uint32_t)i;
+	}
+	radix_sort_key_value_int64_u32(integers, payloads32, count);
+	for (size_t i = 0; i < count; i++)
+	{
+		CHECK_MESSAGE(integers[i] == integerKeys[expected[i].index] && payloads32[i] == expected[i].index,
+					  "int64_t keys, 32-bit payloads, %zu of %zu", i, count);
+	}
+
+	memcpy(integers, integerKeys, count * sizeof(int64_t));
+	for (size_t i = 0; i < count; i++)
+	{
+		payloads64[i] = ((uint64_t)i << 32) | 0xABCDu;
+	}
+	radix_sort_key_value_int64_u64(integers, payloads64, count);
+	for (size_t i = 0; i < count; i++)
+	{
+		CHECK_MESSAGE(integers[i] == integerKeys[expected[i].index] && payloads64[i] == (((uint64_t)expected[i].index << 32) | 0xABCDu),
+					  "int64_t keys, 64-bit payloads, %zu of %zu", i, count);
+	}
+
+	permutation = argsort_int64(integerKeys, count);
+	CHECK((permutation == NULL) == (count == 0));
+	for (size_t i = 0; i < count; i++)
+	{
+		CHECK_MESSAGE(permutation[i] == expected[i].index, "argsort_int64, %zu of %zu", i, count);
+	}
+	gather_int64(integers, integerKeys, permutation, count);
+	for (size_t i = 0; i < count; i++)
+	{
+		CHECK_MESSAGE(integers[i] == integerKeys[expected[i].index], "gather_int64, %zu of %zu", i, count);
+	}
+	utilities_free(permutation);
+	free(expected);
+
+	free(doubleKeys);
+	free(integerKeys);
+	free(sortable);
+	free(keys);
+	free(payloads32);
+	free(payloads64);
+	free(integers);
+}
+
+
+/**
+ * test_gather_strings
+ *
+ * Sorts the rows of a small table by their numeric column and gathers the name column with the permutation.
+ */
+static void test_gather_strings(void)
+{
+	double scores[] = { 3.0, 1.0, 2.0, 1.0, 3.0 };
+	char *names[] = { "c1", "a1", "b", "a2", "c2" };
+	const char *expected[] = { "a1", "a2", "b", "c1", "c2" };
+	char *sortedNames[5];
+
+	uint32_t *permutation = argsort_doubles(scores, 5);
+	gather_strings(sortedNames, names, permutation, 5);
+	for (int i = 0; i < 5; i++)
+	{
+		CHECK_MESSAGE(strcmp(sortedNames[i], expected[i]) == 0, "row %d is %s, expected %s", i, sortedNames[i], expected[i]);
+	}
+	utilities_free(permutation);
+
+	gather_strings(NULL, NULL, NULL, 0);
+	gather_doubles(NULL, NULL, NULL, 0);
+	gather_int64(NULL, NULL, NULL, 0);
+	radix_sort_key_value_double_u32(NULL, NULL, 0);
+	radix_sort_key_value_int64_u64(NULL, NULL, 0);
+}
+
+
+
+
+int main(void)
+{
+	const size_t sizes[] = { 0, 1, 2, 100, 5000, 300000 };
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		test_sorts_case(sizes[s], 0, 10 + s);
+		test_sorts_case(sizes[s], 16, 20 + s);
+		test_sorts_case(sizes[s], 70000, 30 + s);
+	}
+	test_gather_strings();
+	return TEST_RESULT();
+}
@@ -0,0 +1,158 @@
+//  test_number_format.c
+//  C-String Utilities Library tests
+/**
+ * Number formatting: 'format_double_shortest' output reads back as the same double and uses the fewest significant digits
+ * (up to 17 only in rare cases), in the documented "%g"-like layout, and 'format_int64' matches 'snprintf'.
+ */
+
+#include "test_utilities.h"
+
+
+
+
+/**
+ * significant_digits
+ *
+ * Counts the significant digits of a formatted number, ignoring its sign, decimal point, exponent and leading and trailing zeros.
+ */
+static int significant_digits(const char *formatted)
+{
+	char digits[64];
+	int count = 0;
+	for (const char *c = formatted; *c != '\0' && *c != 'e'; c++)
+	{
+		if (*c >= '0' && *c <= '9' && (count > 0 || *c != '0'))
+		{
+			digits[count++] = *c;
+		}
+	}
+	while (count > 0 && digits[count - 1] == '0')
+	{
+		count--;
+	}
+	return count;
+}
+
+
+/**
+ * shortest_precision
+ *
+ * Returns the fewest significant digits with which 'printf' writes a double that reads back as the same value.
+ */
+static int shortest_precision(double value)
+{
+	char formatted[64];
+	for (int precision = 1; precision < 17; precision++)
+	{
+		snprintf(formatted, sizeof(formatted), "%.*g", precision, value);
+		if (strtod(formatted, NULL) == value)
+		{
+			return precision;
+		}
+	}
+	return 17;
+}
+
+
+/**
+ * test_double_round_trip
+ *
+ * Formats random bit patterns and random fractions, checking the round trip, the digit count and the reported length.
+ */
+static void test_double_round_trip(void)
+{
+	uint64_t state = 3;
+	int checked = 0, longerThanShortest = 0;
+	for (int i = 0; i < 200000; i++)
+	{
+		uint64_t r = test_random(&state);
+		double value;
+		if (i % 2 == 0)
+		{
+			memcpy(&value, &r, sizeof(value));
+		}
+		else
+		{
+			value = (double)(int32_t)(r >> 32) / (double)(1 + (r & 0xFFFF));
+		}
+		if (!isfinite(value))
+		{
+			continue;
+		}
+
+		char formatted[NUMBER_FORMAT_BUFFER_SIZE];
+		size_t length = format_double_shortest(value, formatted);
+		double readBack = strtod(formatted, NULL);
+		CHECK_MESSAGE(length == strlen(formatted), "%s", formatted);
+		CHECK_MESSAGE(memcmp(&readBack, &value, sizeof(value)) == 0, "%s does not read back as %.17g", formatted, value);
+
+		int digits = significant_digits(formatted);
+		int shortest = shortest_precision(value);
+		CHECK_MESSAGE(digits >= shortest && digits <= 17, "%s has %d digits, %d are enough", formatted, digits, shortest);
+		longerThanShortest += (digits > shortest);
+		checked++;
+	}
+	CHECK_MESSAGE(longerThanShortest * 1000 < checked, "%d of %d values used more digits than needed", longerThanShortest, checked);
+}
+
+
+/**
+ * test_double_layout
+ *
+ * Checks the layout of special values and of the fixed and scientific notations.
+ */
+static void test_double_layout(void)
+{
+	struct { double value; const char *expected; } cases[] =
+	{
+		{ 0.0, "0" }, { -0.0, "-0" }, { NAN, "nan" }, { INFINITY, "inf" }, { -INFINITY, "-inf" },
+		{ 0.1, "0.1" }, { 123.5, "123.5" }, { -2.25, "-2.25" }, { 1e20, "1e+20" }, { 2.5e-7, "2.5e-07" },
+		{ 0.0001, "0.0001" }, { 1e-5, "1e-05" }, { 1e16, "10000000000000000" }, { 1e17, "1e+17" },
+		{ 5e-324, "5e-324" }, { 1.7976931348623157e308, "1.7976931348623157e+308" }
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+	{
+		char formatted[NUMBER_FORMAT_BUFFER_SIZE];
+		format_double_shortest(cases[i].value, formatted);
+		CHECK_MESSAGE(strcmp(formatted, cases[i].expected) == 0, "got %s, expected %s", formatted, cases[i].expected);
+	}
+}
+
+
+/**
+ * test_int64
+ *
+ * Compares 'format_int64' with 'snprintf' on the limits and random values of every magnitude.
+ */
+static void test_int64(void)
+{
+	int64_t cases[] = { 0, 1, -1, 9, 10, 99, 100, INT64_MAX, INT64_MIN, INT64_MIN + 1 };
+	char formatted[NUMBER_FORMAT_BUFFER_SIZE], expected[NUMBER_FORMAT_BUFFER_SIZE];
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+	{
+		format_int64(cases[i], formatted);
+		snprintf(expected, sizeof(expected), "%lld", (long long)cases[i]);
+		CHECK_MESSAGE(strcmp(formatted, expected) == 0, "got %s, expected %s", formatted, expected);
+	}
+
+	uint64_t state = 4;
+	for (int i = 0; i < 100000; i++)
+	{
+		int64_t value = (int64_t)(test_random(&state) >> (i % 64));
+		value = (i % 3 == 0) ? -value : value;
+		size_t length = format_int64(value, formatted);
+		snprintf(expected, sizeof(expected), "%lld", (long long)value);
+		CHECK_MESSAGE(strcmp(formatted, expected) == 0 && length == strlen(expected), "got %s, expected %s", formatted, expected);
+	}
+}
+
+
+
+
+int main(void)
+{
+	test_double_round_trip();
+	test_double_layout();
+	test_int64();
+	return TEST_RESULT();
+}
@@ -0,0 +1,217 @@
+//  test_sort_doubles.c
+//  C-String Utilities Library tests
+/**
+ * Sorting doubles: the order of 'double_to_sortable_key' is the numeric order, with -0.0 before +0.0 and NaNs last, and it is
+ * inverted by 'sortable_key_to_double'. The serial and parallel radix sorts agree with 'qsort' on that order, whatever the thread
+ * count or the alignment of the array, and the parallel merge sort agrees with the serial one.
+ */
+
+#include "test_utilities.h"
+
+
+
+
+/**
+ * compare_doubles_total
+ *
+ * 'qsort' comparator of the documented order: numeric, with -0.0 before +0.0 and every NaN last.
+ */
+static int compare_doubles_total(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+	if (isnan(x) || isnan(y))
+	{
+		return isnan(x) - isnan(y);
+	}
+	if (x != y)
+	{
+		return (x < y) ? -1 : 1;
+	}
+	return (int)(signbit(y) != 0) - (int)(signbit(x) != 0);
+}
+
+
+/**
+ * same_double
+ *
+ * Returns true if two doubles have the same bits, or are both NaN(the radix sorts return NaNs positive).
+ */
+static bool same_double(double a, double b)
+{
+	return (isnan(a) && isnan(b)) || memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+
+/**
+ * random_doubles
+ *
+ * Fills an array with random bit patterns(every class of double, NaNs of both signs included), with a third of the values drawn
+ * from a few duplicates and zeros of both signs.
+ */
+static void random_doubles(double *values, size_t count, uint64_t seed)
+{
+	const double duplicates[] = { 0.0, -0.0, 1.5, -1.5, INFINITY, -INFINITY };
+	uint64_t state = seed;
+	for (size_t i = 0; i < count; i++)
+	{
+		uint64_t r = test_random(&state);
+		if (r % 3 == 0)
+		{
+			values[i] = duplicates[(r >> 8) % 6];
+		}
+		else
+		{
+			memcpy(&values[i], &r, sizeof(values[i]));
+		}
+	}
+}
+
+
+/**
+ * test_sortable_key_order
+ *
+ * Checks the key order against the numeric order on random pairs and on the special values, and the inverse mapping.
+ */
+static void test_sortable_key_order(void)
+{
+	const double ordered[] = { -INFINITY, -1e308, -1.0, -5e-324, -0.0, 0.0, 5e-324, 2.2250738585072014e-308, 1.0, 1e308, INFINITY };
+	const size_t count = sizeof(ordered) / sizeof(ordered[0]);
+	for (size_t i = 0; i + 1 < count; i++)
+	{
+		CHECK_MESSAGE(double_to_sortable_key(ordered[i]) < double_to_sortable_key(ordered[i + 1]), "%g before %g", ordered[i], ordered[i + 1]);
+	}
+	CHECK(double_to_sortable_key(INFINITY) < double_to_sortable_key(NAN));
+	CHECK(double_to_sortable_key(INFINITY) < double_to_sortable_key(-NAN));
+
+	uint64_t state = 5;
+	for (int i = 0; i < 1000000; i++)
+	{
+		uint64_t r = test_random(&state), s = test_random(&state);
+		double a, b;
+		memcpy(&a, &r, sizeof(a));
+		memcpy(&b, &s, sizeof(b));
+		uint64_t keyA = double_to_sortable_key(a), keyB = double_to_sortable_key(b);
+		int expected = compare_doubles_total(&a, &b);
+		if (expected != 0)
+		{
+			CHECK_MESSAGE((keyA < keyB) == (expected < 0), "%g vs %g", a, b);
+		}
+
+		double back = sortable_key_to_double(keyA);
+		CHECK_MESSAGE(isnan(a) ? (isnan(back) && !signbit(back)) : memcmp(&back, &a, sizeof(a)) == 0, "%g", a);
+	}
+}
+
+
+/**
+ * test_radix_sorts
+ *
+ * Sorts the same random arrays with 'qsort' and every radix sort. The parallel sort is given arrays large enough to be split,
+ * starting at an odd offset so that its destinations are not aligned to the write-combining lines.
+ */
+static void test_radix_sorts(void)
+{
+	const size_t sizes[] = { 0, 1, 2, 61, 1000, 100000 };
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		size_t count = sizes[s];
+		double *expected = (double *)malloc((count + 1) * sizeof(double));
+		double *sorted = (double *)malloc((count + 1) * sizeof(double));
+		random_doubles(expected, count, 6 + s);
+		memcpy(sorted, expected, count * sizeof(double));
+		qsort(expected, count, sizeof(double), compare_doubles_total);
+
+		radix_sort_doubles(sorted, (int)count);
+		for (size_t i = 0; i < count; i++)
+		{
+			CHECK_MESSAGE(same_double(sorted[i], expected[i]), "8-bit digits, %zu of %zu", i, count);
+		}
+
+		random_doubles(sorted, count, 6 + s);
+		radix_sort_doubles_11bit(sorted, (int)count);
+		for (size_t i = 0; i < count; i++)
+		{
+			CHECK_MESSAGE(same_double(sorted[i], expected[i]), "11-bit digits, %zu of %zu", i, count);
+		}
+		free(expected);
+		free(sorted);
+	}
+
+	const size_t count = RADIX_SORT_PARALLEL_THRESHOLD * 2 + 12345;
+	double *expected = (double *)malloc(count * sizeof(double));
+	double *buffer = (double *)malloc((count + 3) * sizeof(double));
+	double *sorted = buffer + 3;
+	random_doubles(expected, count, 7);
+	radix_sort_doubles(expected, (int)count);
+
+	int threadCounts[] = { 1, 2, 7, 64 };
+	for (int t = 0; t < 4; t++)
+	{
+		random_doubles(sorted, count, 7);
+		radix_sort_doubles_parallel(sorted, (int)count, threadCounts[t]);
+		size_t mismatches = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			mismatches += !same_double(sorted[i], expected[i]);
+		}
+		CHECK_MESSAGE(mismatches == 0, "%zu mismatches with %d threads", mismatches, threadCounts[t]);
+	}
+	free(expected);
+	free(buffer);
+}
+
+
+/**
+ * test_merge_sorts
+ *
+ * Sorts the same random NaN-free arrays with 'qsort', 'merge_sort' and 'merge_sort_parallel'. The merge sorts compare values
+ * numerically, so -0.0 and +0.0 are equal and keep their order, and the two sorts must give the same bits.
+ */
+static void test_merge_sorts(void)
+{
+	const size_t sizes[] = { 0, 1, 2, 33, 1000, MERGE_SORT_PARALLEL_THRESHOLD * 3 + 7 };
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		size_t count = sizes[s];
+		double *expected = (double *)malloc((count + 1) * sizeof(double));
+		double *serial = (double *)malloc((count + 1) * sizeof(double));
+		double *parallel = (double *)malloc((count + 1) * sizeof(double));
+		random_doubles(expected, count, 8 + s);
+		for (size_t i = 0; i < count; i++)
+		{
+			expected[i] = isnan(expected[i]) ? 0.0 : expected[i];
+		}
+		memcpy(serial, expected, count * sizeof(double));
+		merge_sort(serial, (int)count);
+
+		for (int threads = 1; threads <= 7; threads += 3)
+		{
+			memcpy(parallel, expected, count * sizeof(double));
+			merge_sort_parallel(parallel, (int)count, threads);
+			for (size_t i = 0; i < count; i++)
+			{
+				CHECK_MESSAGE(memcmp(&parallel[i], &serial[i], sizeof(double)) == 0, "%d threads, %zu of %zu", threads, i, count);
+			}
+		}
+
+		qsort(expected, count, sizeof(double), compare_doubles_total);
+		for (size_t i = 0; i < count; i++)
+		{
+			CHECK_MESSAGE(serial[i] == expected[i], "serial, %zu of %zu", i, count);
+		}
+		free(expected);
+		free(serial);
+		free(parallel);
+	}
+}
+
+
+
+
+int main(void)
+{
+	test_sortable_key_order();
+	test_radix_sorts();
+	test_merge_sorts();
+	return TEST_RESULT();
+}
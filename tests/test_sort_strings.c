@@ -0,0 +1,173 @@
+//  test_sort_strings.c
+//  C-String Utilities Library tests
+/**
+ * Sorting strings: the radix and multikey quicksorts agree with 'qsort' over 'strcmp', the stable and parallel variants keep equal
+ * strings in their original order, and long shared prefixes or deeply nested prefixes sort without exhausting the stack.
+ */
+
+#include "test_utilities.h"
+
+
+
+
+/**
+ * compare_strings_stable
+ *
+ * 'qsort' comparator of string pointers in 'strcmp' order, equal strings ordered by address. The test strings are carved from one
+ * buffer in their original order, so this is the stable order.
+ */
+static int compare_strings_stable(const void *a, const void *b)
+{
+	const char *x = *(char *const *)a, *y = *(char *const *)b;
+	int order = strcmp(x, y);
+	if (order != 0)
+	{
+		return order;
+	}
+	return (x > y) - (x < y);
+}
+
+
+/**
+ * check_sorts
+ *
+ * Sorts copies of 'strings' with every string sort and compares them with the stable 'qsort' order: by content for the unstable
+ * sorts, and pointer for pointer for the stable ones.
+ */
+static void check_sorts(char **strings, size_t count, const char *label)
+{
+	char **expected = (char **)malloc((count + 1) * sizeof(char *));
+	char **sorted = (char **)malloc((count + 1) * sizeof(char *));
+	memcpy(expected, strings, count * sizeof(char *));
+	qsort(expected, count, sizeof(char *), compare_strings_stable);
+
+	memcpy(sorted, strings, count * sizeof(char *));
+	radix_sort_strings(sorted, count);
+	size_t mismatches = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		mismatches += strcmp(sorted[i], expected[i]) != 0;
+	}
+	CHECK_MESSAGE(mismatches == 0, "radix_sort_strings, %s: %zu mismatches", label, mismatches);
+
+	memcpy(sorted, strings, count * sizeof(char *));
+	multikey_quicksort_strings(sorted, count);
+	mismatches = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		mismatches += strcmp(sorted[i], expected[i]) != 0;
+	}
+	CHECK_MESSAGE(mismatches == 0, "multikey_quicksort_strings, %s: %zu mismatches", label, mismatches);
+
+	memcpy(sorted, strings, count * sizeof(char *));
+	radix_sort_strings_stable(sorted, count);
+	mismatches = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		mismatches += sorted[i] != expected[i];
+	}
+	CHECK_MESSAGE(mismatches == 0, "radix_sort_strings_stable, %s: %zu mismatches", label, mismatches);
+
+	int threadCounts[] = { 1, 2, 7 };
+	for (int t = 0; t < 3; t++)
+	{
+		memcpy(sorted, strings, count * sizeof(char *));
+		radix_sort_strings_parallel(sorted, count, threadCounts[t]);
+		mismatches = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			mismatches += sorted[i] != expected[i];
+		}
+		CHECK_MESSAGE(mismatches == 0, "radix_sort_strings_parallel with %d threads, %s: %zu mismatches", threadCounts[t], label, mismatches);
+	}
+
+	free(expected);
+	free(sorted);
+}
+
+
+/**
+ * test_random_strings
+ *
+ * Sorts random strings of 0 to 24 bytes over a small alphabet, which includes bytes above 0x7F, so that many strings share
+ * prefixes or are equal.
+ */
+static void test_random_strings(void)
+{
+	const char alphabet[] = "ab\x7F\x80\xFF" "c";
+	const size_t sizes[] = { 0, 1, 2, 50, 5000, 100000 };
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		size_t count = sizes[s];
+		char *text = (char *)malloc(count * 25 + 1);
+		char **strings = (char **)malloc((count + 1) * sizeof(char *));
+		uint64_t state = 40 + s;
+		char *next = text;
+		for (size_t i = 0; i < count; i++)
+		{
+			uint64_t r = test_random(&state);
+			size_t length = (size_t)(r % 25);
+			strings[i] = next;
+			for (size_t c = 0; c < length; c++)
+			{
+				*next++ = alphabet[test_random(&state) % 6];
+			}
+			*next++ = '\0';
+		}
+
+		char label[32];
+		snprintf(label, sizeof(label), "%zu random strings", count);
+		check_sorts(strings, count, label);
+		free(text);
+		free(strings);
+	}
+}
+
+
+/**
+ * test_long_prefixes
+ *
+ * Sorts strings that share a 100000 byte prefix, and nested prefixes "x", "xx", "xxx", ... thousands of bytes deep.
+ */
+static void test_long_prefixes(void)
+{
+	enum { LENGTH = 100000, COUNT = 64 };
+	char *text = (char *)malloc(COUNT * (LENGTH + 1));
+	char *strings[COUNT];
+	uint64_t state = 50;
+	for (int i = 0; i < COUNT; i++)
+	{
+		strings[i] = text + (size_t)i * (LENGTH + 1);
+		memset(strings[i], 'x', LENGTH);
+		strings[i][LENGTH] = '\0';
+		if (i % 2 == 1)
+		{
+			strings[i][LENGTH - 1] = (char)('a' + test_random(&state) % 26);
+		}
+	}
+	check_sorts(strings, COUNT, "shared 100000 byte prefix");
+	free(text);
+
+	enum { NESTED = 3000 };
+	char *nestedText = (char *)malloc((size_t)NESTED * (NESTED + 1));
+	char *nested[NESTED];
+	for (int i = 0; i < NESTED; i++)
+	{
+		int length = NESTED - i; // Longest first, so that the sorts reverse the array.
+		nested[i] = nestedText + (size_t)i * (NESTED + 1);
+		memset(nested[i], 'x', (size_t)length);
+		nested[i][length] = '\0';
+	}
+	check_sorts(nested, NESTED, "nested prefixes");
+	free(nestedText);
+}
+
+
+
+
+int main(void)
+{
+	test_random_strings();
+	test_long_prefixes();
+	return TEST_RESULT();
+}
@@ -0,0 +1,47 @@
+//  test_utilities.h
+//  C-String Utilities Library tests
+
+
+#ifndef test_utilities_h
+#define test_utilities_h
+
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "AuxiliaryUtilities.h"
+#include "StringUtilities.h"
+
+
+
+
+/**
+ * Minimal test harness: every test program includes this header, checks its expectations with 'CHECK' and returns 'TEST_RESULT()'
+ * from 'main', so 'make check' reports the failing expectations and stops at the first failing program.
+ */
+static int testFailures = 0;
+static int testChecks = 0;
+
+#define CHECK(condition) do { testChecks++; if (!(condition)) { testFailures++; fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); } } while (0)
+#define CHECK_MESSAGE(condition, ...) do { testChecks++; if (!(condition)) { testFailures++; fprintf(stderr, "%s:%d: check failed: %s: ", __FILE__, __LINE__, #condition); fprintf(stderr, __VA_ARGS__); fputc('\n', stderr); } } while (0)
+#define TEST_RESULT() (printf("%s: %d checks, %d failed\n", __FILE__, testChecks, testFailures), testFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE)
+
+
+/**
+ * test_random
+ *
+ * Deterministic 64-bit generator(splitmix64), so failures reproduce exactly.
+ */
+static inline uint64_t test_random(uint64_t *state)
+{
+	uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+
+#endif /* test_utilities_h */